@@ -0,0 +1,139 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+namespace
+{
+//!
+//! \brief Number of inputs of every benchmark (power of 2)
+//!
+const std::size_t INPUT_COUNT = 1024UL;
+
+//------------------------------------------------------------------------------
+struct Inputs
+{
+    Inputs()
+    {
+        uint32_t state = 0x2545F491UL;
+
+        for (std::size_t i = 0UL; i < INPUT_COUNT; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            data[i] = state;
+        }
+    }
+
+    uint32_t data[INPUT_COUNT];
+};
+
+const Inputs inputs;
+
+//------------------------------------------------------------------------------
+void reflectU08(benchmark::State& state)
+{
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bit::reflect(static_cast<uint8_t>(inputs.data[i])));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint8_t));
+}
+
+//------------------------------------------------------------------------------
+void reflectU16(benchmark::State& state)
+{
+    const bool isLsbFirst = (state.range(0) != 0);
+
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+                bit::reflect(static_cast<uint16_t>(inputs.data[i]), isLsbFirst));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint16_t));
+}
+
+//------------------------------------------------------------------------------
+void reflectU32(benchmark::State& state)
+{
+    const bool isLsbFirst = (state.range(0) != 0);
+
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bit::reflect(inputs.data[i], isLsbFirst));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint32_t));
+}
+
+//------------------------------------------------------------------------------
+void parity(benchmark::State& state)
+{
+    const bit::Parity type = (state.range(0) != 0) ? bit::Odd : bit::Even;
+
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bit::parity(inputs.data[i], type));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint32_t));
+}
+
+//------------------------------------------------------------------------------
+void parity64(benchmark::State& state)
+{
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        const uint64_t data = (static_cast<uint64_t>(inputs.data[i]) << 32U) |
+                              inputs.data[(i + 1UL) & (INPUT_COUNT - 1UL)];
+
+        benchmark::DoNotOptimize(bit::parity64(data, bit::Even));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint64_t));
+}
+
+//------------------------------------------------------------------------------
+void lsbPos(benchmark::State& state)
+{
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bit::lsbPos(inputs.data[i]));
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(uint32_t));
+}
+}
+
+BENCHMARK(reflectU08);
+BENCHMARK(reflectU16)->Arg(0)->Arg(1);
+BENCHMARK(reflectU32)->Arg(0)->Arg(1);
+BENCHMARK(parity)->Arg(0)->Arg(1);
+BENCHMARK(parity64);
+BENCHMARK(lsbPos);
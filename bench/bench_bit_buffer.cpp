@@ -0,0 +1,157 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+namespace
+{
+//!
+//! \brief Largest frame of the field benchmarks (Ethernet MTU)
+//!
+const std::size_t MAX_FRAME_SIZE = 1500UL;
+
+//------------------------------------------------------------------------------
+template <std::size_t Size, typename SignalType>
+void bufferInsert(benchmark::State& state)
+{
+    static bit::Buffer<Size> frame;
+
+    SignalType signal;
+
+    signal.write(static_cast<typename SignalType::Type>(0x5A5AA5A5UL));
+
+    for (auto _ : state)
+    {
+        frame << signal;
+
+        benchmark::DoNotOptimize(frame);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            sizeof(typename SignalType::Type));
+}
+
+//------------------------------------------------------------------------------
+template <std::size_t Size, typename SignalType>
+void bufferExtract(benchmark::State& state)
+{
+    static bit::Buffer<Size> frame;
+
+    SignalType signal;
+
+    signal.write(static_cast<typename SignalType::Type>(0x5A5AA5A5UL));
+
+    frame << signal;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(frame);
+
+        frame >> signal;
+
+        benchmark::DoNotOptimize(signal);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            sizeof(typename SignalType::Type));
+}
+
+//------------------------------------------------------------------------------
+void fieldExtract(benchmark::State& state)
+{
+    static uint8_t data[MAX_FRAME_SIZE];
+
+    const std::size_t width = static_cast<std::size_t>(state.range(0));
+    const std::size_t size = static_cast<std::size_t>(state.range(1));
+
+    const std::size_t count = (size * bit::U08_BIT_COUNT) / width;
+
+    for (std::size_t i = 0UL; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 0x9DUL);
+    }
+
+    for (auto _ : state)
+    {
+        uint64_t sum = 0ULL;
+
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            sum += bit::extractField(data, size, i * width, width);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(size));
+}
+
+//------------------------------------------------------------------------------
+void fieldInsert(benchmark::State& state)
+{
+    static uint8_t data[MAX_FRAME_SIZE];
+
+    const std::size_t width = static_cast<std::size_t>(state.range(0));
+    const std::size_t size = static_cast<std::size_t>(state.range(1));
+
+    const std::size_t count = (size * bit::U08_BIT_COUNT) / width;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            bit::insertField(data, size, i * width, width, i);
+        }
+
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(size));
+}
+
+//------------------------------------------------------------------------------
+void fieldArguments(benchmark::internal::Benchmark* benchmark)
+{
+    const int64_t widths[] = {1, 3, 8, 12, 16, 27, 32, 48, 64};
+    const int64_t sizes[] = {8, 64, static_cast<int64_t>(MAX_FRAME_SIZE)};
+
+    for (std::size_t i = 0UL; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        for (std::size_t j = 0UL; j < (sizeof(widths) / sizeof(widths[0])); j++)
+        {
+            benchmark->Args({widths[j], sizes[i]});
+        }
+    }
+
+    benchmark->ArgNames({"width", "size"});
+}
+}
+
+// First byte aligned (BitPos 7) and unaligned (BitPos 3), last bytes of frame
+BENCHMARK_TEMPLATE(bufferInsert, 8, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferInsert, 8, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferInsert, 8, bit::Signal<uint32_t, 39>);
+BENCHMARK_TEMPLATE(bufferInsert, 64, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferInsert, 64, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferInsert, 64, bit::Signal<uint32_t, 487>);
+BENCHMARK_TEMPLATE(bufferInsert, 1500, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferInsert, 1500, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferInsert, 1500, bit::Signal<uint32_t, 11975>);
+BENCHMARK_TEMPLATE(bufferInsert, 8, bit::Signal<bool, 3>);
+BENCHMARK_TEMPLATE(bufferInsert, 8, bit::Signal<uint16_t, 5, 12>);
+
+BENCHMARK_TEMPLATE(bufferExtract, 8, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferExtract, 8, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferExtract, 8, bit::Signal<uint32_t, 39>);
+BENCHMARK_TEMPLATE(bufferExtract, 64, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferExtract, 64, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferExtract, 64, bit::Signal<uint32_t, 487>);
+BENCHMARK_TEMPLATE(bufferExtract, 1500, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(bufferExtract, 1500, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(bufferExtract, 1500, bit::Signal<uint32_t, 11975>);
+BENCHMARK_TEMPLATE(bufferExtract, 8, bit::Signal<bool, 3>);
+BENCHMARK_TEMPLATE(bufferExtract, 8, bit::Signal<uint16_t, 5, 12>);
+
+// Widths 1-64 over whole frames of 8, 64 and 1500 bytes
+BENCHMARK(fieldExtract)->Apply(fieldArguments);
+BENCHMARK(fieldInsert)->Apply(fieldArguments);
@@ -0,0 +1,111 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+//!
+//! \brief Number of words of every benchmark (power of 2)
+//!
+const std::size_t WORD_COUNT = 4096UL;
+
+//------------------------------------------------------------------------------
+struct Words
+{
+    Words()
+        : data(WORD_COUNT)
+        , halves(WORD_COUNT)
+        , check(WORD_COUNT)
+    {
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            data[i] = state;
+            halves[i] = static_cast<uint32_t>(state >> 16);
+        }
+    }
+
+    std::vector<uint64_t> data;
+    std::vector<uint32_t> halves;
+    std::vector<uint8_t> check;
+};
+
+//------------------------------------------------------------------------------
+void encodeWord64(benchmark::State& state)
+{
+    Words words;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            words.check[i] = bit::Secded::encode(words.data[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            WORD_COUNT * sizeof(uint64_t));
+}
+
+//------------------------------------------------------------------------------
+void encodeBatch64(benchmark::State& state)
+{
+    Words words;
+
+    for (auto _ : state)
+    {
+        bit::Secded::encode(words.data.data(), words.check.data(), WORD_COUNT);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            WORD_COUNT * sizeof(uint64_t));
+}
+
+//------------------------------------------------------------------------------
+void encodeBatch32(benchmark::State& state)
+{
+    Words words;
+
+    for (auto _ : state)
+    {
+        bit::Secded::encode(words.halves.data(), words.check.data(), WORD_COUNT);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            WORD_COUNT * sizeof(uint32_t));
+}
+
+//------------------------------------------------------------------------------
+void correctBatch64(benchmark::State& state)
+{
+    Words words;
+
+    bit::Secded::encode(words.data.data(), words.check.data(), WORD_COUNT);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+                bit::Secded::correct(words.data.data(), words.check.data(), WORD_COUNT));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            WORD_COUNT * sizeof(uint64_t));
+}
+}
+
+BENCHMARK(encodeWord64);
+BENCHMARK(encodeBatch64);
+BENCHMARK(encodeBatch32);
+BENCHMARK(correctBatch64);
@@ -0,0 +1,77 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+//!
+//! \brief Byte size of the benchmark payload
+//!
+const std::size_t PAYLOAD_SIZE = 4096UL;
+
+//------------------------------------------------------------------------------
+std::vector<uint8_t> payload()
+{
+    std::vector<uint8_t> result(PAYLOAD_SIZE);
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t i = 0UL; i < PAYLOAD_SIZE; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        result[i] = static_cast<uint8_t>(state);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void encodeFrame(benchmark::State& state)
+{
+    const bit::Framing framing = static_cast<bit::Framing>(state.range(0));
+
+    const std::vector<uint8_t> input = payload();
+
+    std::vector<uint8_t> output(bit::maxFrameSize(framing, PAYLOAD_SIZE));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bit::encodeFrame(framing, input.data(), input.size(),
+                                                  output.data(), output.size()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * PAYLOAD_SIZE);
+}
+
+//------------------------------------------------------------------------------
+void decodeFrame(benchmark::State& state)
+{
+    const bit::Framing framing = static_cast<bit::Framing>(state.range(0));
+
+    const std::vector<uint8_t> input = payload();
+
+    std::vector<uint8_t> frame(bit::maxFrameSize(framing, PAYLOAD_SIZE));
+    std::vector<uint8_t> output(PAYLOAD_SIZE);
+
+    frame.resize(bit::encodeFrame(framing, input.data(), input.size(),
+                                  frame.data(), frame.size()));
+
+    bit::FrameDecoder decoder(framing, output.data(), output.size());
+
+    for (auto _ : state)
+    {
+        decoder.next();
+
+        benchmark::DoNotOptimize(decoder.feed(frame.data(), frame.size()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * PAYLOAD_SIZE);
+}
+}
+
+BENCHMARK(encodeFrame)->Arg(bit::Cobs)->Arg(bit::Slip);
+BENCHMARK(decodeFrame)->Arg(bit::Cobs)->Arg(bit::Slip);
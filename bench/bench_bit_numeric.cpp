@@ -0,0 +1,138 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+//!
+//! \brief Number of values of the benchmark arrays
+//!
+const std::size_t VALUE_COUNT = 4096UL;
+
+//------------------------------------------------------------------------------
+std::vector<uint16_t> words()
+{
+    std::vector<uint16_t> result(VALUE_COUNT);
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t i = 0UL; i < VALUE_COUNT; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        // Finite halves
+        result[i] = static_cast<uint16_t>(state & 0xBBFFUL);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void halfScalar(benchmark::State& state)
+{
+    const std::vector<uint16_t> input = words();
+
+    std::vector<float> output(VALUE_COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < VALUE_COUNT; i++)
+        {
+            output[i] = bit::Half::fromBits(input[i]).toFloat();
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VALUE_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void halfArray(benchmark::State& state)
+{
+    const std::vector<uint16_t> input = words();
+
+    std::vector<float> output(VALUE_COUNT);
+
+    for (auto _ : state)
+    {
+        bit::halfToFloat(input.data(), VALUE_COUNT, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VALUE_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void floatToHalfScalar(benchmark::State& state)
+{
+    std::vector<float> input(VALUE_COUNT);
+    std::vector<uint16_t> output(VALUE_COUNT);
+
+    bit::halfToFloat(words().data(), VALUE_COUNT, input.data());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < VALUE_COUNT; i++)
+        {
+            output[i] = bit::Half(input[i]).bits();
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VALUE_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void floatToHalfArray(benchmark::State& state)
+{
+    std::vector<float> input(VALUE_COUNT);
+    std::vector<uint16_t> output(VALUE_COUNT);
+
+    bit::halfToFloat(words().data(), VALUE_COUNT, input.data());
+
+    for (auto _ : state)
+    {
+        bit::floatToHalf(input.data(), VALUE_COUNT, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VALUE_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void fixedArray(benchmark::State& state)
+{
+    const std::vector<uint16_t> raw = words();
+
+    const std::vector<int16_t> input(raw.begin(), raw.end());
+
+    std::vector<float> output(VALUE_COUNT);
+
+    for (auto _ : state)
+    {
+        bit::fixedToFloat(input.data(), VALUE_COUNT, 15UL, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * VALUE_COUNT);
+}
+}
+
+BENCHMARK(halfScalar);
+BENCHMARK(halfArray);
+BENCHMARK(floatToHalfScalar);
+BENCHMARK(floatToHalfArray);
+BENCHMARK(fixedArray);
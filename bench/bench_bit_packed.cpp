@@ -0,0 +1,127 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+//!
+//! \brief Number of elements of the benchmark array
+//!
+const std::size_t ELEMENT_COUNT = 4096UL;
+
+//!
+//! \brief Element width of the benchmark array
+//!
+const std::size_t ELEMENT_BITS = 12UL;
+
+//------------------------------------------------------------------------------
+std::vector<uint8_t> storage()
+{
+    std::vector<uint8_t> result(bit::PackedArray<ELEMENT_BITS>::storageSize(ELEMENT_COUNT));
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t i = 0UL; i < result.size(); i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        result[i] = static_cast<uint8_t>(state);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void packedGet(benchmark::State& state)
+{
+    std::vector<uint8_t> data = storage();
+    std::vector<uint16_t> output(ELEMENT_COUNT);
+
+    const bit::PackedArray<ELEMENT_BITS> samples(data.data(), ELEMENT_COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < ELEMENT_COUNT; i++)
+        {
+            output[i] = samples.get(i);
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void packedUnpack(benchmark::State& state)
+{
+    std::vector<uint8_t> data = storage();
+    std::vector<uint16_t> output(ELEMENT_COUNT);
+
+    const bit::PackedArray<ELEMENT_BITS> samples(data.data(), ELEMENT_COUNT);
+
+    for (auto _ : state)
+    {
+        samples.unpack(0UL, ELEMENT_COUNT, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void packedSet(benchmark::State& state)
+{
+    std::vector<uint8_t> data = storage();
+    std::vector<uint16_t> input(ELEMENT_COUNT);
+
+    bit::PackedArray<ELEMENT_BITS> samples(data.data(), ELEMENT_COUNT);
+
+    samples.unpack(0UL, ELEMENT_COUNT, input.data());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0UL; i < ELEMENT_COUNT; i++)
+        {
+            samples.set(i, input[i]);
+        }
+
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void packedPack(benchmark::State& state)
+{
+    std::vector<uint8_t> data = storage();
+    std::vector<uint16_t> input(ELEMENT_COUNT);
+
+    bit::PackedArray<ELEMENT_BITS> samples(data.data(), ELEMENT_COUNT);
+
+    samples.unpack(0UL, ELEMENT_COUNT, input.data());
+
+    for (auto _ : state)
+    {
+        samples.pack(input.data(), 0UL, ELEMENT_COUNT);
+
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * ELEMENT_COUNT);
+}
+}
+
+BENCHMARK(packedGet);
+BENCHMARK(packedUnpack);
+BENCHMARK(packedSet);
+BENCHMARK(packedPack);
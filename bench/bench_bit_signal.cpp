@@ -0,0 +1,97 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+namespace
+{
+//!
+//! \brief Number of inputs of every benchmark (power of 2)
+//!
+const std::size_t INPUT_COUNT = 1024UL;
+
+//------------------------------------------------------------------------------
+struct Inputs
+{
+    Inputs()
+    {
+        uint32_t state = 0x9E3779B9UL;
+
+        for (std::size_t i = 0UL; i < INPUT_COUNT; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            data[i] = state;
+        }
+    }
+
+    uint32_t data[INPUT_COUNT];
+};
+
+const Inputs inputs;
+
+//------------------------------------------------------------------------------
+template <typename SignalType>
+void signalWrite(benchmark::State& state)
+{
+    typedef typename SignalType::Type Type;
+
+    SignalType signal;
+
+    std::size_t i = 0UL;
+
+    for (auto _ : state)
+    {
+        signal.write(static_cast<Type>(inputs.data[i]));
+
+        benchmark::DoNotOptimize(signal);
+
+        i = (i + 1UL) & (INPUT_COUNT - 1UL);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(Type));
+}
+
+//------------------------------------------------------------------------------
+template <typename SignalType>
+void signalRead(benchmark::State& state)
+{
+    typedef typename SignalType::Type Type;
+
+    SignalType signal;
+
+    signal.write(static_cast<Type>(inputs.data[0]));
+
+    for (auto _ : state)
+    {
+        Type value;
+
+        benchmark::DoNotOptimize(signal);
+
+        signal.read(value);
+
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sizeof(Type));
+}
+}
+
+// Byte aligned (BitPos 7) and unaligned (BitPos 3) layouts
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<bool, 7>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<uint8_t, 7>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<uint8_t, 3, 5>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<uint16_t, 7>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<int16_t, 3, 12>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(signalWrite, bit::Signal<float, 7>);
+
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<bool, 7>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<uint8_t, 7>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<uint8_t, 3, 5>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<uint16_t, 7>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<int16_t, 3, 12>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<uint32_t, 7>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<uint32_t, 3, 27>);
+BENCHMARK_TEMPLATE(signalRead, bit::Signal<float, 7>);
@@ -0,0 +1,79 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+//!
+//! \brief Byte size of the benchmark stream
+//!
+const std::size_t STREAM_SIZE = 4096UL;
+
+//------------------------------------------------------------------------------
+std::vector<uint8_t> stream()
+{
+    std::vector<uint8_t> result(STREAM_SIZE);
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t i = 0UL; i < STREAM_SIZE; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        result[i] = static_cast<uint8_t>(state);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void stuff(benchmark::State& state)
+{
+    const bit::BitStuffer::Rule rule = static_cast<bit::BitStuffer::Rule>(state.range(0));
+
+    const std::vector<uint8_t> input = stream();
+
+    std::vector<uint8_t> output(STREAM_SIZE * 2UL);
+
+    bit::BitStuffer stuffer(rule);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(stuffer.stuff(input.data(), STREAM_SIZE * 8UL,
+                                               output.data(), output.size() * 8UL));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * STREAM_SIZE);
+}
+
+//------------------------------------------------------------------------------
+void destuff(benchmark::State& state)
+{
+    const bit::BitStuffer::Rule rule = static_cast<bit::BitStuffer::Rule>(state.range(0));
+
+    const std::vector<uint8_t> input = stream();
+
+    std::vector<uint8_t> stuffed(STREAM_SIZE * 2UL);
+    std::vector<uint8_t> output(STREAM_SIZE);
+
+    bit::BitStuffer stuffer(rule);
+
+    (void) stuffer.stuff(input.data(), STREAM_SIZE * 8UL, stuffed.data(), stuffed.size() * 8UL);
+
+    const std::size_t bits = stuffer.bits();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(stuffer.destuff(stuffed.data(), bits,
+                                                 output.data(), output.size() * 8UL));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * STREAM_SIZE);
+}
+}
+
+BENCHMARK(stuff)->Arg(bit::BitStuffer::Can)->Arg(bit::BitStuffer::Hdlc);
+BENCHMARK(destuff)->Arg(bit::BitStuffer::Can)->Arg(bit::BitStuffer::Hdlc);
@@ -0,0 +1,150 @@
+#include "benchmark/benchmark.h"
+#include <bits>
+
+#include <vector>
+
+namespace
+{
+typedef bit::Signal<bool, 0> Engine;
+typedef bit::Signal<bool, 20> Brake;
+typedef bit::Signal<bool, 27> Door;
+typedef bit::Signal<bool, 63> Light;
+
+//!
+//! \brief Number of frames of the benchmark block
+//!
+const std::size_t FRAME_COUNT = 1024UL;
+
+//------------------------------------------------------------------------------
+std::vector<bit::Buffer<8> > frames()
+{
+    std::vector<bit::Buffer<8> > result(FRAME_COUNT);
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t n = 0UL; n < FRAME_COUNT; n++)
+    {
+        for (std::size_t i = 0UL; i < 8UL; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            result[n].data()[i] = static_cast<uint8_t>(state);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void transposeFlags(benchmark::State& state)
+{
+    const std::vector<bit::Buffer<8> > block = frames();
+
+    const std::size_t offsets[] = { bit::Field<Engine>::OFFSET,
+                                    bit::Field<Brake>::OFFSET,
+                                    bit::Field<Door>::OFFSET,
+                                    bit::Field<Light>::OFFSET };
+
+    std::vector<uint64_t> bitmaps(4UL * (FRAME_COUNT / 64UL));
+
+    for (auto _ : state)
+    {
+        bit::transposeFlags(block.data(), FRAME_COUNT, offsets, 4UL, bitmaps.data());
+
+        benchmark::DoNotOptimize(bitmaps.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FRAME_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void transposeColumns(benchmark::State& state)
+{
+    const std::vector<bit::Buffer<8> > block = frames();
+
+    const std::size_t flags = static_cast<std::size_t>(state.range(0));
+
+    // Flags spread over one 64-bit column
+    std::size_t offsets[64];
+
+    for (std::size_t i = 0UL; i < flags; i++)
+    {
+        offsets[i] = (i * 64UL) / flags;
+    }
+
+    std::vector<uint64_t> bitmaps(flags * (FRAME_COUNT / 64UL));
+
+    for (auto _ : state)
+    {
+        bit::transposeFlags(block.data(), FRAME_COUNT, offsets, flags, bitmaps.data());
+
+        benchmark::DoNotOptimize(bitmaps.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FRAME_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void readFlags(benchmark::State& state)
+{
+    std::vector<bit::Buffer<8> > block = frames();
+
+    std::vector<uint64_t> bitmaps(4UL * (FRAME_COUNT / 64UL));
+
+    Engine engine;
+    Brake brake;
+    Door door;
+    Light light;
+
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0UL; n < FRAME_COUNT; n++)
+        {
+            block[n] >> engine >> brake >> door >> light;
+
+            bool values[4];
+
+            engine.read(values[0]);
+            brake.read(values[1]);
+            door.read(values[2]);
+            light.read(values[3]);
+
+            const uint64_t bit = 1ULL << (63UL - (n % 64UL));
+
+            for (std::size_t f = 0UL; f < 4UL; f++)
+            {
+                bitmaps[(f * (FRAME_COUNT / 64UL)) + (n / 64UL)] |= values[f] ? bit : 0ULL;
+            }
+        }
+
+        benchmark::DoNotOptimize(bitmaps.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FRAME_COUNT);
+}
+
+//------------------------------------------------------------------------------
+void transpose64x64(benchmark::State& state)
+{
+    uint64_t rows[64];
+
+    for (std::size_t i = 0UL; i < 64UL; i++)
+    {
+        rows[i] = 0x9E3779B97F4A7C15ULL * (i + 1UL);
+    }
+
+    for (auto _ : state)
+    {
+        bit::transpose64x64(rows);
+
+        benchmark::DoNotOptimize(rows);
+    }
+}
+}
+
+BENCHMARK(transposeFlags);
+BENCHMARK(transposeColumns)->Arg(4)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK(readFlags);
+BENCHMARK(transpose64x64);
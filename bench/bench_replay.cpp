@@ -0,0 +1,739 @@
+//!
+//! \file bench_replay.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    End-to-end frame replay throughput
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A synthetic signal database (--layouts frame layouts of up to
+//!             30 signals) is generated from --seed. Layouts are assembled
+//!             at run time from a pool of pre-instantiated Signal types (8
+//!             width and position variants in each 16-bit cell of the
+//!             payload) held as SignalData pointers. Every frame carries its
+//!             layout id, a rolling counter and its payload signals, written
+//!             with Buffer::operator<< and read back with
+//!             BufferView::operator>>
+//!
+//! \note       Frames are encoded into a capture file, then the capture is
+//!             replayed with 1..--threads workers. Layout picks and signal
+//!             pools are prepared before the timed loops, per-frame
+//!             latencies include two clock reads
+//!
+//!                 bench_replay [--frames N] [--layouts L] [--threads T]
+//!                              [--seed S] [--capture PATH] [--reuse]
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_capture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Byte size of every frame
+//!
+const std::size_t FRAME_SIZE = 64UL;
+
+//!
+//! \brief Bits of the frame header (layout id and counter)
+//!
+const std::size_t HEADER_BITS = 24UL;
+
+//!
+//! \brief Number of header signals
+//!
+const std::size_t HEADER_SIGNALS = 2UL;
+
+//!
+//! \brief Bits of a payload cell, holding at most one signal
+//!
+const std::size_t CELL_BITS = 16UL;
+
+//!
+//! \brief Number of payload cells
+//!
+const std::size_t CELL_COUNT = ((FRAME_SIZE * bit::U08_BIT_COUNT) - HEADER_BITS) /
+                               CELL_BITS;
+
+//!
+//! \brief Number of signal variants of a cell
+//!
+const std::size_t VARIANT_COUNT = 8UL;
+
+//!
+//! \brief Number of pre-instantiated signal types
+//!
+const std::size_t POOL_SIZE = CELL_COUNT * VARIANT_COUNT;
+
+//!
+//! \brief Width of every variant
+//!
+constexpr std::size_t VARIANT_WIDTHS[VARIANT_COUNT] = {1UL, 3UL, 5UL, 7UL, 9UL, 12UL, 14UL, 16UL};
+
+//!
+//! \brief Offset of every variant in its cell
+//!
+constexpr std::size_t VARIANT_SHIFTS[VARIANT_COUNT] = {6UL, 11UL, 2UL, 9UL, 4UL, 1UL, 2UL, 0UL};
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Layout id of a frame
+//!
+typedef bit::Signal<uint16_t, 7> LayoutId;
+
+//!
+//! \brief Rolling counter of a frame
+//!
+typedef bit::Signal<uint8_t, 23> Counter;
+
+//!
+//! \brief Command line options
+//!
+struct Options
+{
+    std::size_t frames;
+    std::size_t layouts;
+    std::size_t threads;
+    uint64_t seed;
+    const char* capture;
+    bool isReuse;
+};
+
+//!
+//! \brief xorshift64 generator
+//!
+class Random
+{
+public:
+
+    explicit Random(const uint64_t seed)
+        : mState(seed | 1ULL)
+    {
+    }
+
+    uint64_t next()
+    {
+        mState ^= mState << 13;
+        mState ^= mState >> 7;
+        mState ^= mState << 17;
+
+        return mState;
+    }
+
+private:
+
+    uint64_t mState;
+};
+
+//!
+//! \brief Bit position (Signal BitPos) of a field offset
+//!
+constexpr std::size_t bitPosition(const std::size_t offset)
+{
+    return ((offset / bit::U08_BIT_COUNT) * bit::U08_BIT_COUNT) +
+           ((bit::U08_BIT_COUNT - 1UL) - (offset % bit::U08_BIT_COUNT));
+}
+
+//!
+//! \brief Signal type of a pool entry, odd variants are signed
+//!
+template <std::size_t Index>
+struct PoolEntry
+{
+    static const std::size_t VARIANT = Index % VARIANT_COUNT;
+
+    static const std::size_t WIDTH = VARIANT_WIDTHS[VARIANT];
+
+    static const std::size_t OFFSET = HEADER_BITS + ((Index / VARIANT_COUNT) * CELL_BITS) +
+                                      VARIANT_SHIFTS[VARIANT];
+
+    static const bool IS_SIGNED = ((VARIANT % 2UL) != 0UL);
+
+    typedef typename std::conditional<
+            (WIDTH <= bit::U08_BIT_COUNT),
+            typename std::conditional<IS_SIGNED, int8_t, uint8_t>::type,
+            typename std::conditional<IS_SIGNED, int16_t, uint16_t>::type>::type Type;
+
+    typedef bit::Signal<Type, bitPosition(OFFSET), WIDTH> SignalType;
+};
+
+//!
+//! \brief Pre-instantiated signals, one object of every pool entry type
+//!
+class SignalPool
+{
+public:
+
+    SignalPool();
+
+    ~SignalPool()
+    {
+        for (std::size_t i = 0UL; i < mSlots.size(); i++)
+        {
+            delete mSlots[i].signal;
+        }
+    }
+
+    template <typename SignalType>
+    void add()
+    {
+        const Slot slot = {new SignalType(), &assign<SignalType>, &value<SignalType>};
+
+        mSlots.push_back(slot);
+    }
+
+    bit::SignalData& signal(const std::size_t i)
+    {
+        return *mSlots[i].signal;
+    }
+
+    void write(const std::size_t i, const uint64_t raw)
+    {
+        mSlots[i].assign(*mSlots[i].signal, raw);
+    }
+
+    double read(const std::size_t i)
+    {
+        return mSlots[i].value(*mSlots[i].signal);
+    }
+
+private:
+
+    typedef void (*AssignFunction)(bit::SignalData& signal, const uint64_t raw);
+
+    typedef double (*ValueFunction)(bit::SignalData& signal);
+
+    struct Slot
+    {
+        bit::SignalData* signal;
+        AssignFunction assign;
+        ValueFunction value;
+    };
+
+    std::vector<Slot> mSlots;
+
+    SignalPool(const SignalPool&);
+
+    SignalPool& operator=(const SignalPool&);
+
+    template <typename SignalType>
+    static void assign(bit::SignalData& signal, const uint64_t raw)
+    {
+        static_cast<SignalType&>(signal).write(static_cast<typename SignalType::Type>(raw));
+    }
+
+    template <typename SignalType>
+    static double value(bit::SignalData& signal)
+    {
+        typename SignalType::Type result;
+
+        static_cast<SignalType&>(signal).read(result);
+
+        return static_cast<double>(result);
+    }
+};
+
+//!
+//! \brief Adds the first Count pool entry types to a pool
+//!
+template <std::size_t Count>
+struct PoolBuilder
+{
+    static void build(SignalPool& pool)
+    {
+        PoolBuilder<Count - 1UL>::build(pool);
+
+        pool.add<typename PoolEntry<Count - 1UL>::SignalType>();
+    }
+};
+
+//!
+//! \brief Empty pool
+//!
+template <>
+struct PoolBuilder<0UL>
+{
+    static void build(SignalPool& pool)
+    {
+        (void) pool;
+    }
+};
+
+//!
+//! \brief Synthetic signal database
+//!
+struct Database
+{
+    std::vector<std::vector<uint16_t> > layouts;
+    std::vector<uint16_t> picks;
+    std::size_t signalCount;
+};
+
+//!
+//! \brief Results of a worker, padded against false sharing
+//!
+struct Partial
+{
+    std::vector<uint32_t> latencies;
+    std::size_t signals;
+    double checksum;
+    uint8_t padding[bit::CACHE_LINE_SIZE];
+};
+
+//!
+//! \brief Results of a run
+//!
+struct Result
+{
+    std::size_t threads;
+    double seconds;
+    std::size_t frames;
+    std::size_t signals;
+    uint32_t p50;
+    uint32_t p99;
+};
+
+//!
+//! \brief Context of a decode run
+//!
+struct ReplayContext
+{
+    const bit::CaptureReader* reader;
+    const Database* database;
+    std::vector<SignalPool>* pools;
+    std::vector<Partial>* partials;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+SignalPool::SignalPool()
+    : mSlots()
+{
+    mSlots.reserve(POOL_SIZE);
+
+    PoolBuilder<POOL_SIZE>::build(*this);
+}
+
+//------------------------------------------------------------------------------
+bool parse(const int argc, char** argv, Options& options)
+{
+    bool result = true;
+
+    options.frames = 200000UL;
+    options.layouts = 512UL;
+    options.threads = std::max(1U, std::thread::hardware_concurrency());
+    options.seed = 0x9E3779B97F4A7C15ULL;
+    options.capture = "bench_replay.bcap";
+    options.isReuse = false;
+
+    for (int i = 1; (i < argc) && result; i++)
+    {
+        const bool hasValue = ((i + 1) < argc);
+
+        if (std::strcmp(argv[i], "--reuse") == 0)
+        {
+            options.isReuse = true;
+        }
+        else if (hasValue && (std::strcmp(argv[i], "--frames") == 0))
+        {
+            options.frames = std::strtoul(argv[++i], 0, 10);
+        }
+        else if (hasValue && (std::strcmp(argv[i], "--layouts") == 0))
+        {
+            options.layouts = std::strtoul(argv[++i], 0, 10);
+        }
+        else if (hasValue && (std::strcmp(argv[i], "--threads") == 0))
+        {
+            options.threads = std::strtoul(argv[++i], 0, 10);
+        }
+        else if (hasValue && (std::strcmp(argv[i], "--seed") == 0))
+        {
+            options.seed = std::strtoull(argv[++i], 0, 0);
+        }
+        else if (hasValue && (std::strcmp(argv[i], "--capture") == 0))
+        {
+            options.capture = argv[++i];
+        }
+        else
+        {
+            result = false;
+        }
+    }
+
+    return result && (options.frames != 0UL) && (options.threads != 0UL) &&
+           (options.layouts != 0UL) && (options.layouts <= 0xFFFFUL);
+}
+
+//------------------------------------------------------------------------------
+void generate(const Options& options, Database& database)
+{
+    Random random(options.seed);
+
+    database.layouts.resize(options.layouts);
+    database.picks.resize(options.frames);
+    database.signalCount = 0UL;
+
+    for (std::size_t i = 0UL; i < options.layouts; i++)
+    {
+        std::vector<uint16_t>& layout = database.layouts[i];
+
+        const std::size_t count = 4UL + (random.next() % (CELL_COUNT - 3UL));
+
+        // Pool entries are in cell order, so is the layout
+        for (std::size_t cell = 0UL; cell < CELL_COUNT; cell++)
+        {
+            if ((random.next() % CELL_COUNT) < count)
+            {
+                const std::size_t variant = random.next() % VARIANT_COUNT;
+
+                layout.push_back(static_cast<uint16_t>((cell * VARIANT_COUNT) + variant));
+            }
+        }
+
+        database.signalCount += layout.size();
+    }
+
+    for (std::size_t i = 0UL; i < options.frames; i++)
+    {
+        database.picks[i] = static_cast<uint16_t>(random.next() % options.layouts);
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32_t elapsed(const std::chrono::steady_clock::time_point& start)
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+}
+
+//------------------------------------------------------------------------------
+double seconds(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//------------------------------------------------------------------------------
+void encodeRange(const Database& database,
+                 const std::size_t first,
+                 const std::size_t last,
+                 uint8_t* frames,
+                 SignalPool& pool,
+                 Partial& partial)
+{
+    for (std::size_t i = first; i < last; i++)
+    {
+        const std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+
+        const uint16_t pick = database.picks[i];
+
+        const std::vector<uint16_t>& layout = database.layouts[pick];
+
+        bit::Buffer<FRAME_SIZE> frame;
+
+        LayoutId id;
+        Counter counter;
+
+        id.write(pick);
+        counter.write(static_cast<uint8_t>(i));
+
+        frame << id << counter;
+
+        for (std::size_t j = 0UL; j < layout.size(); j++)
+        {
+            pool.write(layout[j], i + j);
+
+            frame << pool.signal(layout[j]);
+        }
+
+        (void) std::memcpy(&frames[i * FRAME_SIZE], frame.data(), FRAME_SIZE);
+
+        partial.signals += layout.size() + HEADER_SIGNALS;
+        partial.latencies.push_back(elapsed(start));
+    }
+}
+
+//------------------------------------------------------------------------------
+void decodeChunk(void* context,
+                 const std::size_t worker,
+                 const std::size_t first,
+                 const std::size_t last)
+{
+    const ReplayContext& replay = *static_cast<ReplayContext*>(context);
+
+    Partial& partial = (*replay.partials)[worker];
+
+    SignalPool& pool = (*replay.pools)[worker];
+
+    for (std::size_t i = first; i < last; i++)
+    {
+        const std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+
+        bit::BufferView view = replay.reader->frame(i);
+
+        LayoutId id;
+        Counter counter;
+
+        uint16_t layout;
+        uint8_t sequence;
+
+        view >> id >> counter;
+
+        id.read(layout);
+        counter.read(sequence);
+
+        if (layout < replay.database->layouts.size())
+        {
+            const std::vector<uint16_t>& signals = replay.database->layouts[layout];
+
+            for (std::size_t j = 0UL; j < signals.size(); j++)
+            {
+                // Decoding ORs the buffer bits into the signal, zero it first
+                pool.write(signals[j], 0ULL);
+
+                view >> pool.signal(signals[j]);
+
+                partial.checksum += pool.read(signals[j]);
+            }
+
+            partial.signals += signals.size() + HEADER_SIGNALS;
+        }
+
+        partial.checksum += sequence;
+        partial.latencies.push_back(elapsed(start));
+    }
+}
+
+//------------------------------------------------------------------------------
+Result summarize(const std::size_t threads,
+                 const double seconds,
+                 std::vector<Partial>& partials)
+{
+    Result result = {threads, seconds, 0UL, 0UL, 0U, 0U};
+
+    std::vector<uint32_t> latencies;
+
+    for (std::size_t i = 0UL; i < partials.size(); i++)
+    {
+        latencies.insert(latencies.end(),
+                         partials[i].latencies.begin(),
+                         partials[i].latencies.end());
+
+        result.signals += partials[i].signals;
+    }
+
+    result.frames = latencies.size();
+
+    if (!latencies.empty())
+    {
+        std::vector<uint32_t>::iterator p50 = latencies.begin() + (latencies.size() / 2UL);
+        std::vector<uint32_t>::iterator p99 = latencies.begin() +
+                                              ((latencies.size() * 99UL) / 100UL);
+
+        std::nth_element(latencies.begin(), p50, latencies.end());
+        result.p50 = *p50;
+
+        std::nth_element(latencies.begin(), p99, latencies.end());
+        result.p99 = *p99;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void reset(std::vector<Partial>& partials, const std::size_t threads, const std::size_t frames)
+{
+    partials.resize(threads);
+
+    for (std::size_t i = 0UL; i < threads; i++)
+    {
+        partials[i].latencies.clear();
+        partials[i].latencies.reserve(frames);
+        partials[i].signals = 0UL;
+        partials[i].checksum = 0.0;
+    }
+}
+
+//------------------------------------------------------------------------------
+Result encode(const Options& options,
+              const Database& database,
+              const std::size_t threads,
+              std::vector<uint8_t>& frames)
+{
+    std::vector<Partial> partials;
+    std::vector<SignalPool> pools(threads);
+    std::vector<std::thread> pool;
+
+    reset(partials, threads, (options.frames / threads) + 1UL);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0UL; i < threads; i++)
+    {
+        const std::size_t first = (options.frames * i) / threads;
+        const std::size_t last = (options.frames * (i + 1UL)) / threads;
+
+        pool.push_back(std::thread(encodeRange,
+                                   std::cref(database),
+                                   first,
+                                   last,
+                                   &frames[0],
+                                   std::ref(pools[i]),
+                                   std::ref(partials[i])));
+    }
+
+    for (std::size_t i = 0UL; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+
+    return summarize(threads, seconds(start), partials);
+}
+
+//------------------------------------------------------------------------------
+Result decode(const bit::CaptureReader& reader,
+              const Database& database,
+              const std::size_t threads)
+{
+    std::vector<Partial> partials;
+    std::vector<SignalPool> pools(threads);
+
+    reset(partials, threads, reader.count());
+
+    ReplayContext context = {&reader, &database, &pools, &partials};
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    reader.parallel(threads, 0UL, &decodeChunk, &context);
+
+    return summarize(threads, seconds(start), partials);
+}
+
+//------------------------------------------------------------------------------
+void print(const char* mode, const Result& result, const Result& single)
+{
+    const double rate = result.frames / result.seconds;
+
+    const double efficiency = rate / ((single.frames / single.seconds) * result.threads);
+
+    std::printf("%-7s %7zu %14.0f %14.0f %9u %9u %10.1f%%\n",
+                mode,
+                result.threads,
+                rate,
+                result.signals / result.seconds,
+                result.p50,
+                result.p99,
+                efficiency * 100.0);
+}
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    int result = EXIT_FAILURE;
+
+    Options options;
+
+    Database database;
+
+    if (!parse(argc, argv, options))
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--frames N] [--layouts L] [--threads T] [--seed S] "
+                     "[--capture PATH] [--reuse]\n",
+                     argv[0]);
+    }
+    else
+    {
+        generate(options, database);
+
+        std::printf("%zu layouts, %zu signals, %zu byte frames\n\n",
+                    options.layouts, database.signalCount, FRAME_SIZE);
+
+        std::printf("%-7s %7s %14s %14s %9s %9s %11s\n",
+                    "mode", "threads", "frames/s", "signals/s", "p50 ns", "p99 ns",
+                    "efficiency");
+
+        bool isReady = options.isReuse;
+
+        if (!options.isReuse)
+        {
+            std::vector<uint8_t> frames(options.frames * FRAME_SIZE);
+
+            Result single = {1UL, 1.0, 0UL, 0UL, 0U, 0U};
+
+            for (std::size_t i = 1UL; i <= options.threads; i++)
+            {
+                const Result run = encode(options, database, i, frames);
+
+                single = (1UL == i) ? run : single;
+
+                print("encode", run, single);
+            }
+
+            bit::CaptureWriter writer;
+
+            isReady = (writer.open(options.capture, FRAME_SIZE) == bit::CaptureWriter::Ok);
+
+            for (std::size_t i = 0UL; (i < options.frames) && isReady; i++)
+            {
+                isReady = (writer.write(i * 1000ULL, &frames[i * FRAME_SIZE]) ==
+                           bit::CaptureWriter::Ok);
+            }
+
+            isReady = (writer.close() == bit::CaptureWriter::Ok) && isReady;
+        }
+
+        bit::CaptureReader reader;
+
+        if (isReady && (reader.open(options.capture) == bit::CaptureReader::Ok) &&
+            (reader.frameSize() == FRAME_SIZE))
+        {
+            Result single = {1UL, 1.0, 0UL, 0UL, 0U, 0U};
+
+            for (std::size_t i = 1UL; i <= options.threads; i++)
+            {
+                const Result run = decode(reader, database, i);
+
+                single = (1UL == i) ? run : single;
+
+                print("decode", run, single);
+            }
+
+            result = EXIT_SUCCESS;
+        }
+        else
+        {
+            std::fprintf(stderr, "cannot replay %s\n", options.capture);
+        }
+    }
+
+    return result;
+}
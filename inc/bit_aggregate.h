@@ -0,0 +1,456 @@
+#ifndef BIT_AGGREGATE_H
+#define BIT_AGGREGATE_H
+
+//!
+//! \file bit_aggregate.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Single pass aggregation of a signal over a log of frames
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The signal is read straight from the packed frames, no
+//!             intermediate decoded array is produced. Partial results of
+//!             several threads are combined with merge()
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+#include <limits>
+#include <type_traits>
+
+namespace bit
+{
+template <typename SignalType>
+class Statistics
+{
+public:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Value type of the signal
+    //!
+    typedef typename SignalType::Type Type;
+
+    //!
+    //! \brief Accumulator type of the sum (exact for integer signals)
+    //!
+    typedef typename std::conditional<
+            std::is_floating_point<Type>::value,
+            double,
+            typename std::conditional<std::is_signed<Type>::value,
+                                      int64_t,
+                                      uint64_t>::type>::type Sum;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty aggregation
+    //!
+    Statistics()
+        : mCount(0UL)
+        , mMin(std::numeric_limits<Type>::max())
+        , mMax(std::numeric_limits<Type>::lowest())
+        , mSum(0)
+    {
+    }
+
+    //!
+    //! \brief Destroys an aggregation object
+    //!
+    ~Statistics()
+    {
+    }
+
+    //!
+    //! \brief Discards every accumulated value
+    //!
+    void clear()
+    {
+        mCount = 0UL;
+        mMin = std::numeric_limits<Type>::max();
+        mMax = std::numeric_limits<Type>::lowest();
+        mSum = 0;
+    }
+
+    //!
+    //! \brief Accumulates one signal value
+    //!
+    //! \param value    The signal value
+    //!
+    void add(const Type& value)
+    {
+        if (value < mMin)
+        {
+            mMin = value;
+        }
+
+        if (value > mMax)
+        {
+            mMax = value;
+        }
+
+        mSum += static_cast<Sum>(value);
+
+        mCount++;
+    }
+
+    //!
+    //! \brief Accumulates the signal of an array of frames
+    //!
+    //! \param frames   The first byte of the first frame
+    //! \param count    The number of frames
+    //! \param stride   The byte distance between two consecutive frames
+    //! \param size     The byte size of a frame
+    //!
+    void accumulate(const uint8_t* frames,
+                    const std::size_t count,
+                    const std::size_t stride,
+                    const std::size_t size)
+    {
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            add(Field<SignalType>::read(&frames[i * stride], size));
+        }
+    }
+
+    //!
+    //! \brief Accumulates the signal of a contiguous array of buffers
+    //!
+    //! \param frames   The buffers
+    //! \param count    The number of buffers
+    //!
+    template <std::size_t Size>
+    void accumulate(const Buffer<Size>* frames, const std::size_t count)
+    {
+        accumulate(frames->data(), count, sizeof(Buffer<Size>), Size);
+    }
+
+    //!
+    //! \brief Combines the partial result of another aggregation
+    //!
+    //! \param other    The partial result (i.e. from another thread)
+    //!
+    void merge(const Statistics& other)
+    {
+        if (other.mCount != 0UL)
+        {
+            if (other.mMin < mMin)
+            {
+                mMin = other.mMin;
+            }
+
+            if (other.mMax > mMax)
+            {
+                mMax = other.mMax;
+            }
+
+            mSum += other.mSum;
+            mCount += other.mCount;
+        }
+    }
+
+    //!
+    //! \brief Returns the number of accumulated values
+    //!
+    //! \return std::size_t The value count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns the minimum accumulated value
+    //!
+    //! \return Type    The minimum (undefined if count() is zero)
+    //!
+    Type min() const
+    {
+        return mMin;
+    }
+
+    //!
+    //! \brief Returns the maximum accumulated value
+    //!
+    //! \return Type    The maximum (undefined if count() is zero)
+    //!
+    Type max() const
+    {
+        return mMax;
+    }
+
+    //!
+    //! \brief Returns the sum of the accumulated values
+    //!
+    //! \return Sum The sum
+    //!
+    Sum sum() const
+    {
+        return mSum;
+    }
+
+    //!
+    //! \brief Returns the mean of the accumulated values
+    //!
+    //! \return double  The mean, zero if count() is zero
+    //!
+    double mean() const
+    {
+        double result = 0.0;
+
+        if (mCount != 0UL)
+        {
+            result = static_cast<double>(mSum) / static_cast<double>(mCount);
+        }
+
+        return result;
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Number of accumulated values
+    //!
+    std::size_t mCount;
+
+    //!
+    //! \brief Minimum accumulated value
+    //!
+    Type mMin;
+
+    //!
+    //! \brief Maximum accumulated value
+    //!
+    Type mMax;
+
+    //!
+    //! \brief Sum of the accumulated values
+    //!
+    Sum mSum;
+};
+
+template <typename SignalType, std::size_t Bins>
+class Histogram
+{
+public:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Value type of the signal
+    //!
+    typedef typename SignalType::Type Type;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty histogram of Bins equal bins
+    //!
+    //! \param lower    The lower bound of the first bin (inclusive)
+    //! \param upper    The upper bound of the last bin (exclusive)
+    //!
+    Histogram(const double lower, const double upper)
+        : mLower(lower)
+        , mScale(static_cast<double>(Bins) / (upper - lower))
+        , mUnderflow(0UL)
+        , mOverflow(0UL)
+        , mBins()
+        , mStatistics()
+    {
+    }
+
+    //!
+    //! \brief Destroys a histogram object
+    //!
+    ~Histogram()
+    {
+    }
+
+    //!
+    //! \brief Discards every accumulated value
+    //!
+    void clear()
+    {
+        mUnderflow = 0UL;
+        mOverflow = 0UL;
+
+        for (std::size_t i = 0UL; i < Bins; i++)
+        {
+            mBins[i] = 0UL;
+        }
+
+        mStatistics.clear();
+    }
+
+    //!
+    //! \brief Accumulates one signal value
+    //!
+    //! \param value    The signal value
+    //!
+    void add(const Type& value)
+    {
+        const double position = (static_cast<double>(value) - mLower) * mScale;
+
+        // NaN values are counted as underflow
+        if (!(position >= 0.0))
+        {
+            mUnderflow++;
+        }
+        else if (position >= static_cast<double>(Bins))
+        {
+            mOverflow++;
+        }
+        else
+        {
+            mBins[static_cast<std::size_t>(position)]++;
+        }
+
+        mStatistics.add(value);
+    }
+
+    //!
+    //! \brief Accumulates the signal of an array of frames
+    //!
+    //! \param frames   The first byte of the first frame
+    //! \param count    The number of frames
+    //! \param stride   The byte distance between two consecutive frames
+    //! \param size     The byte size of a frame
+    //!
+    void accumulate(const uint8_t* frames,
+                    const std::size_t count,
+                    const std::size_t stride,
+                    const std::size_t size)
+    {
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            add(Field<SignalType>::read(&frames[i * stride], size));
+        }
+    }
+
+    //!
+    //! \brief Accumulates the signal of a contiguous array of buffers
+    //!
+    //! \param frames   The buffers
+    //! \param count    The number of buffers
+    //!
+    template <std::size_t Size>
+    void accumulate(const Buffer<Size>* frames, const std::size_t count)
+    {
+        accumulate(frames->data(), count, sizeof(Buffer<Size>), Size);
+    }
+
+    //!
+    //! \brief Combines the partial result of another histogram
+    //!
+    //! \param other    The partial result, built with the same bounds
+    //!
+    void merge(const Histogram& other)
+    {
+        mUnderflow += other.mUnderflow;
+        mOverflow += other.mOverflow;
+
+        for (std::size_t i = 0UL; i < Bins; i++)
+        {
+            mBins[i] += other.mBins[i];
+        }
+
+        mStatistics.merge(other.mStatistics);
+    }
+
+    //!
+    //! \brief Returns the number of values of a bin
+    //!
+    //! \param i    The bin index (0 - Bins-1)
+    //!
+    //! \return std::size_t The value count
+    //!
+    std::size_t bin(const std::size_t i) const
+    {
+        return (i < Bins) ? mBins[i] : 0UL;
+    }
+
+    //!
+    //! \brief Returns the number of values below the lower bound
+    //!
+    //! \return std::size_t The value count
+    //!
+    std::size_t underflow() const
+    {
+        return mUnderflow;
+    }
+
+    //!
+    //! \brief Returns the number of values at or above the upper bound
+    //!
+    //! \return std::size_t The value count
+    //!
+    std::size_t overflow() const
+    {
+        return mOverflow;
+    }
+
+    //!
+    //! \brief Returns the min/max/sum of the values, gathered in the same pass
+    //!
+    //! \return const Statistics&   The statistics of the signal
+    //!
+    const Statistics<SignalType>& statistics() const
+    {
+        return mStatistics;
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Lower bound of the first bin
+    //!
+    double mLower;
+
+    //!
+    //! \brief Number of bins per signal unit
+    //!
+    double mScale;
+
+    //!
+    //! \brief Number of values below the lower bound
+    //!
+    std::size_t mUnderflow;
+
+    //!
+    //! \brief Number of values at or above the upper bound
+    //!
+    std::size_t mOverflow;
+
+    //!
+    //! \brief Value count of each bin
+    //!
+    std::size_t mBins[Bins];
+
+    //!
+    //! \brief Statistics of the signal
+    //!
+    Statistics<SignalType> mStatistics;
+};
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef BIT_ATOMIC_H
+#define BIT_ATOMIC_H
+
+//!
+//! \file bit_atomic.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Bit buffer with atomic signal insertion
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The frame is held in aligned 64-bit atomic words, so writers
+//!             on different threads update disjoint signals without a lock.
+//!             Flags are set and cleared with a single fetch_or/fetch_and,
+//!             wider fields with a compare-exchange loop on their word
+//!
+//! \note       A signal straddling two words is updated with one
+//!             compare-exchange per word. Other signals are never disturbed,
+//!             but a reader may see the new bits of one word with the old
+//!             bits of the other. Keep signals that must change atomically
+//!             inside one 64-bit word (bits 64*n to 64*n+63 of the stream)
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace bit
+{
+template <std::size_t Size>
+class AtomicBuffer
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a cleared atomic buffer
+    //!
+    AtomicBuffer()
+        : mWords()
+    {
+        clear();
+    }
+
+    //!
+    //! \brief Destroys an atomic buffer object
+    //!
+    ~AtomicBuffer()
+    {
+    }
+
+    //!
+    //! \brief Clears every bit of the buffer
+    //!
+    //! \note   Not atomic with respect to concurrent writers
+    //!
+    void clear()
+    {
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            mWords[i].store(0ULL, std::memory_order_release);
+        }
+    }
+
+    //!
+    //! \brief Atomically replaces the value of a signal
+    //!
+    //! \param value    The new signal value
+    //!
+    template <typename SignalType>
+    void write(const typename SignalType::Type& value)
+    {
+        typedef Field<SignalType> Layout;
+
+        static_assert(Layout::END <= Size, "Signal out of the buffer");
+
+        const std::size_t first = Layout::OFFSET / U64_BIT_COUNT;
+        const std::size_t last = (Layout::OFFSET + Layout::WIDTH - 1UL) /
+                                 U64_BIT_COUNT;
+
+        const uint64_t raw = fieldRaw(value);
+
+        if (first == last)
+        {
+            const std::size_t left = U64_BIT_COUNT -
+                                     (Layout::OFFSET % U64_BIT_COUNT) -
+                                     Layout::WIDTH;
+
+            const uint64_t mask = (~0ULL >> (U64_BIT_COUNT - Layout::WIDTH)) << left;
+
+            update(first, mask, (raw << left) & mask);
+        }
+        else
+        {
+            // Straddling field, the high bits go to the first word
+            const std::size_t low = (Layout::OFFSET + Layout::WIDTH) -
+                                    (last * U64_BIT_COUNT);
+            const std::size_t high = Layout::WIDTH - low;
+
+            const uint64_t highMask = ~0ULL >> (U64_BIT_COUNT - high);
+            const uint64_t lowMask = (~0ULL >> (U64_BIT_COUNT - low)) <<
+                                     (U64_BIT_COUNT - low);
+
+            update(first, highMask, (raw >> low) & highMask);
+            update(last, lowMask, (raw << (U64_BIT_COUNT - low)) & lowMask);
+        }
+    }
+
+    //!
+    //! \brief Atomically inserts a signal, replacing its previous value
+    //!
+    //! \param signal   The signal
+    //!
+    //! \return AtomicBuffer&   This buffer
+    //!
+    template <typename SignalType>
+    AtomicBuffer& operator<<(SignalType& signal)
+    {
+        typename SignalType::Type value;
+
+        signal.read(value);
+
+        write<SignalType>(value);
+
+        return *this;
+    }
+
+    //!
+    //! \brief Reads the current value of a signal
+    //!
+    //! \return Type    The signal value
+    //!
+    template <typename SignalType>
+    typename SignalType::Type read() const
+    {
+        typedef Field<SignalType> Layout;
+
+        static_assert(Layout::END <= Size, "Signal out of the buffer");
+
+        const std::size_t first = Layout::OFFSET / U64_BIT_COUNT;
+        const std::size_t last = (Layout::OFFSET + Layout::WIDTH - 1UL) /
+                                 U64_BIT_COUNT;
+
+        uint64_t words[2] = {0ULL, 0ULL};
+
+        for (std::size_t i = first; i <= last; i++)
+        {
+            words[i - first] = mWords[i].load(std::memory_order_acquire);
+        }
+
+        typename SignalType::Type result;
+
+        fieldValue(extractField(reinterpret_cast<const uint8_t*>(words),
+                                sizeof(words),
+                                Layout::OFFSET - (first * U64_BIT_COUNT),
+                                Layout::WIDTH),
+                   Layout::WIDTH,
+                   result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Copies the buffer, word by word
+    //!
+    //! \param frame    The copy (i.e. the outgoing frame)
+    //!
+    void snapshot(Buffer<Size>& frame) const
+    {
+        uint64_t words[WORD_COUNT];
+
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            words[i] = mWords[i].load(std::memory_order_acquire);
+        }
+
+        (void) std::memcpy(frame.data(), words, Size);
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Number of 64-bit words holding the buffer
+    //!
+    static const std::size_t WORD_COUNT = (Size + sizeof(uint64_t) - 1UL) /
+                                          sizeof(uint64_t);
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Buffer bytes, in stream order within every word
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> mWords[WORD_COUNT];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    AtomicBuffer(const AtomicBuffer&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    AtomicBuffer& operator=(const AtomicBuffer&);
+
+    //!
+    //! \brief Converts a stream order word (first byte most significant) to
+    //!        the in-memory word and back
+    //!
+    static uint64_t native(const uint64_t word)
+    {
+        uint64_t result = word;
+
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+        result = __builtin_bswap64(result);
+
+#endif
+
+        return result;
+    }
+
+    //!
+    //! \brief Atomically replaces the masked bits of a word
+    //!
+    //! \param index    The word index
+    //! \param mask     The field mask, stream order
+    //! \param bits     The field bits, stream order, within the mask
+    //!
+    void update(const std::size_t index, const uint64_t mask, const uint64_t bits)
+    {
+        const uint64_t nativeMask = native(mask);
+        const uint64_t nativeBits = native(bits);
+
+        if (nativeBits == nativeMask)
+        {
+            (void) mWords[index].fetch_or(nativeMask, std::memory_order_acq_rel);
+        }
+        else if (0ULL == nativeBits)
+        {
+            (void) mWords[index].fetch_and(~nativeMask, std::memory_order_acq_rel);
+        }
+        else
+        {
+            uint64_t expected = mWords[index].load(std::memory_order_relaxed);
+
+            while (!mWords[index].compare_exchange_weak(
+                       expected,
+                       (expected & ~nativeMask) | nativeBits,
+                       std::memory_order_acq_rel,
+                       std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <std::size_t Size>
+const std::size_t AtomicBuffer<Size>::WORD_COUNT;
+}
+
+#endif
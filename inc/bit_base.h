@@ -63,6 +63,16 @@ const std::size_t U16_BIT_COUNT = 16UL;
 //!
 const std::size_t U32_BIT_COUNT = 32UL;
 
+//!
+//! \brief uint64_t bit count
+//!
+const std::size_t U64_BIT_COUNT = 64UL;
+
+//!
+//! \brief Cache line size, alignment of data shared between threads
+//!
+const std::size_t CACHE_LINE_SIZE = 64UL;
+
 //!
 //! \brief U04 bit mask
 //!
@@ -142,6 +152,144 @@ uint32_t reflect(const uint32_t data, const bool isLsbFirst);
 //!
 uint8_t parity(const uint32_t data, Parity parity);
 
+//!
+//! \brief Returns the number of bits set
+//!
+//! \param data The data
+//!
+//! \return std::size_t The number of bits set (0-32)
+//!
+inline std::size_t popcount(const uint32_t data)
+{
+#if defined(__GNUC__)
+
+    return static_cast<std::size_t>(__builtin_popcount(data));
+
+#else
+
+    uint32_t count = data - ((data >> 1U) & 0x55555555UL);
+
+    count = (count & 0x33333333UL) + ((count >> 2U) & 0x33333333UL);
+    count = (count + (count >> 4U)) & 0x0F0F0F0FUL;
+
+    return static_cast<std::size_t>((count * 0x01010101UL) >> 24U);
+
+#endif
+}
+
+//!
+//! \brief Returns the number of bits set
+//!
+//! \param data The data
+//!
+//! \return std::size_t The number of bits set (0-64)
+//!
+inline std::size_t popcount(const uint64_t data)
+{
+#if defined(__GNUC__)
+
+    return static_cast<std::size_t>(__builtin_popcountll(data));
+
+#else
+
+    return popcount(static_cast<uint32_t>(data)) +
+           popcount(static_cast<uint32_t>(data >> U32_BIT_COUNT));
+
+#endif
+}
+
+//!
+//! \brief Returns the number of zero bits above the most significant bit set
+//!
+//! \param data The data, at least one bit set
+//!
+//! \return std::size_t The leading zero count (0-63)
+//!
+inline std::size_t leadingZeros(const uint64_t data)
+{
+#if defined(__GNUC__)
+
+    return static_cast<std::size_t>(__builtin_clzll(data));
+
+#else
+
+    std::size_t result = 0UL;
+
+    uint64_t bits = data;
+
+    for (std::size_t shift = U32_BIT_COUNT; shift != 0UL; shift /= 2UL)
+    {
+        if ((bits >> (U64_BIT_COUNT - shift)) == 0ULL)
+        {
+            bits <<= shift;
+            result += shift;
+        }
+    }
+
+    return result;
+
+#endif
+}
+
+//!
+//! \brief Returns the number of zero bits below the least significant bit set
+//!
+//! \param data The data, at least one bit set
+//!
+//! \return std::size_t The trailing zero count (0-63)
+//!
+inline std::size_t trailingZeros(const uint64_t data)
+{
+#if defined(__GNUC__)
+
+    return static_cast<std::size_t>(__builtin_ctzll(data));
+
+#else
+
+    std::size_t result = 0UL;
+
+    uint64_t bits = data;
+
+    for (std::size_t shift = U32_BIT_COUNT; shift != 0UL; shift /= 2UL)
+    {
+        if ((bits << (U64_BIT_COUNT - shift)) == 0ULL)
+        {
+            bits >>= shift;
+            result += shift;
+        }
+    }
+
+    return result;
+
+#endif
+}
+
+//!
+//! \brief Calculates the parity of the given 64-bit fixed-width integer
+//!
+//! \param data     The 64-bit fixed-width integer
+//! \param parity   The parity type
+//!
+//! \return uint8_t The parity of the data
+//!
+//! \note   A single instruction sequence (popcnt or the parity flag), unlike
+//!         the byte table of parity(uint32_t)
+//!
+inline uint8_t parity64(const uint64_t data, Parity parity)
+{
+#if defined(__GNUC__)
+
+    const uint8_t result = static_cast<uint8_t>(__builtin_parityll(data));
+
+#else
+
+    const uint8_t result = static_cast<uint8_t>(popcount(data) & 1UL);
+
+#endif
+
+    return result ^ static_cast<uint8_t>(parity);
+}
+
 //!
 //! \brief Converts a pair of nibbles to an unsigned 8-bit fixed-width integer
 //!
@@ -23,12 +23,70 @@
 
 //---------------------------- Include files -----------------------------------
 
+#include "bit_counters.h"
+#include "bit_recorder.h"
 #include "bit_signal.h"
 
 #include <cstring>
 
 namespace bit
 {
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Extracts the data of a signal from a byte source
+//!
+//! \param source   The byte source (Buffer, BufferView) with operator[]
+//! \param signal   The signal to write the source data to
+//!
+template <typename Source>
+void readSignal(Source& source, SignalData& signal)
+{
+    BIT_TIME(DecodeCycles);
+    BIT_COUNT(SignalReads, 1ULL);
+    BIT_COUNT_SIGNAL(signal);
+    BIT_RECORD_BEGIN();
+
+    uint8_t rem = 0U;
+
+    std::size_t i = signal.sizeInBuffer();
+
+    do
+    {
+        i--;
+
+        const std::size_t pos = i + signal.position();
+
+        const uint8_t byte = source[pos];
+
+        if (i < signal.typeSize())
+        {
+            const std::size_t shiftL = signal.readLShift();
+
+            if (0U == rem)
+            {
+                signal[i] |= static_cast<uint8_t>(byte << shiftL);
+            }
+            else
+            {
+                signal[i] |= rem;
+
+                signal[i] |= static_cast<uint8_t>(byte << shiftL);
+            }
+        }
+
+        const std::size_t shiftR = signal.readRShift();
+
+        if (shiftR != 0UL)
+        {
+            rem = static_cast<uint8_t>(byte >> shiftR);
+        }
+
+    } while (i > 0UL);
+
+    BIT_RECORD_END(SignalDecode, Recorder::frame(), signalOffset(signal), source.status());
+}
+
 template <std::size_t Size>
 class Buffer
 {
@@ -53,10 +111,35 @@ public:
     Buffer()
         : mOverrunData(0U)
         , mStatus(Ok)
+        , mGeneration(0U)
         , mBuffer()
     {
     }
 
+    //!
+    //! \brief Copies the data of another bit buffer
+    //!
+    //! \param other    The bit buffer to copy
+    //!
+    //! \return Buffer& The bit buffer instance
+    //!
+    //! \note   The generation is advanced, not copied
+    //!
+    Buffer& operator=(const Buffer& other)
+    {
+        if (this != &other)
+        {
+            mOverrunData = other.mOverrunData;
+            mStatus = other.mStatus;
+
+            (void) std::memcpy(mBuffer, other.mBuffer, Size);
+
+            touch();
+        }
+
+        return *this;
+    }
+
     //!
     //! \brief Destroys a bit buffer object
     //!
@@ -73,6 +156,30 @@ public:
         mOverrunData = 0U;
 
         (void) std::memset(mBuffer, 0, Size);
+
+        touch();
+    }
+
+    //!
+    //! \brief Returns the generation of the bit buffer data
+    //!
+    //! \details    The generation advances on every write through clear(),
+    //!             operator<<, operator= and the non-const data(). Writes
+    //!             through operator[] shall be followed by touch()
+    //!
+    //! \return uint32_t    The generation
+    //!
+    uint32_t generation() const
+    {
+        return mGeneration;
+    }
+
+    //!
+    //! \brief Advances the generation, invalidating the decode caches
+    //!
+    void touch()
+    {
+        mGeneration++;
     }
 
     //!
@@ -95,6 +202,28 @@ public:
         return Size;
     }
 
+    //!
+    //! \brief Returns the raw bytes of the bit buffer
+    //!
+    //! \return uint8_t*    Pointer to the first byte of the buffer
+    //!
+    uint8_t* data()
+    {
+        touch();
+
+        return mBuffer;
+    }
+
+    //!
+    //! \brief Returns the raw bytes of the bit buffer
+    //!
+    //! \return const uint8_t*  Pointer to the first byte of the buffer
+    //!
+    const uint8_t* data() const
+    {
+        return mBuffer;
+    }
+
     //!
     //! \brief Extracts data from the bit buffer to a signal
     //!
@@ -110,42 +239,7 @@ public:
     //lint -e{9093}
     Buffer& operator >>(SignalData& signal)
     {
-        uint8_t rem = 0U;
-
-        std::size_t i = signal.sizeInBuffer();
-
-        do
-        {
-            i--;
-
-            const std::size_t pos = i + signal.position();
-
-            const uint8_t byte = (*this)[pos];
-
-            if (i < signal.typeSize())
-            {
-                const std::size_t shiftL = signal.readLShift();
-
-                if (0U == rem)
-                {
-                    signal[i] |= static_cast<uint8_t>(byte << shiftL);
-                }
-                else
-                {
-                    signal[i] |= rem;
-
-                    signal[i] |= static_cast<uint8_t>(byte << shiftL);
-                }
-            }
-
-            const std::size_t shiftR = signal.readRShift();
-
-            if (shiftR != 0UL)
-            {
-                rem = static_cast<uint8_t>(byte >> shiftR);
-            }
-
-        } while (i > 0UL);
+        readSignal(*this, signal);
 
         return *this;
     }
@@ -165,8 +259,15 @@ public:
     //lint -e{9093}
     Buffer& operator <<(SignalData& signal)
     {
+        BIT_TIME(EncodeCycles);
+        BIT_COUNT(SignalWrites, 1ULL);
+        BIT_COUNT_SIGNAL(signal);
+        BIT_RECORD_BEGIN();
+
         uint8_t rem = 0U;
 
+        touch();
+
         std::size_t i = 0UL;
 
         do
@@ -204,6 +305,8 @@ public:
 
         } while (i < signal.sizeInBuffer());
 
+        BIT_RECORD_END(SignalEncode, Recorder::frame(), signalOffset(signal), mStatus);
+
          return *this;
     }
 
@@ -225,6 +328,9 @@ public:
         else
         {
             mStatus = Overflow;
+
+            BIT_COUNT_OVERFLOW(this, i);
+            BIT_RECORD_OVERFLOW(i);
         }
 
         return *result;
@@ -246,6 +352,11 @@ private:
     //!
     Status mStatus;
 
+    //!
+    //! \brief Generation of the bit buffer data
+    //!
+    uint32_t mGeneration;
+
     //!
     //! \brief Contains the bit buffer data
     //!
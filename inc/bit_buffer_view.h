@@ -0,0 +1,207 @@
+#ifndef BIT_BUFFER_VIEW_H
+#define BIT_BUFFER_VIEW_H
+
+//!
+//! \file bit_buffer_view.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Read-only view of frame bytes owned by someone else
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+namespace bit
+{
+class BufferView
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the buffer view
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty buffer view
+    //!
+    BufferView()
+        : mData(0)
+        , mSize(0UL)
+        , mOverrunData(0U)
+        , mStatus(Ok)
+    {
+    }
+
+    //!
+    //! \brief Constructs a view of raw frame bytes (zero-copy)
+    //!
+    //! \param data The first byte of the frame
+    //! \param size The byte size of the frame
+    //!
+    BufferView(const uint8_t* data, const std::size_t size)
+        : mData(data)
+        , mSize(size)
+        , mOverrunData(0U)
+        , mStatus(Ok)
+    {
+    }
+
+    //!
+    //! \brief Constructs a view of a bit buffer (zero-copy)
+    //!
+    //! \param buffer   The viewed buffer
+    //!
+    template <std::size_t Size>
+    explicit BufferView(const Buffer<Size>& buffer)
+        : mData(buffer.data())
+        , mSize(Size)
+        , mOverrunData(0U)
+        , mStatus(Ok)
+    {
+    }
+
+    //!
+    //! \brief Destroys a buffer view object
+    //!
+    ~BufferView()
+    {
+    }
+
+    //!
+    //! \brief Returns the status of the view
+    //!
+    //! \return Status  (Ok | Overflow)
+    //!
+    Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Returns the byte size of the viewed frame
+    //!
+    //! \return std::size_t The size of the frame
+    //!
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    //!
+    //! \brief Returns the viewed bytes
+    //!
+    //! \return const uint8_t*  Pointer to the first byte of the frame
+    //!
+    const uint8_t* data() const
+    {
+        return mData;
+    }
+
+    //!
+    //! \brief Extracts data from the viewed frame to a signal
+    //!
+    //! \param signal   The signal to write the frame data to
+    //!
+    //! \return BufferView& The buffer view instance
+    //!
+    //! \warning    MISRA C++ Rule 17-0-2
+    //!             the name '...' is reserved to the compiler
+    //!
+    //! \note       The name is used in a dedicated namespace
+    //!
+    //lint -e{9093}
+    BufferView& operator >>(SignalData& signal)
+    {
+        readSignal(*this, signal);
+
+        return *this;
+    }
+
+    //!
+    //! \brief Reads a signal value straight from the viewed bytes
+    //!
+    //! \return Type    The signal value
+    //!
+    template <typename SignalType>
+    typename SignalType::Type read() const
+    {
+        return Field<SignalType>::read(mData, mSize);
+    }
+
+    //!
+    //! \brief Array index operator
+    //!
+    //! \param i    The index of the array (unsigned)
+    //!
+    //! \return const uint8_t&  Reference to the data index
+    //!
+    const uint8_t& operator[](const std::size_t& i)
+    {
+        const uint8_t* result = &mOverrunData;
+
+        if (i < mSize)
+        {
+            result = &mData[i];
+        }
+        else
+        {
+            mStatus = Overflow;
+
+            BIT_COUNT_OVERFLOW(this, i);
+            BIT_RECORD_OVERFLOW(i);
+        }
+
+        return *result;
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief First byte of the viewed frame
+    //!
+    const uint8_t* mData;
+
+    //!
+    //! \brief Byte size of the viewed frame
+    //!
+    std::size_t mSize;
+
+    //!
+    //! \brief Value read on an out of bounds access (always zero)
+    //!
+    uint8_t mOverrunData;
+
+    //!
+    //! \brief Returns the current status of the view
+    //!
+    Status mStatus;
+};
+}
+
+#endif
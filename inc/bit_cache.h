@@ -0,0 +1,253 @@
+#ifndef BIT_CACHE_H
+#define BIT_CACHE_H
+
+//!
+//! \file bit_cache.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Lazy, memoized signal decode of a bit buffer
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A signal is extracted on its first read and the field bits are
+//!             kept in a small open addressing table. The whole table is
+//!             dropped in O(1) when the generation of the buffer moves, that
+//!             is whenever the buffer is written
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+namespace bit
+{
+template <std::size_t Size, std::size_t Capacity = 32UL>
+class DecodeCache
+{
+    static_assert((Capacity > 0UL) && (Capacity <= U64_BIT_COUNT),
+                  "Capacity shall be 1 to 64 signals");
+
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty cache of a bit buffer
+    //!
+    //! \param frame    The cached buffer, shall outlive the cache
+    //!
+    explicit DecodeCache(const Buffer<Size>& frame)
+        : mFrame(frame)
+        , mGeneration(frame.generation())
+        , mValid(0ULL)
+        , mHits(0ULL)
+        , mMisses(0ULL)
+    {
+    }
+
+    //!
+    //! \brief Destroys a decode cache object
+    //!
+    ~DecodeCache()
+    {
+    }
+
+    //!
+    //! \brief Reads a signal, decoding it on the first read of a generation
+    //!
+    //! \return Type    The signal value
+    //!
+    template <typename SignalType>
+    typename SignalType::Type read()
+    {
+        typedef Field<SignalType> Layout;
+
+        static_assert(Layout::END <= Size, "Signal out of the buffer");
+
+        const uint32_t tag = static_cast<uint32_t>((Layout::OFFSET << 8U) |
+                                                   Layout::WIDTH);
+
+        typename SignalType::Type result;
+
+        fieldValue(lookup(tag, Layout::OFFSET, Layout::WIDTH), Layout::WIDTH, result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Drops every cached signal
+    //!
+    void invalidate()
+    {
+        mValid = 0ULL;
+    }
+
+    //!
+    //! \brief Returns the number of reads served from the cache
+    //!
+    //! \return uint64_t    The hit count
+    //!
+    uint64_t hits() const
+    {
+        return mHits;
+    }
+
+    //!
+    //! \brief Returns the number of reads decoded from the buffer
+    //!
+    //! \return uint64_t    The miss count
+    //!
+    uint64_t misses() const
+    {
+        return mMisses;
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Multiplier of the tag hash (2^32 / golden ratio)
+    //!
+    static const uint32_t TAG_HASH = 0x9E3779B1UL;
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Cached buffer
+    //!
+    const Buffer<Size>& mFrame;
+
+    //!
+    //! \brief Buffer generation of the cached signals
+    //!
+    uint32_t mGeneration;
+
+    //!
+    //! \brief Occupied slots (bit i set for slot i)
+    //!
+    uint64_t mValid;
+
+    //!
+    //! \brief Field offset and width of every slot
+    //!
+    uint32_t mTags[Capacity];
+
+    //!
+    //! \brief Field bits of every slot
+    //!
+    uint64_t mValues[Capacity];
+
+    //!
+    //! \brief Reads served from the cache
+    //!
+    uint64_t mHits;
+
+    //!
+    //! \brief Reads decoded from the buffer
+    //!
+    uint64_t mMisses;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    DecodeCache(const DecodeCache&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    DecodeCache& operator=(const DecodeCache&);
+
+    //!
+    //! \brief Returns the field bits of a signal, from the cache if present
+    //!
+    //! \param tag      The field offset and width
+    //! \param offset   The field offset
+    //! \param width    The field width
+    //!
+    //! \return uint64_t    The field bits
+    //!
+    uint64_t lookup(const uint32_t tag,
+                    const std::size_t offset,
+                    const std::size_t width)
+    {
+        if (mFrame.generation() != mGeneration)
+        {
+            mGeneration = mFrame.generation();
+            mValid = 0ULL;
+        }
+
+        bool isFound = false;
+        bool isStored = false;
+
+        uint64_t result = 0ULL;
+
+        // Fibonacci hash of the whole tag, its high bits scaled to the table,
+        // so signals of the same width spread by offset
+        const uint32_t hash = static_cast<uint32_t>(tag * TAG_HASH);
+
+        const std::size_t start = static_cast<std::size_t>(
+                (static_cast<uint64_t>(hash) * Capacity) >> 32U);
+
+        for (std::size_t i = 0UL; (i < Capacity) && !isFound && !isStored; i++)
+        {
+            const std::size_t slot = (start + i) % Capacity;
+
+            const uint64_t bit = 1ULL << slot;
+
+            if ((mValid & bit) == 0ULL)
+            {
+                result = extractField(mFrame.data(), Size, offset, width);
+
+                mTags[slot] = tag;
+                mValues[slot] = result;
+                mValid |= bit;
+
+                isStored = true;
+            }
+            else if (mTags[slot] == tag)
+            {
+                result = mValues[slot];
+
+                isFound = true;
+            }
+            else
+            {
+            }
+        }
+
+        if (isFound)
+        {
+            mHits++;
+        }
+        else
+        {
+            mMisses++;
+
+            if (!isStored)
+            {
+                // Table full, decode without caching
+                result = extractField(mFrame.data(), Size, offset, width);
+            }
+        }
+
+        return result;
+    }
+};
+}
+
+#endif
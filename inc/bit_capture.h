@@ -0,0 +1,452 @@
+#ifndef BIT_CAPTURE_H
+#define BIT_CAPTURE_H
+
+//!
+//! \file bit_capture.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Fixed-record frame capture files
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A capture file is a CaptureHeader followed by frameCount
+//!             records. A record is a 64-bit timestamp followed by the frame
+//!             bytes, padded to a multiple of 8 bytes. Every field is stored
+//!             in host byte order
+//!
+//! \note       POSIX only (mmap), not available on Generic targets
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+
+#include <cstdio>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Capture file identifier ("BCAP")
+//!
+const uint32_t CAPTURE_MAGIC = 0x50414342UL;
+
+//!
+//! \brief Capture file format version
+//!
+const uint16_t CAPTURE_VERSION = 1U;
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Header at the start of a capture file
+//!
+struct CaptureHeader
+{
+    //!
+    //! \brief CAPTURE_MAGIC
+    //!
+    uint32_t magic;
+
+    //!
+    //! \brief CAPTURE_VERSION
+    //!
+    uint16_t version;
+
+    //!
+    //! \brief Reserved, zero
+    //!
+    uint16_t reserved;
+
+    //!
+    //! \brief Byte size of a frame
+    //!
+    uint32_t frameSize;
+
+    //!
+    //! \brief Byte size of a record (timestamp, frame and padding)
+    //!
+    uint32_t recordSize;
+
+    //!
+    //! \brief Number of records
+    //!
+    uint64_t frameCount;
+};
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the record size of a capture with the given frame size
+//!
+//! \param frameSize    The byte size of a frame
+//!
+//! \return std::size_t The byte size of a record
+//!
+std::size_t captureRecordSize(const std::size_t frameSize);
+
+class CaptureWriter
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the capture writer
+    //!
+    enum Status
+    {
+        Ok = 0,
+        OpenError,
+        WriteError
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a closed capture writer
+    //!
+    CaptureWriter();
+
+    //!
+    //! \brief Destroys the capture writer, closing the file
+    //!
+    ~CaptureWriter();
+
+    //!
+    //! \brief Creates (or truncates) a capture file
+    //!
+    //! \param path         The file path
+    //! \param frameSize    The byte size of every frame
+    //!
+    //! \return Status  Ok if the header was written
+    //!
+    Status open(const char* path, const std::size_t frameSize);
+
+    //!
+    //! \brief Appends a frame record
+    //!
+    //! \param timestamp    The frame timestamp
+    //! \param data         The frame bytes (frameSize bytes)
+    //!
+    //! \return Status  Ok if the record was written
+    //!
+    Status write(const uint64_t timestamp, const uint8_t* data);
+
+    //!
+    //! \brief Appends a bit buffer record
+    //!
+    //! \param timestamp    The frame timestamp
+    //! \param buffer       The frame, its size must be the capture frame size
+    //!
+    //! \return Status  Ok if the record was written
+    //!
+    template <std::size_t Size>
+    Status write(const uint64_t timestamp, const Buffer<Size>& buffer)
+    {
+        Status result = WriteError;
+
+        if (Size == mHeader.frameSize)
+        {
+            result = write(timestamp, buffer.data());
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Updates the header frame count and closes the file
+    //!
+    //! \return Status  Ok if the file was completed
+    //!
+    Status close();
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Capture file
+    //!
+    std::FILE* mFile;
+
+    //!
+    //! \brief Header of the capture (frame count updated on close)
+    //!
+    CaptureHeader mHeader;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    CaptureWriter(const CaptureWriter&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    CaptureWriter& operator=(const CaptureWriter&);
+};
+
+class CaptureReader
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the capture reader
+    //!
+    enum Status
+    {
+        Ok = 0,
+        OpenError,
+        MapError,
+        FormatError
+    };
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Processes the frames [first, last) of a chunk
+    //!
+    //! \param context  The user context
+    //! \param worker   The index of the worker thread (0 - workers-1)
+    //! \param first    The first frame of the chunk
+    //! \param last     One past the last frame of the chunk
+    //!
+    typedef void (*ChunkFunction)(void* context,
+                                  const std::size_t worker,
+                                  const std::size_t first,
+                                  const std::size_t last);
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a closed capture reader
+    //!
+    CaptureReader();
+
+    //!
+    //! \brief Destroys the capture reader, unmapping the file
+    //!
+    ~CaptureReader();
+
+    //!
+    //! \brief Maps a capture file (read-only, sequential access hint)
+    //!
+    //! \param path The file path
+    //!
+    //! \return Status  Ok if the file was mapped and the header is valid
+    //!
+    Status open(const char* path);
+
+    //!
+    //! \brief Unmaps the capture file, every view is invalidated
+    //!
+    void close();
+
+    //!
+    //! \brief Returns the number of frames of the capture
+    //!
+    //! \return std::size_t The frame count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns the byte size of the frames
+    //!
+    //! \return std::size_t The frame size
+    //!
+    std::size_t frameSize() const
+    {
+        return mFrameSize;
+    }
+
+    //!
+    //! \brief Returns the byte distance between two consecutive frames
+    //!
+    //! \return std::size_t The record size
+    //!
+    std::size_t stride() const
+    {
+        return mStride;
+    }
+
+    //!
+    //! \brief Returns the first byte of the first frame
+    //!
+    //! \details    Frames are stride() bytes apart, this is the input of the
+    //!             bulk kernels (Filter, Statistics, Histogram)
+    //!
+    //! \return const uint8_t*  The first frame byte
+    //!
+    const uint8_t* frames() const
+    {
+        return mFrames;
+    }
+
+    //!
+    //! \brief Returns the timestamp of a frame
+    //!
+    //! \param i    The frame index (0 - count()-1)
+    //!
+    //! \return uint64_t    The frame timestamp
+    //!
+    uint64_t timestamp(const std::size_t i) const;
+
+    //!
+    //! \brief Returns a zero-copy view of a frame
+    //!
+    //! \param i    The frame index (0 - count()-1)
+    //!
+    //! \return BufferView  The frame view, valid until close()
+    //!
+    BufferView frame(const std::size_t i) const
+    {
+        return BufferView(&mFrames[i * mStride], mFrameSize);
+    }
+
+    //!
+    //! \brief Processes the capture in chunks across worker threads
+    //!
+    //! \param workers      The number of worker threads (caller included)
+    //! \param chunkFrames  The number of frames per chunk (0 for default)
+    //! \param function     The chunk function, called concurrently
+    //! \param context      The user context
+    //!
+    //! \details    Chunks are handed out in file order to the next idle
+    //!             worker. The pages of a chunk are prefetched (WILLNEED)
+    //!             before the chunk function is called
+    //!
+    void parallel(const std::size_t workers,
+                  const std::size_t chunkFrames,
+                  ChunkFunction function,
+                  void* context) const;
+
+    //!
+    //! \brief Decodes every frame of the capture across worker threads
+    //!
+    //! \param workers  The number of worker threads (caller included)
+    //! \param function The frame function, called concurrently as
+    //!                 function(worker, index, timestamp, view)
+    //!
+    //! \note   Per-worker state (i.e. Statistics partials) shall be indexed
+    //!         by the worker argument and merged after the call
+    //!
+    template <typename Function>
+    void decode(const std::size_t workers, Function& function) const
+    {
+        DecodeContext<Function> context = { this, &function };
+
+        parallel(workers, 0UL, &decodeChunk<Function>, &context);
+    }
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Context of decode()
+    //!
+    template <typename Function>
+    struct DecodeContext
+    {
+        //!
+        //! \brief The capture
+        //!
+        const CaptureReader* reader;
+
+        //!
+        //! \brief The frame function
+        //!
+        Function* function;
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Start of the mapped file
+    //!
+    uint8_t* mMap;
+
+    //!
+    //! \brief Byte size of the mapping
+    //!
+    std::size_t mLength;
+
+    //!
+    //! \brief First byte of the first record
+    //!
+    const uint8_t* mRecords;
+
+    //!
+    //! \brief First byte of the first frame
+    //!
+    const uint8_t* mFrames;
+
+    //!
+    //! \brief Number of frames
+    //!
+    std::size_t mCount;
+
+    //!
+    //! \brief Byte size of a frame
+    //!
+    std::size_t mFrameSize;
+
+    //!
+    //! \brief Byte size of a record
+    //!
+    std::size_t mStride;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    CaptureReader(const CaptureReader&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    CaptureReader& operator=(const CaptureReader&);
+
+    //!
+    //! \brief Chunk function of decode()
+    //!
+    template <typename Function>
+    static void decodeChunk(void* context,
+                            const std::size_t worker,
+                            const std::size_t first,
+                            const std::size_t last)
+    {
+        DecodeContext<Function>* decode =
+                static_cast<DecodeContext<Function>*>(context);
+
+        for (std::size_t i = first; i < last; i++)
+        {
+            BufferView view = decode->reader->frame(i);
+
+            (*decode->function)(worker, i, decode->reader->timestamp(i), view);
+        }
+    }
+};
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef BIT_CHANGE_H
+#define BIT_CHANGE_H
+
+//!
+//! \file bit_change.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Changed signal detection between consecutive frames
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Every received frame is XORed against the previous one in
+//!             64-bit words. Only the signals indexed under a word with
+//!             changed bits are checked, and only the signals whose own bits
+//!             changed are reported (up to 64 signals per detector)
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+#include "bit_field.h"
+
+#include <cstring>
+
+namespace bit
+{
+template <std::size_t Size>
+class ChangeDetector
+{
+    static_assert((Size * U08_BIT_COUNT) <= 0xFFFFUL, "Frame too large to index");
+
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the change detector
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow
+    };
+
+    //!
+    //! \brief Maximum number of signals of a detector
+    //!
+    static const std::size_t MAX_SIGNALS = U64_BIT_COUNT;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a detector without signals
+    //!
+    ChangeDetector()
+        : mCount(0UL)
+        , mIsPrimed(false)
+        , mStatus(Ok)
+    {
+        (void) std::memset(mPrevious, 0, sizeof(mPrevious));
+        (void) std::memset(mIndex, 0, sizeof(mIndex));
+    }
+
+    //!
+    //! \brief Destroys a change detector object
+    //!
+    ~ChangeDetector()
+    {
+    }
+
+    //!
+    //! \brief Returns the status of the detector
+    //!
+    //! \return Status  (Ok | Overflow)
+    //!
+    Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Returns the number of signals
+    //!
+    //! \return std::size_t The signal count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Adds a signal to the bit range index
+    //!
+    //! \return std::size_t The signal index, the bit of the change masks.
+    //!                     MAX_SIGNALS (and Overflow status) if full
+    //!
+    template <typename SignalType>
+    std::size_t add()
+    {
+        typedef Field<SignalType> Layout;
+
+        static_assert(Layout::END <= Size, "Signal out of the buffer");
+
+        std::size_t result = MAX_SIGNALS;
+
+        if (mCount < MAX_SIGNALS)
+        {
+            result = mCount;
+
+            mOffset[result] = Layout::OFFSET;
+            mWidth[result] = Layout::WIDTH;
+
+            const std::size_t first = Layout::OFFSET / U64_BIT_COUNT;
+            const std::size_t last = (Layout::OFFSET + Layout::WIDTH - 1UL) /
+                                     U64_BIT_COUNT;
+
+            for (std::size_t i = first; i <= last; i++)
+            {
+                mIndex[i] |= 1ULL << result;
+            }
+
+            mCount++;
+        }
+        else
+        {
+            mStatus = Overflow;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Compares a frame with the previous one and keeps it
+    //!
+    //! \param data The frame bytes (Size bytes)
+    //!
+    //! \return uint64_t    The changed signals (bit i set for signal i), every
+    //!                     signal for the first frame
+    //!
+    uint64_t update(const uint8_t* data)
+    {
+        uint64_t current[WORD_COUNT];
+        uint64_t diff[WORD_COUNT];
+
+        current[WORD_COUNT - 1UL] = 0ULL;
+
+        (void) std::memcpy(current, data, Size);
+
+        uint64_t candidates = 0ULL;
+
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            diff[i] = current[i] ^ mPrevious[i];
+
+            if (diff[i] != 0ULL)
+            {
+                candidates |= mIndex[i];
+            }
+
+            mPrevious[i] = current[i];
+        }
+
+        uint64_t result = candidates;
+
+        if (mIsPrimed)
+        {
+            const uint8_t* changed = reinterpret_cast<const uint8_t*>(diff);
+
+            // A shared word may have changed outside the bits of the signal
+            while (candidates != 0ULL)
+            {
+                const std::size_t signal = trailingZeros(candidates);
+
+                if (extractField(changed, Size, mOffset[signal], mWidth[signal]) ==
+                    0ULL)
+                {
+                    result &= ~(1ULL << signal);
+                }
+
+                candidates &= candidates - 1ULL;
+            }
+        }
+        else
+        {
+            result = all();
+
+            mIsPrimed = true;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Compares a bit buffer with the previous one and keeps it
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return uint64_t    The changed signals (bit i set for signal i)
+    //!
+    uint64_t update(const Buffer<Size>& frame)
+    {
+        return update(frame.data());
+    }
+
+    //!
+    //! \brief Compares a frame with the previous one and hands the changed
+    //!        signals to a handler
+    //!
+    //! \param data     The frame bytes (Size bytes)
+    //! \param handler  Called as handler(signal, view) for every changed
+    //!                 signal, in index order. view.read<SignalType>()
+    //!                 decodes it
+    //!
+    //! \return uint64_t    The changed signals (bit i set for signal i)
+    //!
+    template <typename Handler>
+    uint64_t decode(const uint8_t* data, Handler& handler)
+    {
+        const uint64_t result = update(data);
+
+        BufferView view(data, Size);
+
+        for (uint64_t pending = result; pending != 0ULL; pending &= pending - 1ULL)
+        {
+            handler(trailingZeros(pending), view);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Compares a bit buffer with the previous one and hands the
+    //!        changed signals to a handler
+    //!
+    //! \param frame    The frame
+    //! \param handler  Called as handler(signal, view) for every changed signal
+    //!
+    //! \return uint64_t    The changed signals (bit i set for signal i)
+    //!
+    template <typename Handler>
+    uint64_t decode(const Buffer<Size>& frame, Handler& handler)
+    {
+        return decode(frame.data(), handler);
+    }
+
+    //!
+    //! \brief Forgets the previous frame, the next one reports every signal
+    //!
+    void reset()
+    {
+        (void) std::memset(mPrevious, 0, sizeof(mPrevious));
+
+        mIsPrimed = false;
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Number of 64-bit words holding a frame
+    //!
+    static const std::size_t WORD_COUNT = (Size + sizeof(uint64_t) - 1UL) /
+                                          sizeof(uint64_t);
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Previous frame
+    //!
+    uint64_t mPrevious[WORD_COUNT];
+
+    //!
+    //! \brief Signals overlapping every word of the frame
+    //!
+    uint64_t mIndex[WORD_COUNT];
+
+    //!
+    //! \brief Field offset of every signal
+    //!
+    uint16_t mOffset[MAX_SIGNALS];
+
+    //!
+    //! \brief Field width of every signal
+    //!
+    uint8_t mWidth[MAX_SIGNALS];
+
+    //!
+    //! \brief Number of signals
+    //!
+    std::size_t mCount;
+
+    //!
+    //! \brief Set once a first frame was received
+    //!
+    bool mIsPrimed;
+
+    //!
+    //! \brief Returns the current status of the detector
+    //!
+    Status mStatus;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Returns the mask of every signal
+    //!
+    //! \return uint64_t    Bits 0 - count()-1 set
+    //!
+    uint64_t all() const
+    {
+        return (mCount < MAX_SIGNALS) ? ((1ULL << mCount) - 1ULL) : ~0ULL;
+    }
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <std::size_t Size>
+const std::size_t ChangeDetector<Size>::MAX_SIGNALS;
+
+template <std::size_t Size>
+const std::size_t ChangeDetector<Size>::WORD_COUNT;
+}
+
+#endif
@@ -0,0 +1,391 @@
+#ifndef BIT_COUNTERS_H
+#define BIT_COUNTERS_H
+
+//!
+//! \file bit_counters.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Per-thread hot path counters and cycle timing
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The library hot paths are instrumented with the BIT_COUNT*
+//!             and BIT_TIME macros. They expand to nothing unless
+//!             BIT_INSTRUMENTATION is defined (CMake BITS_INSTRUMENTATION=ON)
+//!
+//! \note       Every thread updates its own cache-line aligned block without
+//!             locked instructions. snapshot() sums the blocks of every
+//!             thread, threadSnapshot() returns a single one. The block of an
+//!             exiting thread is handed to the next new thread with its
+//!             counts, live threads beyond COUNTER_MAX_THREADS - 1 share the
+//!             last block
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_signal_data.h"
+
+#include <atomic>
+#include <chrono>
+
+//----------------------------- Public macros ----------------------------------
+
+#if defined(BIT_INSTRUMENTATION)
+
+#define BIT_COUNT(counter, count) bit::Counters::add((counter), (count))
+#define BIT_COUNT_ACCESS(offset) bit::Counters::access(offset)
+#define BIT_COUNT_SIGNAL(signal) bit::Counters::access(bit::signalOffset(signal))
+#define BIT_COUNT_OVERFLOW(source, index) bit::Counters::overflow((source), (index))
+#define BIT_TIME(counter) const bit::CycleScope bitCycleScope(counter)
+
+#else
+
+#define BIT_COUNT(counter, count) ((void) 0)
+#define BIT_COUNT_ACCESS(offset) ((void) 0)
+#define BIT_COUNT_SIGNAL(signal) ((void) 0)
+#define BIT_COUNT_OVERFLOW(source, index) ((void) 0)
+#define BIT_TIME(counter) ((void) 0)
+
+#endif
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Hot path counters
+//!
+enum Counter
+{
+    FramesEncoded = 0,
+    FramesDecoded,
+    Overflows,
+    SignalReads,
+    SignalWrites,
+    EncodeCycles,
+    DecodeCycles,
+    COUNTER_COUNT
+};
+
+//!
+//! \brief Number of per-signal access counters (field offsets, wrapped)
+//!
+const std::size_t COUNTER_SIGNAL_SLOTS = 1024UL;
+
+//!
+//! \brief Number of counter blocks (threads)
+//!
+const std::size_t COUNTER_MAX_THREADS = 32UL;
+
+static_assert(COUNTER_MAX_THREADS <= 64UL, "Free blocks are tracked in 64 bits");
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Counter values at a point in time
+//!
+struct CounterSnapshot
+{
+    //!
+    //! \brief Values of every Counter
+    //!
+    uint64_t values[COUNTER_COUNT];
+
+    //!
+    //! \brief Accesses of the signal at every field offset
+    //!
+    uint64_t signals[COUNTER_SIGNAL_SLOTS];
+};
+
+//!
+//! \brief Called on every out of bounds buffer access
+//!
+//! \param context  The user context
+//! \param source   The Buffer or BufferView accessed
+//! \param index    The byte index requested
+//!
+typedef void (*OverflowHook)(void* context, const void* source, const std::size_t index);
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the field offset of a signal (see Field::OFFSET)
+//!
+//! \param signal   The signal
+//!
+//! \return std::size_t The field offset
+//!
+inline std::size_t signalOffset(const SignalData& signal)
+{
+    // Bit position of the MSB in its byte, writeLShift() = (BitPos + 1) % 8
+    const std::size_t bit = (signal.writeLShift() + (U08_BIT_COUNT - 1UL)) % U08_BIT_COUNT;
+
+    return (signal.position() * U08_BIT_COUNT) + ((U08_BIT_COUNT - 1UL) - bit);
+}
+
+class Counters
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Adds to a counter of the calling thread
+    //!
+    //! \param counter  The counter
+    //! \param count    The amount to add
+    //!
+    static void add(const Counter counter, const uint64_t count)
+    {
+        Block& block = local();
+
+        bump(block, block.values[counter], count);
+    }
+
+    //!
+    //! \brief Counts an access to the signal at a field offset
+    //!
+    //! \param offset   The field offset (wrapped to COUNTER_SIGNAL_SLOTS)
+    //!
+    static void access(const std::size_t offset)
+    {
+        Block& block = local();
+
+        bump(block, block.signals[offset % COUNTER_SIGNAL_SLOTS], 1ULL);
+    }
+
+    //!
+    //! \brief Counts an out of bounds access and calls the overflow hook
+    //!
+    //! \param source   The Buffer or BufferView accessed
+    //! \param index    The byte index requested
+    //!
+    static void overflow(const void* source, const std::size_t index);
+
+    //!
+    //! \brief Installs the overflow hook
+    //!
+    //! \param hook     The hook, 0 to remove it
+    //! \param context  The user context of the hook
+    //!
+    static void setOverflowHook(OverflowHook hook, void* context);
+
+    //!
+    //! \brief Returns the number of blocks handed out to threads
+    //!
+    //! \return std::size_t The number of blocks in use
+    //!
+    static std::size_t threads();
+
+    //!
+    //! \brief Returns the sum of the counters of every thread
+    //!
+    //! \param snapshot The counter values
+    //!
+    static void snapshot(CounterSnapshot& snapshot);
+
+    //!
+    //! \brief Returns the counters of one block
+    //!
+    //! \param thread   The block index (0 - threads()-1)
+    //! \param snapshot The counter values
+    //!
+    static void threadSnapshot(const std::size_t thread, CounterSnapshot& snapshot);
+
+    //!
+    //! \brief Zeroes the counters of every thread
+    //!
+    static void reset();
+
+    //!
+    //! \brief Returns the time stamp counter (nanoseconds without TSC)
+    //!
+    //! \return uint64_t    The current cycle count
+    //!
+    static uint64_t cycles()
+    {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+        return __builtin_ia32_rdtsc();
+
+#else
+
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+
+#endif
+    }
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Counters of a thread
+    //!
+    struct alignas(CACHE_LINE_SIZE) Block
+    {
+        //!
+        //! \brief Values of every Counter
+        //!
+        std::atomic<uint64_t> values[COUNTER_COUNT];
+
+        //!
+        //! \brief Accesses of the signal at every field offset
+        //!
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> signals[COUNTER_SIGNAL_SLOTS];
+    };
+
+    //!
+    //! \brief Returns the block of its thread to the free blocks on exit
+    //!
+    struct Release
+    {
+        //!
+        //! \brief Frees the block of the exiting thread
+        //!
+        ~Release();
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Counter blocks
+    //!
+    static Block sBlocks[COUNTER_MAX_THREADS];
+
+    //!
+    //! \brief Number of blocks handed out
+    //!
+    static std::atomic<std::size_t> sThreads;
+
+    //!
+    //! \brief Blocks of exited threads (bit i set if sBlocks[i] is free)
+    //!
+    static std::atomic<uint64_t> sFree;
+
+    //!
+    //! \brief Overflow hook
+    //!
+    static std::atomic<OverflowHook> sHook;
+
+    //!
+    //! \brief Context of the overflow hook
+    //!
+    static std::atomic<void*> sContext;
+
+    //!
+    //! \brief Block of the calling thread, 0 until its first update
+    //!
+    static thread_local Block* tBlock;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Hands out the block of the calling thread
+    //!
+    static Block& attach();
+
+    //!
+    //! \brief Returns the block of the calling thread
+    //!
+    static Block& local()
+    {
+        Block* block = tBlock;
+
+        return (block != 0) ? *block : attach();
+    }
+
+    //!
+    //! \brief Returns true for the last block, shared by the extra threads
+    //!
+    static bool isShared(const Block& block)
+    {
+        return (&block == &sBlocks[COUNTER_MAX_THREADS - 1UL]);
+    }
+
+    //!
+    //! \brief Adds to a counter, a plain load and store unless shared
+    //!
+    static void bump(Block& block, std::atomic<uint64_t>& value, const uint64_t count)
+    {
+        if (isShared(block))
+        {
+            (void) value.fetch_add(count, std::memory_order_relaxed);
+        }
+        else
+        {
+            value.store(value.load(std::memory_order_relaxed) + count,
+                        std::memory_order_relaxed);
+        }
+    }
+};
+
+//!
+//! \brief Adds the cycles elapsed in a scope to a counter
+//!
+class CycleScope
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Starts timing
+    //!
+    //! \param counter  The counter receiving the elapsed cycles
+    //!
+    explicit CycleScope(const Counter counter)
+        : mCounter(counter)
+        , mStart(Counters::cycles())
+    {
+    }
+
+    //!
+    //! \brief Adds the elapsed cycles
+    //!
+    ~CycleScope()
+    {
+        Counters::add(mCounter, Counters::cycles() - mStart);
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Counter receiving the elapsed cycles
+    //!
+    const Counter mCounter;
+
+    //!
+    //! \brief Cycle count at construction
+    //!
+    const uint64_t mStart;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    CycleScope(const CycleScope&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    CycleScope& operator=(const CycleScope&);
+};
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef BIT_DESCRIPTOR_H
+#define BIT_DESCRIPTOR_H
+
+//!
+//! \file bit_descriptor.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Compact signal descriptors and their shared decode kernels
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A Descriptor is a 4-byte POD holding the layout of a signal,
+//!             so very large signal sets stay cache resident. Every
+//!             descriptor is handled by the same non-template kernels, the
+//!             code size does not grow with the number of signals
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_field.h"
+#include "bit_schema.h"
+
+#include <type_traits>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Descriptor flags holding the ValueType
+//!
+const uint8_t DESCRIPTOR_TYPE_MASK = 0x07U;
+
+//!
+//! \brief Descriptor flag of the Intel byte order
+//!
+const uint8_t DESCRIPTOR_INTEL = 0x80U;
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Compact layout of a signal
+//!
+struct Descriptor
+{
+    //!
+    //! \brief Field offset (Motorola) or bit of the LSB (Intel)
+    //!
+    uint16_t offset;
+
+    //!
+    //! \brief Field width (1-64)
+    //!
+    uint8_t width;
+
+    //!
+    //! \brief ValueType and DESCRIPTOR_INTEL
+    //!
+    uint8_t flags;
+};
+
+static_assert(sizeof(Descriptor) <= 8UL, "Descriptor larger than 8 bytes");
+
+//!
+//! \brief ValueType of a signal value type
+//!
+template <typename T>
+struct ValueTypeOf
+{
+    //!
+    //! \brief Returns the ValueType
+    //!
+    //! \return ValueType   The run time value type
+    //!
+    static ValueType type()
+    {
+        return std::is_same<T, bool>::value ? Boolean :
+               std::is_floating_point<T>::value ?
+               ((sizeof(T) == sizeof(uint32_t)) ? Float32 : Float64) :
+               std::is_signed<T>::value ? Signed : Unsigned;
+    }
+};
+
+//!
+//! \brief ValueType of a half precision signal
+//!
+template <>
+struct ValueTypeOf<Half>
+{
+    //!
+    //! \brief Returns the ValueType
+    //!
+    //! \return ValueType   The run time value type
+    //!
+    static ValueType type()
+    {
+        return Float16;
+    }
+};
+
+//!
+//! \brief ValueType of a bfloat16 signal
+//!
+template <>
+struct ValueTypeOf<BrainFloat>
+{
+    //!
+    //! \brief Returns the ValueType
+    //!
+    //! \return ValueType   The run time value type
+    //!
+    static ValueType type()
+    {
+        return BFloat16;
+    }
+};
+
+//!
+//! \brief ValueType of a fixed-point signal, the raw value type (the scale
+//!        is not part of a descriptor)
+//!
+template <typename Raw, std::size_t FracBits>
+struct ValueTypeOf<Fixed<Raw, FracBits> >
+{
+    //!
+    //! \brief Returns the ValueType
+    //!
+    //! \return ValueType   The run time value type
+    //!
+    static ValueType type()
+    {
+        return ValueTypeOf<Raw>::type();
+    }
+};
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the descriptor of a compile-time signal
+//!
+//! \return Descriptor  The signal layout
+//!
+template <typename SignalType>
+inline Descriptor describe()
+{
+    typedef Field<SignalType> Layout;
+
+    typedef typename Layout::Type Type;
+
+    static_assert(Layout::OFFSET <= 0xFFFFUL, "Signal beyond the descriptor range");
+
+    const ValueType type = ValueTypeOf<Type>::type();
+
+    const Descriptor result = {static_cast<uint16_t>(Layout::OFFSET),
+                               static_cast<uint8_t>(Layout::WIDTH),
+                               static_cast<uint8_t>(type)};
+
+    return result;
+}
+
+//!
+//! \brief Builds the descriptor of a run time signal
+//!
+//! \param signal       The signal layout
+//! \param descriptor   The compact layout
+//!
+//! \return bool    False if the signal is beyond the descriptor range
+//!
+bool describe(const SchemaSignal& signal, Descriptor& descriptor);
+
+//!
+//! \brief Extracts the field bits of a signal
+//!
+//! \param descriptor   The signal layout
+//! \param data         The frame bytes
+//! \param size         The byte size of the frame
+//!
+//! \return uint64_t    The field bits, signed fields sign extended. Bytes
+//!                     beyond the frame are extracted as zero
+//!
+uint64_t readRaw(const Descriptor& descriptor, const uint8_t* data, const std::size_t size);
+
+//!
+//! \brief Inserts the field bits of a signal, replacing the previous ones
+//!
+//! \param descriptor   The signal layout
+//! \param data         The frame bytes
+//! \param size         The byte size of the frame
+//! \param raw          The field bits (upper bits are ignored)
+//!
+void writeRaw(const Descriptor& descriptor,
+              uint8_t* data,
+              const std::size_t size,
+              const uint64_t raw);
+
+//!
+//! \brief Extracts the value of a signal
+//!
+//! \param descriptor   The signal layout
+//! \param data         The frame bytes
+//! \param size         The byte size of the frame
+//!
+//! \return double  The signal value
+//!
+double readValue(const Descriptor& descriptor, const uint8_t* data, const std::size_t size);
+
+//!
+//! \brief Extracts the field bits of a set of signals
+//!
+//! \param descriptors  The signal layouts
+//! \param count        The number of signals
+//! \param data         The frame bytes
+//! \param size         The byte size of the frame
+//! \param raw          The field bits of every signal (count values)
+//!
+void readAll(const Descriptor* descriptors,
+             const std::size_t count,
+             const uint8_t* data,
+             const std::size_t size,
+             uint64_t* raw);
+}
+
+#endif
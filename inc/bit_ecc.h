@@ -0,0 +1,237 @@
+#ifndef BIT_ECC_H
+#define BIT_ECC_H
+
+//!
+//! \file bit_ecc.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    SECDED Hamming(72,64) and Hamming(39,32) error-correcting codes
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Data bit j takes the j-th Hamming position that is not a power
+//!             of 2 (3, 5, 6, 7, 9...). Check bit i is the parity of the data
+//!             bits whose position has bit i set, so every check bit is one
+//!             parity64(data & MASK) instead of one parity() per bit. The top
+//!             check bit (7 for 64-bit words, 6 for 32-bit words) makes the
+//!             parity of the whole codeword even
+//!
+//! \note       The batch methods compute four check bytes per AVX2 step when
+//!             the CPU supports it, and correct only the words with a non
+//!             zero syndrome
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_base.h"
+
+#include <cstddef>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Number of check bits of a 64-bit word, Hamming(72,64)
+//!
+const std::size_t SECDED64_CHECK_BITS = 8UL;
+
+//!
+//! \brief Number of check bits of a 32-bit word, Hamming(39,32)
+//!
+const std::size_t SECDED32_CHECK_BITS = 7UL;
+
+class Secded
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of a checked word
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Corrected,
+        Uncorrectable
+    };
+
+    //!
+    //! \brief Data bits covered by every check bit of a 64-bit word
+    //!
+    static const uint64_t MASKS64[SECDED64_CHECK_BITS];
+
+    //!
+    //! \brief Data bits covered by every check bit of a 32-bit word
+    //!
+    static const uint32_t MASKS32[SECDED32_CHECK_BITS];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Returns the check bits of a 64-bit word
+    //!
+    //! \param data The data word
+    //!
+    //! \return uint8_t The 8 check bits
+    //!
+    static uint8_t encode(const uint64_t data)
+    {
+        uint8_t result = 0U;
+
+        for (std::size_t i = 0UL; i < SECDED64_CHECK_BITS; i++)
+        {
+            result |= static_cast<uint8_t>(parity64(data & MASKS64[i], Even) << i);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the check bits of a 32-bit word
+    //!
+    //! \param data The data word
+    //!
+    //! \return uint8_t The 7 check bits
+    //!
+    static uint8_t encode(const uint32_t data)
+    {
+        uint8_t result = 0U;
+
+        for (std::size_t i = 0UL; i < SECDED32_CHECK_BITS; i++)
+        {
+            result |= static_cast<uint8_t>(parity64(data & MASKS32[i], Even) << i);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the syndrome of a 64-bit codeword
+    //!
+    //! \param data     The data word
+    //! \param check    The check bits
+    //!
+    //! \return uint8_t The Hamming syndrome (bits 0-6), bit 7 set if the
+    //!                 codeword parity fails. 0 if no error
+    //!
+    static uint8_t syndrome(const uint64_t data, const uint8_t check)
+    {
+        return fold(encode(data) ^ check, SECDED64_CHECK_BITS);
+    }
+
+    //!
+    //! \brief Returns the syndrome of a 32-bit codeword
+    //!
+    //! \param data     The data word
+    //! \param check    The check bits
+    //!
+    //! \return uint8_t The Hamming syndrome (bits 0-5), bit 6 set if the
+    //!                 codeword parity fails. 0 if no error
+    //!
+    static uint8_t syndrome(const uint32_t data, const uint8_t check)
+    {
+        return fold(encode(data) ^ (check & 0x7FU), SECDED32_CHECK_BITS);
+    }
+
+    //!
+    //! \brief Checks a 64-bit codeword, correcting a single bit error
+    //!
+    //! \param data     The data word
+    //! \param check    The check bits
+    //!
+    //! \return Status  Ok, Corrected (one bit flipped back) or Uncorrectable
+    //!                 (two bit error detected, data and check unchanged)
+    //!
+    static Status correct(uint64_t& data, uint8_t& check);
+
+    //!
+    //! \brief Checks a 32-bit codeword, correcting a single bit error
+    //!
+    //! \param data     The data word
+    //! \param check    The check bits
+    //!
+    //! \return Status  Ok, Corrected (one bit flipped back) or Uncorrectable
+    //!                 (two bit error detected, data and check unchanged)
+    //!
+    static Status correct(uint32_t& data, uint8_t& check);
+
+    //!
+    //! \brief Returns the check bits of every word of a buffer
+    //!
+    //! \param data     The data words
+    //! \param check    The check bits (count bytes)
+    //! \param count    The number of words
+    //!
+    static void encode(const uint64_t* data, uint8_t* check, const std::size_t count);
+
+    //!
+    //! \brief Returns the check bits of every word of a buffer
+    //!
+    //! \param data     The data words
+    //! \param check    The check bits (count bytes)
+    //! \param count    The number of words
+    //!
+    static void encode(const uint32_t* data, uint8_t* check, const std::size_t count);
+
+    //!
+    //! \brief Checks every codeword of a buffer, correcting single bit errors
+    //!
+    //! \param data     The data words
+    //! \param check    The check bits (count bytes)
+    //! \param count    The number of words
+    //!
+    //! \return Status  The worst status of the words
+    //!
+    static Status correct(uint64_t* data, uint8_t* check, const std::size_t count);
+
+    //!
+    //! \brief Checks every codeword of a buffer, correcting single bit errors
+    //!
+    //! \param data     The data words
+    //! \param check    The check bits (count bytes)
+    //! \param count    The number of words
+    //!
+    //! \return Status  The worst status of the words
+    //!
+    static Status correct(uint32_t* data, uint8_t* check, const std::size_t count);
+
+private:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Turns the difference of the check bits into a syndrome
+    //!
+    //! \details    A data bit error flips the check bits of its position and
+    //!             the top bit by the parity of that position, so the top bit
+    //!             is corrected to the parity of the whole received codeword
+    //!
+    //! \param difference   The computed check bits xor the received ones
+    //! \param bits         The number of check bits
+    //!
+    static uint8_t fold(const uint32_t difference, const std::size_t bits)
+    {
+        const uint32_t top = 1UL << (bits - 1UL);
+
+        const uint32_t hamming = difference & (top - 1UL);
+
+        return static_cast<uint8_t>(
+                hamming | ((difference ^ (parity64(hamming, Even) << (bits - 1UL))) & top));
+    }
+};
+}
+
+#endif
@@ -0,0 +1,654 @@
+#ifndef BIT_FIELD_H
+#define BIT_FIELD_H
+
+//!
+//! \file bit_field.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Word level access to the bit fields of a buffer
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A field is addressed by its offset, the number of bits between
+//!             the most significant bit of the first buffer byte and the most
+//!             significant bit of the field, and by its width. This is the
+//!             layout produced by Buffer::operator<< for a Signal
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_counters.h"
+#include "bit_schema.h"
+#include "bit_signal.h"
+
+#include <cstring>
+
+namespace bit
+{
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the field offset of a signal bit position
+//!
+//! \param bitPos   The bit position of the signal (Signal BitPos)
+//!
+//! \return std::size_t The field offset
+//!
+inline std::size_t fieldOffset(const std::size_t bitPos)
+{
+    return ((bitPos / U08_BIT_COUNT) * U08_BIT_COUNT) +
+           ((U08_BIT_COUNT - 1UL) - (bitPos % U08_BIT_COUNT));
+}
+
+//!
+//! \brief Loads 8 bytes as a 64-bit word, the first byte most significant
+//!
+//! \param data The first byte
+//!
+//! \return uint64_t The loaded word
+//!
+inline uint64_t loadU64(const uint8_t* data)
+{
+    uint64_t result;
+
+    (void) std::memcpy(&result, data, sizeof(result));
+
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+    result = __builtin_bswap64(result);
+
+#endif
+
+    return result;
+}
+
+//!
+//! \brief Stores a 64-bit word as 8 bytes, the most significant first
+//!
+//! \param data The first byte
+//! \param word The word to store
+//!
+inline void storeU64(uint8_t* data, const uint64_t word)
+{
+    uint64_t result = word;
+
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+    result = __builtin_bswap64(result);
+
+#endif
+
+    (void) std::memcpy(data, &result, sizeof(result));
+}
+
+//!
+//! \brief Extracts a field from a buffer
+//!
+//! \param data     The buffer bytes
+//! \param size     The byte size of the buffer
+//! \param offset   The field offset
+//! \param width    The field width (1-64 bits)
+//!
+//! \return uint64_t The field bits, right aligned
+//!
+//! \note   Bytes beyond the size of the buffer are never read and are
+//!         extracted as zero
+//!
+inline uint64_t extractField(const uint8_t* data,
+                             const std::size_t size,
+                             const std::size_t offset,
+                             const std::size_t width)
+{
+    const std::size_t byte = offset / U08_BIT_COUNT;
+    const std::size_t shift = offset % U08_BIT_COUNT;
+
+    uint64_t result;
+
+    if (((byte + sizeof(uint64_t)) <= size) && ((shift + width) <= U64_BIT_COUNT))
+    {
+        result = (loadU64(&data[byte]) << shift) >> (U64_BIT_COUNT - width);
+    }
+    else
+    {
+        uint64_t word = 0ULL;
+
+        for (std::size_t i = 0UL; i < sizeof(uint64_t); i++)
+        {
+            word <<= U08_BIT_COUNT;
+
+            if ((byte + i) < size)
+            {
+                word |= data[byte + i];
+            }
+        }
+
+        word <<= shift;
+
+        if ((shift != 0UL) && ((byte + sizeof(uint64_t)) < size))
+        {
+            word |= static_cast<uint64_t>(data[byte + sizeof(uint64_t)]) >>
+                    (U08_BIT_COUNT - shift);
+        }
+
+        result = word >> (U64_BIT_COUNT - width);
+    }
+
+    return result;
+}
+
+//!
+//! \brief Inserts a field into a buffer, replacing its previous bits
+//!
+//! \param data     The buffer bytes
+//! \param size     The byte size of the buffer
+//! \param offset   The field offset
+//! \param width    The field width (1-64 bits)
+//! \param raw      The field bits, right aligned (upper bits are ignored)
+//!
+//! \note   Bits beyond the size of the buffer are never written
+//!
+inline void insertField(uint8_t* data,
+                        const std::size_t size,
+                        const std::size_t offset,
+                        const std::size_t width,
+                        const uint64_t raw)
+{
+    const std::size_t byte = offset / U08_BIT_COUNT;
+    const std::size_t shift = offset % U08_BIT_COUNT;
+
+    if (((byte + sizeof(uint64_t)) <= size) && ((shift + width) <= U64_BIT_COUNT))
+    {
+        const std::size_t left = U64_BIT_COUNT - shift - width;
+
+        const uint64_t mask = (~0ULL >> (U64_BIT_COUNT - width)) << left;
+
+        const uint64_t word = loadU64(&data[byte]);
+
+        storeU64(&data[byte], (word & ~mask) | ((raw << left) & mask));
+    }
+    else
+    {
+        const std::size_t end = offset + width;
+
+        for (std::size_t i = byte;
+             (i < size) && ((i * U08_BIT_COUNT) < end);
+             i++)
+        {
+            const std::size_t first = i * U08_BIT_COUNT;
+
+            const std::size_t lo = (offset > first) ? offset : first;
+            const std::size_t hi = (end < (first + U08_BIT_COUNT)) ?
+                                   end : (first + U08_BIT_COUNT);
+
+            const std::size_t count = hi - lo;
+            const std::size_t left = (first + U08_BIT_COUNT) - hi;
+
+            const uint32_t bits = static_cast<uint32_t>(
+                    (raw >> (end - hi)) & ((1ULL << count) - 1ULL));
+
+            const uint32_t mask = ((1UL << count) - 1UL) << left;
+
+            data[i] = static_cast<uint8_t>((data[i] & ~mask) | (bits << left));
+        }
+    }
+}
+
+//!
+//! \brief Extracts an Intel (little endian) field from a buffer
+//!
+//! \param data     The buffer bytes
+//! \param size     The byte size of the buffer
+//! \param position The bit position of the field LSB, counted from the least
+//!                 significant bit of the first buffer byte
+//! \param width    The field width (1-64 bits)
+//!
+//! \return uint64_t The field bits, right aligned
+//!
+//! \note   Bytes beyond the size of the buffer are never read and are
+//!         extracted as zero
+//!
+inline uint64_t extractIntelField(const uint8_t* data,
+                                  const std::size_t size,
+                                  const std::size_t position,
+                                  const std::size_t width)
+{
+    const std::size_t byte = position / U08_BIT_COUNT;
+    const std::size_t shift = position % U08_BIT_COUNT;
+
+    uint64_t result = 0ULL;
+
+    if (((byte + sizeof(uint64_t)) <= size) && ((shift + width) <= U64_BIT_COUNT))
+    {
+        (void) std::memcpy(&result, &data[byte], sizeof(result));
+
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+
+        result = __builtin_bswap64(result);
+
+#endif
+
+        result >>= shift;
+    }
+    else
+    {
+        for (std::size_t i = 0UL; (i < sizeof(uint64_t)) && ((byte + i) < size); i++)
+        {
+            result |= static_cast<uint64_t>(data[byte + i]) << (i * U08_BIT_COUNT);
+        }
+
+        result >>= shift;
+
+        if ((shift != 0UL) && ((byte + sizeof(uint64_t)) < size))
+        {
+            result |= static_cast<uint64_t>(data[byte + sizeof(uint64_t)]) <<
+                      (U64_BIT_COUNT - shift);
+        }
+    }
+
+    return result & (~0ULL >> (U64_BIT_COUNT - width));
+}
+
+//!
+//! \brief Inserts an Intel (little endian) field into a buffer, replacing its
+//!        previous bits
+//!
+//! \param data     The buffer bytes
+//! \param size     The byte size of the buffer
+//! \param position The bit position of the field LSB, counted from the least
+//!                 significant bit of the first buffer byte
+//! \param width    The field width (1-64 bits)
+//! \param raw      The field bits, right aligned (upper bits are ignored)
+//!
+//! \note   Bits beyond the size of the buffer are never written
+//!
+inline void insertIntelField(uint8_t* data,
+                             const std::size_t size,
+                             const std::size_t position,
+                             const std::size_t width,
+                             const uint64_t raw)
+{
+    const std::size_t end = position + width;
+
+    for (std::size_t i = position / U08_BIT_COUNT;
+         (i < size) && ((i * U08_BIT_COUNT) < end);
+         i++)
+    {
+        const std::size_t first = i * U08_BIT_COUNT;
+
+        const std::size_t lo = (position > first) ? position : first;
+        const std::size_t hi = (end < (first + U08_BIT_COUNT)) ?
+                               end : (first + U08_BIT_COUNT);
+
+        const std::size_t count = hi - lo;
+
+        const uint32_t bits = static_cast<uint32_t>(
+                (raw >> (lo - position)) & ((1ULL << count) - 1ULL));
+
+        const uint32_t mask = ((1UL << count) - 1UL) << (lo - first);
+
+        data[i] = static_cast<uint8_t>((data[i] & ~mask) | (bits << (lo - first)));
+    }
+}
+
+//!
+//! \brief Converts the field bits to a boolean flag
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The bool flag
+//!
+inline void fieldValue(const uint64_t raw, const std::size_t width, bool& value)
+{
+    (void) width;
+
+    value = (raw != 0ULL);
+}
+
+//!
+//! \brief Converts the field bits to an unsigned fixed-width integer
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The unsigned integer
+//!
+template <typename T>
+inline typename std::enable_if<std::is_unsigned<T>::value>::type
+fieldValue(const uint64_t raw, const std::size_t width, T& value)
+{
+    (void) width;
+
+    value = static_cast<T>(raw);
+}
+
+//!
+//! \brief Converts the field bits to a signed fixed-width integer
+//!
+//! \param raw      The field bits
+//! \param width    The field width, the most significant bit is the sign
+//! \param value    The signed integer
+//!
+template <typename T>
+inline typename std::enable_if<std::is_signed<T>::value &&
+                               std::is_integral<T>::value>::type
+fieldValue(const uint64_t raw, const std::size_t width, T& value)
+{
+    uint64_t data = raw;
+
+    if ((width < U64_BIT_COUNT) && (((raw >> (width - 1UL)) & 1ULL) != 0ULL))
+    {
+        data |= ~0ULL << width;
+    }
+
+    value = static_cast<T>(data);
+}
+
+//!
+//! \brief Converts the field bits to a single precision floating point
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The single precision floating point
+//!
+inline void fieldValue(const uint64_t raw, const std::size_t width, float& value)
+{
+    const uint32_t data = static_cast<uint32_t>(raw);
+
+    (void) width;
+
+    (void) std::memcpy(&value, &data, sizeof(value));
+}
+
+//!
+//! \brief Converts the field bits to a double precision floating point
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The double precision floating point
+//!
+inline void fieldValue(const uint64_t raw, const std::size_t width, double& value)
+{
+    (void) width;
+
+    (void) std::memcpy(&value, &raw, sizeof(value));
+}
+
+//!
+//! \brief Converts the field bits to a half precision floating point
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The half precision floating point
+//!
+inline void fieldValue(const uint64_t raw, const std::size_t width, Half& value)
+{
+    (void) width;
+
+    value = Half::fromBits(static_cast<uint16_t>(raw));
+}
+
+//!
+//! \brief Converts the field bits to a bfloat16 floating point
+//!
+//! \param raw      The field bits
+//! \param width    The field width
+//! \param value    The bfloat16 floating point
+//!
+inline void fieldValue(const uint64_t raw, const std::size_t width, BrainFloat& value)
+{
+    (void) width;
+
+    value = BrainFloat::fromBits(static_cast<uint16_t>(raw));
+}
+
+//!
+//! \brief Converts the field bits to a fixed-point value
+//!
+//! \param raw      The field bits
+//! \param width    The field width, the most significant bit is the sign if
+//!                 Raw is signed
+//! \param value    The fixed-point value
+//!
+template <typename Raw, std::size_t FracBits>
+inline void fieldValue(const uint64_t raw, const std::size_t width, Fixed<Raw, FracBits>& value)
+{
+    Raw data;
+
+    fieldValue(raw, width, data);
+
+    value = Fixed<Raw, FracBits>::fromBits(data);
+}
+
+//!
+//! \brief Converts the field bits of a run time value type to a number
+//!
+//! \param raw      The field bits
+//! \param width    The field width, the most significant bit is the sign of
+//!                 Signed fields
+//! \param type     The value type of the field
+//!
+//! \return double  The unscaled value
+//!
+inline double fieldNumber(const uint64_t raw, const std::size_t width, const ValueType type)
+{
+    double result;
+
+    if (Signed == type)
+    {
+        int64_t value;
+
+        fieldValue(raw, width, value);
+
+        result = static_cast<double>(value);
+    }
+    else if (Float32 == type)
+    {
+        float value;
+
+        fieldValue(raw, width, value);
+
+        result = value;
+    }
+    else if (Float64 == type)
+    {
+        fieldValue(raw, width, result);
+    }
+    else if (Float16 == type)
+    {
+        result = halfToFloat(static_cast<uint16_t>(raw));
+    }
+    else if (BFloat16 == type)
+    {
+        result = brainToFloat(static_cast<uint16_t>(raw));
+    }
+    else
+    {
+        result = static_cast<double>(raw);
+    }
+
+    return result;
+}
+
+//!
+//! \brief Converts a boolean flag to the field bits
+//!
+//! \param value    The bool flag
+//!
+//! \return uint64_t The field bits
+//!
+inline uint64_t fieldRaw(const bool& value)
+{
+    return value ? 1ULL : 0ULL;
+}
+
+//!
+//! \brief Converts a fixed-width integer to the field bits
+//!
+//! \param value    The integer (two's complement if signed)
+//!
+//! \return uint64_t The field bits
+//!
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value, uint64_t>::type
+fieldRaw(const T& value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+//!
+//! \brief Converts a single precision floating point to the field bits
+//!
+//! \param value    The single precision floating point
+//!
+//! \return uint64_t The field bits
+//!
+inline uint64_t fieldRaw(const float& value)
+{
+    uint32_t data;
+
+    (void) std::memcpy(&data, &value, sizeof(data));
+
+    return data;
+}
+
+//!
+//! \brief Converts a double precision floating point to the field bits
+//!
+//! \param value    The double precision floating point
+//!
+//! \return uint64_t The field bits
+//!
+inline uint64_t fieldRaw(const double& value)
+{
+    uint64_t data;
+
+    (void) std::memcpy(&data, &value, sizeof(data));
+
+    return data;
+}
+
+//!
+//! \brief Converts a half precision floating point to the field bits
+//!
+//! \param value    The half precision floating point
+//!
+//! \return uint64_t The field bits
+//!
+inline uint64_t fieldRaw(const Half& value)
+{
+    return value.bits();
+}
+
+//!
+//! \brief Converts a bfloat16 floating point to the field bits
+//!
+//! \param value    The bfloat16 floating point
+//!
+//! \return uint64_t The field bits
+//!
+inline uint64_t fieldRaw(const BrainFloat& value)
+{
+    return value.bits();
+}
+
+//!
+//! \brief Converts a fixed-point value to the field bits
+//!
+//! \param value    The fixed-point value
+//!
+//! \return uint64_t The field bits (two's complement if signed)
+//!
+template <typename Raw, std::size_t FracBits>
+inline uint64_t fieldRaw(const Fixed<Raw, FracBits>& value)
+{
+    return fieldRaw(value.bits());
+}
+
+//!
+//! \brief Compile-time field layout of a signal
+//!
+template <typename SignalType>
+struct Field
+{
+    //!
+    //! \brief Value type of the signal
+    //!
+    typedef typename SignalType::Type Type;
+
+    //!
+    //! \brief Field offset of the signal
+    //!
+    static const std::size_t OFFSET =
+            ((SignalType::BIT_POSITION / U08_BIT_COUNT) * U08_BIT_COUNT) +
+            ((U08_BIT_COUNT - 1UL) - (SignalType::BIT_POSITION % U08_BIT_COUNT));
+
+    //!
+    //! \brief Field width of the signal
+    //!
+    static const std::size_t WIDTH = SignalType::BIT_WIDTH;
+
+    //!
+    //! \brief Minimum byte size of a buffer holding the signal
+    //!
+    static const std::size_t END = (OFFSET + WIDTH + U08_BIT_COUNT - 1UL) /
+                                   U08_BIT_COUNT;
+
+    //!
+    //! \brief Reads the signal value straight from the buffer bytes
+    //!
+    //! \param data The buffer bytes
+    //! \param size The byte size of the buffer
+    //!
+    //! \return Type    The signal value
+    //!
+    static Type read(const uint8_t* data, const std::size_t size)
+    {
+        BIT_COUNT(SignalReads, 1ULL);
+        BIT_COUNT_ACCESS(OFFSET);
+
+        Type result;
+
+        fieldValue(extractField(data, size, OFFSET, WIDTH), WIDTH, result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Writes the signal value straight into the buffer bytes
+    //!
+    //! \param data     The buffer bytes
+    //! \param size     The byte size of the buffer
+    //! \param value    The signal value, replacing the previous one
+    //!
+    static void write(uint8_t* data, const std::size_t size, const Type& value)
+    {
+        BIT_COUNT(SignalWrites, 1ULL);
+        BIT_COUNT_ACCESS(OFFSET);
+
+        insertField(data, size, OFFSET, WIDTH, fieldRaw(value));
+    }
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <typename SignalType>
+const std::size_t Field<SignalType>::OFFSET;
+
+template <typename SignalType>
+const std::size_t Field<SignalType>::WIDTH;
+
+template <typename SignalType>
+const std::size_t Field<SignalType>::END;
+}
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef BIT_FILTER_H
+#define BIT_FILTER_H
+
+//!
+//! \file bit_filter.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Masked bit pattern filter over arrays of fixed layout frames
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+
+#include <cstring>
+
+namespace bit
+{
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Tests an array of frames against a masked bit pattern
+//!
+//! \param frames   The first byte of the first frame
+//! \param count    The number of frames to test
+//! \param stride   The byte distance between two consecutive frames
+//! \param mask     The pattern mask, one byte per frame byte
+//! \param value    The pattern value, one byte per frame byte
+//! \param size     The byte size of the frame layout (mask and value)
+//! \param bitmap   The match bitmap, (count + 63) / 64 words. Bit (i % 64) of
+//!                 word (i / 64) is set when the frame i matches
+//!
+//! \return std::size_t The number of matching frames
+//!
+//! \note   The fastest compare kernel supported by the CPU (AVX-512, AVX2 or
+//!         scalar 64-bit words) is selected at run time
+//!
+std::size_t filterBitmap(const uint8_t* frames,
+                         const std::size_t count,
+                         const std::size_t stride,
+                         const uint8_t* mask,
+                         const uint8_t* value,
+                         const std::size_t size,
+                         uint64_t* bitmap);
+
+//!
+//! \brief Tests an array of frames against a masked bit pattern
+//!
+//! \param frames       The first byte of the first frame
+//! \param count        The number of frames to test
+//! \param stride       The byte distance between two consecutive frames
+//! \param mask         The pattern mask, one byte per frame byte
+//! \param value        The pattern value, one byte per frame byte
+//! \param size         The byte size of the frame layout (mask and value)
+//! \param indices      The indices of the matching frames (ascending order)
+//! \param maxIndices   The capacity of the indices array
+//!
+//! \return std::size_t The number of matching frames written to indices
+//!
+std::size_t filterIndices(const uint8_t* frames,
+                          const std::size_t count,
+                          const std::size_t stride,
+                          const uint8_t* mask,
+                          const uint8_t* value,
+                          const std::size_t size,
+                          std::size_t* indices,
+                          const std::size_t maxIndices);
+
+template <std::size_t Size>
+class Filter
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty filter (matches every frame)
+    //!
+    Filter()
+        : mStatus(Buffer<Size>::Ok)
+        , mMask()
+        , mValue()
+    {
+    }
+
+    //!
+    //! \brief Destroys a filter object
+    //!
+    ~Filter()
+    {
+    }
+
+    //!
+    //! \brief Removes every condition of the filter
+    //!
+    void clear()
+    {
+        mStatus = Buffer<Size>::Ok;
+
+        (void) std::memset(mMask, 0, Size);
+        (void) std::memset(mValue, 0, Size);
+    }
+
+    //!
+    //! \brief Returns the status of the filter
+    //!
+    //! \return Status  Overflow if a condition does not fit the frame layout
+    //!
+    typename Buffer<Size>::Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Adds the condition "signal == value" to the filter
+    //!
+    //! \param value    The value the signal must hold
+    //!
+    //! \return Filter& The filter instance
+    //!
+    //! \note   The mask and value bits are produced with the same
+    //!         Buffer::operator<< used to encode the frames
+    //!
+    template <typename SignalType>
+    Filter& match(const typename SignalType::Type& value)
+    {
+        SignalType signal;
+
+        Buffer<Size> mask;
+        Buffer<Size> bits;
+
+        typename SignalType::Type ones;
+
+        fill(ones);
+
+        signal.write(ones);
+        mask << signal;
+
+        signal.clear();
+
+        signal.write(value);
+        bits << signal;
+
+        if ((mask.status() != Buffer<Size>::Ok) ||
+            (bits.status() != Buffer<Size>::Ok))
+        {
+            mStatus = Buffer<Size>::Overflow;
+        }
+
+        merge(mask.data(), bits.data());
+
+        return *this;
+    }
+
+    //!
+    //! \brief Adds the condition "(frame[position] & mask) == value"
+    //!
+    //! \param position The byte position in the frame
+    //! \param mask     The byte mask
+    //! \param value    The byte value
+    //!
+    //! \return Filter& The filter instance
+    //!
+    Filter& match(const std::size_t position,
+                  const uint8_t mask,
+                  const uint8_t value)
+    {
+        if (position < Size)
+        {
+            mValue[position] = static_cast<uint8_t>(
+                    (mValue[position] & static_cast<uint8_t>(~mask)) |
+                    (value & mask));
+
+            mMask[position] |= mask;
+        }
+        else
+        {
+            mStatus = Buffer<Size>::Overflow;
+        }
+
+        return *this;
+    }
+
+    //!
+    //! \brief Tests an array of frames against the filter
+    //!
+    //! \param frames   The first byte of the first frame
+    //! \param count    The number of frames
+    //! \param stride   The byte distance between two consecutive frames
+    //! \param bitmap   The match bitmap, (count + 63) / 64 words
+    //!
+    //! \return std::size_t The number of matching frames
+    //!
+    std::size_t scan(const uint8_t* frames,
+                     const std::size_t count,
+                     const std::size_t stride,
+                     uint64_t* bitmap) const
+    {
+        return filterBitmap(frames, count, stride, mMask, mValue, Size, bitmap);
+    }
+
+    //!
+    //! \brief Tests a contiguous array of buffers against the filter
+    //!
+    //! \param frames   The buffers to test
+    //! \param count    The number of buffers
+    //! \param bitmap   The match bitmap, (count + 63) / 64 words
+    //!
+    //! \return std::size_t The number of matching frames
+    //!
+    std::size_t scan(const Buffer<Size>* frames,
+                     const std::size_t count,
+                     uint64_t* bitmap) const
+    {
+        std::size_t result = 0UL;
+
+        if (count != 0UL)
+        {
+            result = scan(frames[0].data(), count, sizeof(Buffer<Size>), bitmap);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Collects the indices of the frames matching the filter
+    //!
+    //! \param frames       The first byte of the first frame
+    //! \param count        The number of frames
+    //! \param stride       The byte distance between two consecutive frames
+    //! \param indices      The indices of the matching frames
+    //! \param maxIndices   The capacity of the indices array
+    //!
+    //! \return std::size_t The number of indices written
+    //!
+    std::size_t find(const uint8_t* frames,
+                     const std::size_t count,
+                     const std::size_t stride,
+                     std::size_t* indices,
+                     const std::size_t maxIndices) const
+    {
+        return filterIndices(frames, count, stride, mMask, mValue, Size,
+                             indices, maxIndices);
+    }
+
+    //!
+    //! \brief Collects the indices of the buffers matching the filter
+    //!
+    //! \param frames       The buffers to test
+    //! \param count        The number of buffers
+    //! \param indices      The indices of the matching frames
+    //! \param maxIndices   The capacity of the indices array
+    //!
+    //! \return std::size_t The number of indices written
+    //!
+    std::size_t find(const Buffer<Size>* frames,
+                     const std::size_t count,
+                     std::size_t* indices,
+                     const std::size_t maxIndices) const
+    {
+        std::size_t result = 0UL;
+
+        if (count != 0UL)
+        {
+            result = find(frames[0].data(), count, sizeof(Buffer<Size>),
+                          indices, maxIndices);
+        }
+
+        return result;
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Overflow if a condition was placed out of the frame layout
+    //!
+    typename Buffer<Size>::Status mStatus;
+
+    //!
+    //! \brief Bits of the frame taking part in the comparison
+    //!
+    uint8_t mMask[Size];
+
+    //!
+    //! \brief Expected value of the masked bits
+    //!
+    uint8_t mValue[Size];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Merges an encoded condition into the pattern
+    //!
+    //! \param mask The bits of the condition
+    //! \param bits The expected value of the condition
+    //!
+    void merge(const uint8_t* mask, const uint8_t* bits)
+    {
+        for (std::size_t i = 0UL; i < Size; i++)
+        {
+            mValue[i] = static_cast<uint8_t>(
+                    (mValue[i] & static_cast<uint8_t>(~mask[i])) |
+                    (bits[i] & mask[i]));
+
+            mMask[i] |= mask[i];
+        }
+    }
+
+    //!
+    //! \brief Sets every bit of a signal value
+    //!
+    //! \param value    The value to fill
+    //!
+    template <typename T>
+    static void fill(T& value)
+    {
+        (void) std::memset(&value, 0xFF, sizeof(T));
+    }
+
+    //!
+    //! \brief Sets the boolean flag
+    //!
+    //! \param value    The flag to fill
+    //!
+    static void fill(bool& value)
+    {
+        value = true;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef BIT_FRAMING_H
+#define BIT_FRAMING_H
+
+//!
+//! \file bit_framing.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    COBS and SLIP byte stream framing of buffer payloads
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The delimiter and escape bytes are searched 32 bytes at a time
+//!             (AVX2, selected at run time) or 8 bytes at a time, the bytes
+//!             in between are copied with memcpy
+//!
+//! \note       A FrameDecoder is fed the stream in pieces of any size and
+//!             keeps its state across them. Frames are decoded directly into
+//!             the caller storage (a Buffer or a byte array)
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Byte stream framings
+//!
+enum Framing
+{
+    Cobs = 0,       //!< Consistent Overhead Byte Stuffing, 0x00 delimited
+    Slip            //!< RFC 1055, END (0xC0) delimited, ESC (0xDB) escaped
+};
+
+//!
+//! \brief COBS frame delimiter
+//!
+const uint8_t COBS_DELIMITER = 0x00U;
+
+//!
+//! \brief Longest COBS block (code 0xFF, no implicit zero)
+//!
+const std::size_t COBS_BLOCK_SIZE = 254UL;
+
+//!
+//! \brief SLIP frame delimiter
+//!
+const uint8_t SLIP_END = 0xC0U;
+
+//!
+//! \brief SLIP escape
+//!
+const uint8_t SLIP_ESC = 0xDBU;
+
+//!
+//! \brief SLIP escaped END
+//!
+const uint8_t SLIP_ESC_END = 0xDCU;
+
+//!
+//! \brief SLIP escaped ESC
+//!
+const uint8_t SLIP_ESC_ESC = 0xDDU;
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the largest encoded size of a payload, delimiter included
+//!
+//! \param framing  The framing
+//! \param size     The byte size of the payload
+//!
+//! \return std::size_t The output capacity required by encodeFrame()
+//!
+inline std::size_t maxFrameSize(const Framing framing, const std::size_t size)
+{
+    return (Cobs == framing) ? (size + (size / COBS_BLOCK_SIZE) + 2UL) :
+                               ((size * 2UL) + 1UL);
+}
+
+//!
+//! \brief Encodes a payload as one delimited frame
+//!
+//! \param framing  The framing
+//! \param data     The payload bytes
+//! \param size     The byte size of the payload
+//! \param output   The encoded frame
+//! \param capacity The byte capacity of the output
+//!
+//! \return std::size_t The byte size of the frame, 0 if the capacity is less
+//!                     than maxFrameSize()
+//!
+std::size_t encodeFrame(const Framing framing,
+                        const uint8_t* data,
+                        const std::size_t size,
+                        uint8_t* output,
+                        const std::size_t capacity);
+
+//!
+//! \brief Encodes the bytes of a bit buffer as one delimited frame
+//!
+//! \param framing  The framing
+//! \param payload  The payload
+//! \param output   The encoded frame
+//! \param capacity The byte capacity of the output
+//!
+//! \return std::size_t The byte size of the frame, 0 if it does not fit
+//!
+template <std::size_t Size>
+std::size_t encodeFrame(const Framing framing,
+                        const Buffer<Size>& payload,
+                        uint8_t* output,
+                        const std::size_t capacity)
+{
+    return encodeFrame(framing, payload.data(), Size, output, capacity);
+}
+
+//!
+//! \brief Encodes the viewed bytes as one delimited frame
+//!
+//! \param framing  The framing
+//! \param payload  The payload
+//! \param output   The encoded frame
+//! \param capacity The byte capacity of the output
+//!
+//! \return std::size_t The byte size of the frame, 0 if it does not fit
+//!
+inline std::size_t encodeFrame(const Framing framing,
+                               const BufferView& payload,
+                               uint8_t* output,
+                               const std::size_t capacity)
+{
+    return encodeFrame(framing, payload.data(), payload.size(), output, capacity);
+}
+
+class FrameDecoder
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of a decoded frame
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow,       //!< Frame larger than the storage, truncated
+        FrameError      //!< Invalid escape or truncated COBS block
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a decoder writing into a byte array
+    //!
+    //! \param framing  The framing
+    //! \param storage  The frame storage
+    //! \param capacity The byte capacity of the storage
+    //!
+    FrameDecoder(const Framing framing, uint8_t* storage, const std::size_t capacity);
+
+    //!
+    //! \brief Constructs a decoder writing into a bit buffer
+    //!
+    //! \param framing  The framing
+    //! \param buffer   The frame storage
+    //!
+    //! \note   The frames are written through the buffer data, touch() the
+    //!         buffer after every frame (see Buffer::generation())
+    //!
+    template <std::size_t Size>
+    FrameDecoder(const Framing framing, Buffer<Size>& buffer)
+        : mFraming(framing)
+        , mStorage(buffer.data())
+        , mCapacity(Size)
+        , mSize(0UL)
+        , mStatus(Ok)
+        , mIsComplete(false)
+        , mIsStarted(false)
+        , mIsEscaped(false)
+        , mIsZeroPending(false)
+        , mRemaining(0UL)
+    {
+    }
+
+    //!
+    //! \brief Destroys a decoder
+    //!
+    ~FrameDecoder();
+
+    //!
+    //! \brief Decodes stream bytes up to the end of the next frame
+    //!
+    //! \param data The stream bytes
+    //! \param size The number of stream bytes
+    //!
+    //! \return std::size_t The number of bytes consumed. Less than size only
+    //!                     if a frame was completed, see isComplete()
+    //!
+    //! \note   Empty frames (consecutive delimiters) are skipped
+    //!
+    std::size_t feed(const uint8_t* data, const std::size_t size);
+
+    //!
+    //! \brief Tells whether a frame was completed, call next() before feeding
+    //!        the rest of the stream
+    //!
+    //! \return bool    True if the storage holds a complete frame
+    //!
+    bool isComplete() const
+    {
+        return mIsComplete;
+    }
+
+    //!
+    //! \brief Returns the status of the frame being decoded
+    //!
+    //! \return Status  Ok, Overflow or FrameError
+    //!
+    Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Returns the decoded byte size of the frame
+    //!
+    //! \return std::size_t The byte size (up to the capacity)
+    //!
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    //!
+    //! \brief Returns a view of the decoded frame
+    //!
+    //! \return BufferView  The frame bytes
+    //!
+    BufferView view() const
+    {
+        return BufferView(mStorage, mSize);
+    }
+
+    //!
+    //! \brief Starts the next frame, discarding the current one
+    //!
+    void next();
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief The framing
+    //!
+    const Framing mFraming;
+
+    //!
+    //! \brief Frame storage
+    //!
+    uint8_t* mStorage;
+
+    //!
+    //! \brief Byte capacity of the frame storage
+    //!
+    const std::size_t mCapacity;
+
+    //!
+    //! \brief Decoded bytes of the frame
+    //!
+    std::size_t mSize;
+
+    //!
+    //! \brief Status of the frame
+    //!
+    Status mStatus;
+
+    //!
+    //! \brief Set if the frame is complete
+    //!
+    bool mIsComplete;
+
+    //!
+    //! \brief Set if a byte of the frame was received
+    //!
+    bool mIsStarted;
+
+    //!
+    //! \brief Set if the last byte was a SLIP ESC
+    //!
+    bool mIsEscaped;
+
+    //!
+    //! \brief Set if the COBS block decoded last ends with an implicit zero
+    //!
+    bool mIsZeroPending;
+
+    //!
+    //! \brief Bytes left in the COBS block, 0 if a code byte is expected
+    //!
+    std::size_t mRemaining;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Appends decoded bytes to the storage
+    //!
+    void put(const uint8_t* data, const std::size_t size);
+
+    //!
+    //! \brief Decodes COBS stream bytes
+    //!
+    std::size_t feedCobs(const uint8_t* data, const std::size_t size);
+
+    //!
+    //! \brief Decodes SLIP stream bytes
+    //!
+    std::size_t feedSlip(const uint8_t* data, const std::size_t size);
+
+    //!
+    //! \brief Not copyable
+    //!
+    FrameDecoder(const FrameDecoder&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    FrameDecoder& operator=(const FrameDecoder&);
+};
+}
+
+#endif
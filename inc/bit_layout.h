@@ -0,0 +1,331 @@
+#ifndef BIT_LAYOUT_H
+#define BIT_LAYOUT_H
+
+//!
+//! \file bit_layout.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Compile-time checked signal access and message layouts
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       extract() and insert() prove with static_assert that a signal
+//!             fits its Buffer<Size>, so they access the bytes without any
+//!             run time bounds check. The checked paths (Buffer::operator[],
+//!             extractField, DecodeTable) remain for views and run time
+//!             layouts
+//!
+//! \note       Layout<Size, Signals...> rejects at compile time a message
+//!             whose signals overlap or do not fit its buffer
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+namespace bit
+{
+//!
+//! \brief Unchecked access to a field proven to fit a buffer
+//!
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+struct StaticField
+{
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief First byte of the field
+    //!
+    static const std::size_t BYTE = Offset / U08_BIT_COUNT;
+
+    //!
+    //! \brief Bit of the field MSB in its first byte
+    //!
+    static const std::size_t SHIFT = Offset % U08_BIT_COUNT;
+
+    //!
+    //! \brief Byte following the last byte of the field
+    //!
+    static const std::size_t END = (Offset + Width + U08_BIT_COUNT - 1UL) / U08_BIT_COUNT;
+
+    //!
+    //! \brief Unused bits after the field LSB in its last byte
+    //!
+    static const std::size_t TRAILING = (END * U08_BIT_COUNT) - Offset - Width;
+
+    //!
+    //! \brief Field mask, right aligned
+    //!
+    static const uint64_t MASK = ~0ULL >> (U64_BIT_COUNT - Width);
+
+    static_assert((Width >= 1UL) && (Width <= U64_BIT_COUNT), "Invalid field width");
+    static_assert(END <= Size, "Signal does not fit the buffer");
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Extracts the field bits
+    //!
+    //! \param data The buffer bytes (Size bytes)
+    //!
+    //! \return uint64_t    The field bits, right aligned
+    //!
+    static uint64_t extract(const uint8_t* data)
+    {
+        uint64_t result;
+
+        if ((SHIFT + Width) > U64_BIT_COUNT)
+        {
+            // 9 bytes, END <= Size
+            result = ((loadU64(&data[BYTE]) << SHIFT) |
+                      (data[BYTE + sizeof(uint64_t)] >> (U08_BIT_COUNT - SHIFT))) >>
+                     (U64_BIT_COUNT - Width);
+        }
+        else if ((BYTE + sizeof(uint64_t)) <= Size)
+        {
+            result = (loadU64(&data[BYTE]) << SHIFT) >> (U64_BIT_COUNT - Width);
+        }
+        else
+        {
+            uint64_t word = 0ULL;
+
+            for (std::size_t i = BYTE; i < END; i++)
+            {
+                word = (word << U08_BIT_COUNT) | data[i];
+            }
+
+            result = (word >> TRAILING) & MASK;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Inserts the field bits, replacing the previous ones
+    //!
+    //! \param data The buffer bytes (Size bytes)
+    //! \param raw  The field bits, right aligned (upper bits are ignored)
+    //!
+    static void insert(uint8_t* data, const uint64_t raw)
+    {
+        if (((SHIFT + Width) <= U64_BIT_COUNT) && ((BYTE + sizeof(uint64_t)) <= Size))
+        {
+            const std::size_t left = (U64_BIT_COUNT - SHIFT - Width) % U64_BIT_COUNT;
+
+            const uint64_t mask = MASK << left;
+
+            const uint64_t word = loadU64(&data[BYTE]);
+
+            storeU64(&data[BYTE], (word & ~mask) | ((raw << left) & mask));
+        }
+        else
+        {
+            const std::size_t end = Offset + Width;
+
+            for (std::size_t i = BYTE; i < END; i++)
+            {
+                const std::size_t first = i * U08_BIT_COUNT;
+
+                const std::size_t lo = (Offset > first) ? Offset : first;
+                const std::size_t hi = (end < (first + U08_BIT_COUNT)) ?
+                                       end : (first + U08_BIT_COUNT);
+
+                const std::size_t count = hi - lo;
+                const std::size_t left = (first + U08_BIT_COUNT) - hi;
+
+                const uint32_t bits = static_cast<uint32_t>(
+                        (raw >> (end - hi)) & ((1ULL << count) - 1ULL));
+
+                const uint32_t mask = ((1UL << count) - 1UL) << left;
+
+                data[i] = static_cast<uint8_t>((data[i] & ~mask) | (bits << left));
+            }
+        }
+    }
+};
+
+//!
+//! \brief Tells whether the fields of two signals share any bit
+//!
+template <typename First, typename Second>
+struct FieldsOverlap
+{
+    //!
+    //! \brief True if the fields overlap
+    //!
+    static const bool VALUE =
+            (Field<First>::OFFSET < (Field<Second>::OFFSET + Field<Second>::WIDTH)) &&
+            (Field<Second>::OFFSET < (Field<First>::OFFSET + Field<First>::WIDTH));
+};
+
+//!
+//! \brief Tells whether a signal overlaps any signal of a list
+//!
+template <typename SignalType, typename... Signals>
+struct OverlapsAny;
+
+template <typename SignalType>
+struct OverlapsAny<SignalType>
+{
+    static const bool VALUE = false;
+};
+
+template <typename SignalType, typename Head, typename... Tail>
+struct OverlapsAny<SignalType, Head, Tail...>
+{
+    static const bool VALUE = FieldsOverlap<SignalType, Head>::VALUE ||
+                              OverlapsAny<SignalType, Tail...>::VALUE;
+};
+
+//!
+//! \brief Tells whether any two signals of a list overlap
+//!
+template <typename Head, typename... Tail>
+struct LayoutOverlap
+{
+    static const bool VALUE = OverlapsAny<Head, Tail...>::VALUE ||
+                              LayoutOverlap<Tail...>::VALUE;
+};
+
+template <typename Head>
+struct LayoutOverlap<Head>
+{
+    static const bool VALUE = false;
+};
+
+//!
+//! \brief Returns the minimum byte size of a buffer holding a list of signals
+//!
+template <typename Head, typename... Tail>
+struct LayoutEnd
+{
+    static const std::size_t VALUE =
+            (Field<Head>::END > LayoutEnd<Tail...>::VALUE) ?
+            Field<Head>::END : LayoutEnd<Tail...>::VALUE;
+};
+
+template <typename Head>
+struct LayoutEnd<Head>
+{
+    static const std::size_t VALUE = Field<Head>::END;
+};
+
+//!
+//! \brief Signal list of a message, checked at compile time
+//!
+//! \details    Naming a member (or declaring an object) of the layout checks
+//!             that every signal fits the Size bytes and that no two signals
+//!             overlap
+//!
+template <std::size_t Size, typename... Signals>
+struct Layout
+{
+    //!
+    //! \brief Number of signals of the message
+    //!
+    static const std::size_t COUNT = sizeof...(Signals);
+
+    //!
+    //! \brief Minimum byte size of the message
+    //!
+    static const std::size_t END = LayoutEnd<Signals...>::VALUE;
+
+    static_assert(END <= Size, "Message signals do not fit the buffer");
+    static_assert(!LayoutOverlap<Signals...>::VALUE, "Message signals overlap");
+};
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Reads a signal value from a buffer without run time bounds checks
+//!
+//! \param frame    The buffer, the signal shall fit it (compile-time check)
+//!
+//! \return SignalType::Type    The signal value
+//!
+template <typename SignalType, std::size_t Size>
+inline typename SignalType::Type extract(const Buffer<Size>& frame)
+{
+    typedef Field<SignalType> Bits;
+
+    typename SignalType::Type result;
+
+    fieldValue(StaticField<Bits::OFFSET, Bits::WIDTH, Size>::extract(frame.data()),
+               Bits::WIDTH,
+               result);
+
+    return result;
+}
+
+//!
+//! \brief Writes a signal value into a buffer without run time bounds checks
+//!
+//! \param frame    The buffer, the signal shall fit it (compile-time check)
+//! \param value    The signal value, replacing the previous one
+//!
+template <typename SignalType, std::size_t Size>
+inline void insert(Buffer<Size>& frame, const typename SignalType::Type& value)
+{
+    typedef Field<SignalType> Bits;
+
+    StaticField<Bits::OFFSET, Bits::WIDTH, Size>::insert(frame.data(), fieldRaw(value));
+}
+
+//------------------------ Static member definitions ---------------------------
+
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+const std::size_t StaticField<Offset, Width, Size>::BYTE;
+
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+const std::size_t StaticField<Offset, Width, Size>::SHIFT;
+
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+const std::size_t StaticField<Offset, Width, Size>::END;
+
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+const std::size_t StaticField<Offset, Width, Size>::TRAILING;
+
+template <std::size_t Offset, std::size_t Width, std::size_t Size>
+const uint64_t StaticField<Offset, Width, Size>::MASK;
+
+template <typename First, typename Second>
+const bool FieldsOverlap<First, Second>::VALUE;
+
+template <typename SignalType, typename Head, typename... Tail>
+const bool OverlapsAny<SignalType, Head, Tail...>::VALUE;
+
+template <typename SignalType>
+const bool OverlapsAny<SignalType>::VALUE;
+
+template <typename Head, typename... Tail>
+const bool LayoutOverlap<Head, Tail...>::VALUE;
+
+template <typename Head>
+const bool LayoutOverlap<Head>::VALUE;
+
+template <typename Head, typename... Tail>
+const std::size_t LayoutEnd<Head, Tail...>::VALUE;
+
+template <typename Head>
+const std::size_t LayoutEnd<Head>::VALUE;
+
+template <std::size_t Size, typename... Signals>
+const std::size_t Layout<Size, Signals...>::COUNT;
+
+template <std::size_t Size, typename... Signals>
+const std::size_t Layout<Size, Signals...>::END;
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef BIT_MUX_H
+#define BIT_MUX_H
+
+//!
+//! \file bit_mux.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Multiplexed signal groups with jump table decode
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The selector signal is decoded first and indexes a jump table
+//!             with one entry per selector value. Every entry points to the
+//!             decode plan of the group present for that value, so a decode
+//!             runs the common plan and exactly one group plan
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_plan.h"
+
+namespace bit
+{
+template <typename SelectorType,
+          std::size_t Groups = 8UL,
+          std::size_t Capacity = 16UL>
+class MuxPlan
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the mux plan
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow,
+        UnknownValue
+    };
+
+    //!
+    //! \brief Number of selector values (jump table entries)
+    //!
+    static const std::size_t VALUE_COUNT = 1UL << Field<SelectorType>::WIDTH;
+
+    static_assert(Field<SelectorType>::WIDTH <= 10UL,
+                  "Selector wider than 10 bits");
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a plan without groups
+    //!
+    MuxPlan()
+        : mCommon()
+        , mGroupCount(0UL)
+        , mSelector(0UL)
+        , mStatus(Ok)
+    {
+        for (std::size_t i = 0UL; i < VALUE_COUNT; i++)
+        {
+            mTable[i] = 0;
+        }
+    }
+
+    //!
+    //! \brief Destroys a mux plan object
+    //!
+    ~MuxPlan()
+    {
+    }
+
+    //!
+    //! \brief Returns the status of the plan
+    //!
+    //! \return Status  (Ok | Overflow)
+    //!
+    Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Returns the selector value of the last decode
+    //!
+    //! \return std::size_t The raw selector value
+    //!
+    std::size_t selector() const
+    {
+        return mSelector;
+    }
+
+    //!
+    //! \brief Requests a signal present for every selector value
+    //!
+    //! \param destination  The variable updated by every decode
+    //!
+    //! \return Status  Ok, Overflow if the common plan is full
+    //!
+    template <typename SignalType>
+    Status addCommon(typename SignalType::Type& destination)
+    {
+        return check(mCommon.template add<SignalType>(destination));
+    }
+
+    //!
+    //! \brief Requests a signal of the group of a selector value
+    //!
+    //! \param value        The raw selector value
+    //! \param destination  The variable updated by the decodes of that value
+    //!
+    //! \return Status  Ok, Overflow if out of groups or the group is full
+    //!
+    template <typename SignalType>
+    Status add(const std::size_t value, typename SignalType::Type& destination)
+    {
+        Status result = Overflow;
+
+        if ((value < VALUE_COUNT) && ((mTable[value] != 0) || (mGroupCount < Groups)))
+        {
+            if (0 == mTable[value])
+            {
+                mTable[value] = &mGroups[mGroupCount];
+
+                mGroupCount++;
+            }
+
+            result = check(mTable[value]->template add<SignalType>(destination));
+        }
+        else
+        {
+            mStatus = Overflow;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Shares the group of a selector value with another value
+    //!
+    //! \param value    The raw selector value to bind
+    //! \param existing The raw selector value owning the group
+    //!
+    //! \return Status  Ok, Overflow if a value is out of range
+    //!
+    Status alias(const std::size_t value, const std::size_t existing)
+    {
+        Status result = Overflow;
+
+        if ((value < VALUE_COUNT) && (existing < VALUE_COUNT))
+        {
+            mTable[value] = mTable[existing];
+
+            result = Ok;
+        }
+        else
+        {
+            mStatus = Overflow;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Decodes the selector, the common signals and the group selected
+    //!
+    //! \param data The frame bytes
+    //! \param size The byte size of the frame
+    //!
+    //! \return Status  Ok, UnknownValue if no group is bound to the selector
+    //!                 value, Overflow if the frame is too short
+    //!
+    Status decode(const uint8_t* data, const std::size_t size)
+    {
+        typedef Field<SelectorType> Layout;
+
+        Status result = UnknownValue;
+
+        mSelector = static_cast<std::size_t>(
+                extractField(data, size, Layout::OFFSET, Layout::WIDTH));
+
+        const DecodePlan<Capacity>* group = mTable[mSelector];
+
+        bool isShort = (mCommon.decode(data, size) != DecodePlan<Capacity>::Ok);
+
+        if (group != 0)
+        {
+            isShort = (group->decode(data, size) != DecodePlan<Capacity>::Ok) ||
+                      isShort;
+
+            result = Ok;
+        }
+
+        if (isShort || (size < Layout::END))
+        {
+            result = Overflow;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Decodes a bit buffer
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return Status  Ok, UnknownValue or Overflow
+    //!
+    template <std::size_t Size>
+    Status decode(const Buffer<Size>& frame)
+    {
+        return decode(frame.data(), Size);
+    }
+
+    //!
+    //! \brief Decodes a viewed frame
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return Status  Ok, UnknownValue or Overflow
+    //!
+    Status decode(const BufferView& frame)
+    {
+        return decode(frame.data(), frame.size());
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Signals present for every selector value
+    //!
+    DecodePlan<Capacity> mCommon;
+
+    //!
+    //! \brief Signal groups
+    //!
+    DecodePlan<Capacity> mGroups[Groups];
+
+    //!
+    //! \brief Group of every selector value, 0 if none
+    //!
+    DecodePlan<Capacity>* mTable[VALUE_COUNT];
+
+    //!
+    //! \brief Number of groups in use
+    //!
+    std::size_t mGroupCount;
+
+    //!
+    //! \brief Selector value of the last decode
+    //!
+    std::size_t mSelector;
+
+    //!
+    //! \brief Returns the current status of the plan
+    //!
+    Status mStatus;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable (the jump table points into the object)
+    //!
+    MuxPlan(const MuxPlan&);
+
+    //!
+    //! \brief Not copyable (the jump table points into the object)
+    //!
+    MuxPlan& operator=(const MuxPlan&);
+
+    //!
+    //! \brief Maps the status of a group plan
+    //!
+    Status check(const typename DecodePlan<Capacity>::Status status)
+    {
+        Status result = Ok;
+
+        if (status != DecodePlan<Capacity>::Ok)
+        {
+            mStatus = Overflow;
+
+            result = Overflow;
+        }
+
+        return result;
+    }
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <typename SelectorType, std::size_t Groups, std::size_t Capacity>
+const std::size_t MuxPlan<SelectorType, Groups, Capacity>::VALUE_COUNT;
+}
+
+#endif
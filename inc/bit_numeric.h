@@ -0,0 +1,606 @@
+#ifndef BIT_NUMERIC_H
+#define BIT_NUMERIC_H
+
+//!
+//! \file bit_numeric.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Half precision, bfloat16 and fixed-point signal value types
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Half, BrainFloat and Fixed hold the field bits of a signal and
+//!             are used as the Signal type, e.g. Signal<Half, 7>. They convert
+//!             to float on demand, rounding to nearest even the other way
+//!
+//! \note       The scalar conversions use the F16C instructions when the
+//!             target enables them (-mf16c), otherwise the integer and
+//!             float bit tricks below, bit exact but for NaN payloads. The
+//!             array conversions pick AVX-512 (16 values per step), F16C or
+//!             AVX2 (8 values per step) at run time
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_base.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Converts half precision bits to a single precision floating point
+//!
+//! \param bits The IEEE 754 binary16 bits
+//!
+//! \return float   The exact value
+//!
+inline float halfToFloat(const uint16_t bits)
+{
+    float result;
+
+#if defined(__F16C__)
+
+    result = _cvtsh_ss(bits);
+
+#else
+
+    // Exponent rebias, infinities and NaNs keep an all ones exponent and
+    // subnormals are normalized by a float subtraction
+    const uint32_t exponent = 0x7C00UL << 13;
+    const uint32_t magic = 113UL << 23;
+
+    uint32_t data = (static_cast<uint32_t>(bits) & 0x7FFFUL) << 13;
+
+    const uint32_t shifted = data & exponent;
+
+    data += (127UL - 15UL) << 23;
+
+    if (shifted == exponent)
+    {
+        data += (128UL - 16UL) << 23;
+    }
+    else if (0UL == shifted)
+    {
+        float value;
+        float offset;
+
+        data += 1UL << 23;
+
+        (void) std::memcpy(&value, &data, sizeof(value));
+        (void) std::memcpy(&offset, &magic, sizeof(offset));
+
+        value -= offset;
+
+        (void) std::memcpy(&data, &value, sizeof(data));
+    }
+    else
+    {
+    }
+
+    data |= (static_cast<uint32_t>(bits) & 0x8000UL) << 16;
+
+    (void) std::memcpy(&result, &data, sizeof(result));
+
+#endif
+
+    return result;
+}
+
+//!
+//! \brief Converts a single precision floating point to half precision bits
+//!
+//! \param value    The value
+//!
+//! \return uint16_t    The IEEE 754 binary16 bits, rounded to nearest even,
+//!                     infinity beyond 65504
+//!
+inline uint16_t floatToHalf(const float value)
+{
+    uint16_t result;
+
+#if defined(__F16C__)
+
+    result = _cvtss_sh(value, 0);
+
+#else
+
+    // Subnormals are rounded by the float addition of the smallest normal
+    // with their exponent, normals by adding half an ulp (minus one if even)
+    const uint32_t infinity = 255UL << 23;
+    const uint32_t overflow = (127UL + 16UL) << 23;
+    const uint32_t subnormal = ((127UL - 15UL) + (23UL - 10UL) + 1UL) << 23;
+
+    uint32_t data;
+
+    (void) std::memcpy(&data, &value, sizeof(data));
+
+    const uint32_t sign = data & 0x80000000UL;
+
+    data ^= sign;
+
+    if (data >= overflow)
+    {
+        result = (data > infinity) ? 0x7E00U : 0x7C00U;
+    }
+    else if (data < (113UL << 23))
+    {
+        float magnitude;
+        float magic;
+
+        (void) std::memcpy(&magnitude, &data, sizeof(magnitude));
+        (void) std::memcpy(&magic, &subnormal, sizeof(magic));
+
+        magnitude += magic;
+
+        (void) std::memcpy(&data, &magnitude, sizeof(data));
+
+        result = static_cast<uint16_t>(data - subnormal);
+    }
+    else
+    {
+        const uint32_t odd = (data >> 13) & 1UL;
+
+        data += ((15UL - 127UL) << 23) + 0xFFFUL + odd;
+
+        result = static_cast<uint16_t>(data >> 13);
+    }
+
+    result = static_cast<uint16_t>(result | (sign >> 16));
+
+#endif
+
+    return result;
+}
+
+//!
+//! \brief Converts bfloat16 bits to a single precision floating point
+//!
+//! \param bits The bfloat16 bits (the upper half of a float)
+//!
+//! \return float   The exact value
+//!
+inline float brainToFloat(const uint16_t bits)
+{
+    const uint32_t data = static_cast<uint32_t>(bits) << 16;
+
+    float result;
+
+    (void) std::memcpy(&result, &data, sizeof(result));
+
+    return result;
+}
+
+//!
+//! \brief Converts a single precision floating point to bfloat16 bits
+//!
+//! \param value    The value
+//!
+//! \return uint16_t    The bfloat16 bits, rounded to nearest even, NaNs quiet
+//!
+inline uint16_t floatToBrain(const float value)
+{
+    uint32_t data;
+
+    (void) std::memcpy(&data, &value, sizeof(data));
+
+    uint16_t result;
+
+    if ((data & 0x7FFFFFFFUL) > 0x7F800000UL)
+    {
+        result = static_cast<uint16_t>((data >> 16) | 0x0040UL);
+    }
+    else
+    {
+        result = static_cast<uint16_t>((data + 0x7FFFUL + ((data >> 16) & 1UL)) >> 16);
+    }
+
+    return result;
+}
+
+//!
+//! \brief Converts an array of half precision bits to single precision
+//!
+//! \param input    The IEEE 754 binary16 bits
+//! \param count    The number of values
+//! \param output   The values
+//!
+void halfToFloat(const uint16_t* input, const std::size_t count, float* output);
+
+//!
+//! \brief Converts an array of single precision values to half precision bits
+//!
+//! \param input    The values
+//! \param count    The number of values
+//! \param output   The IEEE 754 binary16 bits, rounded to nearest even
+//!
+void floatToHalf(const float* input, const std::size_t count, uint16_t* output);
+
+//!
+//! \brief Converts an array of bfloat16 bits to single precision
+//!
+//! \param input    The bfloat16 bits
+//! \param count    The number of values
+//! \param output   The values
+//!
+void brainToFloat(const uint16_t* input, const std::size_t count, float* output);
+
+//!
+//! \brief Converts an array of single precision values to bfloat16 bits
+//!
+//! \param input    The values
+//! \param count    The number of values
+//! \param output   The bfloat16 bits, rounded to nearest even
+//!
+void floatToBrain(const float* input, const std::size_t count, uint16_t* output);
+
+//!
+//! \brief Converts an array of signed fixed-point values to single precision
+//!
+//! \param input    The raw values (raw / 2^fraction)
+//! \param count    The number of values
+//! \param fraction The number of fraction bits
+//! \param output   The values
+//!
+void fixedToFloat(const int16_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output);
+
+//!
+//! \brief Converts an array of unsigned fixed-point values to single precision
+//!
+//! \param input    The raw values (raw / 2^fraction)
+//! \param count    The number of values
+//! \param fraction The number of fraction bits
+//! \param output   The values
+//!
+void fixedToFloat(const uint16_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output);
+
+//!
+//! \brief Converts an array of signed fixed-point values to single precision
+//!
+//! \param input    The raw values (raw / 2^fraction)
+//! \param count    The number of values
+//! \param fraction The number of fraction bits
+//! \param output   The values, rounded to nearest even beyond 24 bits
+//!
+void fixedToFloat(const int32_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output);
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief IEEE 754 half precision (binary16) value
+//!
+class Half
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a positive zero
+    //!
+    Half()
+        : mBits(0U)
+    {
+    }
+
+    //!
+    //! \brief Constructs the nearest half precision value
+    //!
+    //! \param value    The value
+    //!
+    explicit Half(const float value)
+        : mBits(floatToHalf(value))
+    {
+    }
+
+    //!
+    //! \brief Returns the value of half precision bits
+    //!
+    //! \param bits The IEEE 754 binary16 bits
+    //!
+    //! \return Half    The value
+    //!
+    static Half fromBits(const uint16_t bits)
+    {
+        Half result;
+
+        result.mBits = bits;
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the half precision bits
+    //!
+    //! \return uint16_t    The IEEE 754 binary16 bits
+    //!
+    uint16_t bits() const
+    {
+        return mBits;
+    }
+
+    //!
+    //! \brief Returns the value as a single precision floating point
+    //!
+    //! \return float   The exact value
+    //!
+    float toFloat() const
+    {
+        return halfToFloat(mBits);
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief IEEE 754 binary16 bits
+    //!
+    uint16_t mBits;
+};
+
+//!
+//! \brief Brain floating point (bfloat16) value, the upper half of a float
+//!
+class BrainFloat
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a positive zero
+    //!
+    BrainFloat()
+        : mBits(0U)
+    {
+    }
+
+    //!
+    //! \brief Constructs the nearest bfloat16 value
+    //!
+    //! \param value    The value
+    //!
+    explicit BrainFloat(const float value)
+        : mBits(floatToBrain(value))
+    {
+    }
+
+    //!
+    //! \brief Returns the value of bfloat16 bits
+    //!
+    //! \param bits The bfloat16 bits
+    //!
+    //! \return BrainFloat  The value
+    //!
+    static BrainFloat fromBits(const uint16_t bits)
+    {
+        BrainFloat result;
+
+        result.mBits = bits;
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the bfloat16 bits
+    //!
+    //! \return uint16_t    The bfloat16 bits
+    //!
+    uint16_t bits() const
+    {
+        return mBits;
+    }
+
+    //!
+    //! \brief Returns the value as a single precision floating point
+    //!
+    //! \return float   The exact value
+    //!
+    float toFloat() const
+    {
+        return brainToFloat(mBits);
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief bfloat16 bits
+    //!
+    uint16_t mBits;
+};
+
+//!
+//! \brief Fixed-point value in Q format, value = raw / 2^FracBits
+//!
+//! \note   Fixed<int16_t, 12> is Q3.12 (sign, 3 integer and 12 fraction
+//!         bits). A Signal narrower than Raw holds the low bits of the raw
+//!         value, signed values are sign extended when read
+//!
+template <typename Raw, std::size_t FracBits>
+class Fixed
+{
+public:
+
+    static_assert(std::is_integral<Raw>::value && (sizeof(Raw) <= sizeof(uint32_t)),
+                  "Invalid raw type");
+
+    static_assert(FracBits <= (sizeof(Raw) * U08_BIT_COUNT), "Invalid fraction width");
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Raw integer type
+    //!
+    typedef Raw Type;
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Number of fraction bits
+    //!
+    static const std::size_t FRACTION_BITS = FracBits;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a zero
+    //!
+    Fixed()
+        : mBits(0)
+    {
+    }
+
+    //!
+    //! \brief Constructs the nearest fixed-point value
+    //!
+    //! \param value    The value, saturated to the Raw range, NaN is zero
+    //!
+    explicit Fixed(const double value)
+        : mBits(toRaw(value))
+    {
+    }
+
+    //!
+    //! \brief Returns the value of raw bits
+    //!
+    //! \param bits The raw value
+    //!
+    //! \return Fixed   The value
+    //!
+    static Fixed fromBits(const Raw bits)
+    {
+        Fixed result;
+
+        result.mBits = bits;
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the raw bits
+    //!
+    //! \return Raw The raw value
+    //!
+    Raw bits() const
+    {
+        return mBits;
+    }
+
+    //!
+    //! \brief Returns the value as a single precision floating point
+    //!
+    //! \return float   The value, rounded to nearest even beyond 24 bits
+    //!
+    float toFloat() const
+    {
+        return static_cast<float>(mBits) * (1.0F / static_cast<float>(1ULL << FracBits));
+    }
+
+    //!
+    //! \brief Returns the value as a double precision floating point
+    //!
+    //! \return double  The exact value
+    //!
+    double toDouble() const
+    {
+        return static_cast<double>(mBits) * (1.0 / static_cast<double>(1ULL << FracBits));
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Raw value
+    //!
+    Raw mBits;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Returns the nearest raw value, ties away from zero
+    //!
+    //! \param value    The value
+    //!
+    //! \return Raw The raw value, saturated
+    //!
+    static Raw toRaw(const double value)
+    {
+        const double lower = static_cast<double>(std::numeric_limits<Raw>::min());
+        const double upper = static_cast<double>(std::numeric_limits<Raw>::max());
+
+        const double scaled = std::round(value * static_cast<double>(1ULL << FracBits));
+
+        Raw result = 0;
+
+        if (scaled <= lower)
+        {
+            result = std::numeric_limits<Raw>::min();
+        }
+        else if (scaled >= upper)
+        {
+            result = std::numeric_limits<Raw>::max();
+        }
+        else if (scaled == scaled)
+        {
+            result = static_cast<Raw>(scaled);
+        }
+        else
+        {
+            // NaN
+        }
+
+        return result;
+    }
+};
+
+//!
+//! \brief Signed Q0.15 fixed-point value
+//!
+typedef Fixed<int16_t, 15> Q15;
+
+//!
+//! \brief Signed Q0.31 fixed-point value
+//!
+typedef Fixed<int32_t, 31> Q31;
+
+//------------------------ Static member definitions ---------------------------
+
+template <typename Raw, std::size_t FracBits>
+const std::size_t Fixed<Raw, FracBits>::FRACTION_BITS;
+}
+
+#endif
@@ -0,0 +1,379 @@
+#ifndef BIT_PACKED_H
+#define BIT_PACKED_H
+
+//!
+//! \file bit_packed.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Densely packed arrays of fixed width unsigned integers
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Element i is the field at offset i * Bits (the Buffer bit
+//!             order, see extractField). The storage carries PACKED_PADDING
+//!             bytes past the last element, so every get() and set() is one
+//!             unaligned 64-bit load (and store) without a bounds branch
+//!
+//! \note       unpack() extracts eight 9 to 25-bit elements per AVX2 step
+//!             (one byte shuffle and one variable shift) when the CPU
+//!             supports it. pack() streams the elements through a 64-bit
+//!             accumulator, 32 bits per store
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_field.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Bytes past the last element of a packed array
+//!
+const std::size_t PACKED_PADDING = sizeof(uint64_t) - 1UL;
+
+//!
+//! \brief Widest element of a packed array (one 64-bit load at any shift)
+//!
+const std::size_t PACKED_MAX_BITS = U64_BIT_COUNT - (U08_BIT_COUNT - 1UL);
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Returns the storage size of a packed array
+//!
+//! \param bits     The element width
+//! \param count    The number of elements
+//!
+//! \return std::size_t The byte size, padding included
+//!
+inline std::size_t packedSize(const std::size_t bits, const std::size_t count)
+{
+    return (((count * bits) + U08_BIT_COUNT - 1UL) / U08_BIT_COUNT) + PACKED_PADDING;
+}
+
+//!
+//! \brief Extracts consecutive elements of a packed array
+//!
+//! \param data     The storage
+//! \param size     The byte size of the storage (packedSize() at least)
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//! \param output   The elements
+//!
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint8_t* output);
+
+//!
+//! \brief Extracts consecutive elements of a packed array
+//!
+//! \param data     The storage
+//! \param size     The byte size of the storage (packedSize() at least)
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//! \param output   The elements
+//!
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint16_t* output);
+
+//!
+//! \brief Extracts consecutive elements of a packed array
+//!
+//! \param data     The storage
+//! \param size     The byte size of the storage (packedSize() at least)
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//! \param output   The elements
+//!
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint32_t* output);
+
+//!
+//! \brief Extracts consecutive elements of a packed array
+//!
+//! \param data     The storage
+//! \param size     The byte size of the storage (packedSize() at least)
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//! \param output   The elements
+//!
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint64_t* output);
+
+//!
+//! \brief Inserts consecutive elements into a packed array
+//!
+//! \param input    The elements (upper bits are ignored)
+//! \param data     The storage
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//!
+//! \note   The bits around the range are kept
+//!
+void packFields(const uint8_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count);
+
+//!
+//! \brief Inserts consecutive elements into a packed array
+//!
+//! \param input    The elements (upper bits are ignored)
+//! \param data     The storage
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//!
+void packFields(const uint16_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count);
+
+//!
+//! \brief Inserts consecutive elements into a packed array
+//!
+//! \param input    The elements (upper bits are ignored)
+//! \param data     The storage
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//!
+void packFields(const uint32_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count);
+
+//!
+//! \brief Inserts consecutive elements into a packed array
+//!
+//! \param input    The elements (upper bits are ignored)
+//! \param data     The storage
+//! \param bits     The element width (1 - PACKED_MAX_BITS)
+//! \param first    The first element
+//! \param count    The number of elements
+//!
+void packFields(const uint64_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count);
+
+//!
+//! \brief Packed array of Bits wide unsigned integers over caller storage
+//!
+template <std::size_t Bits>
+class PackedArray
+{
+public:
+
+    static_assert((Bits >= 1UL) && (Bits <= PACKED_MAX_BITS), "Invalid element width");
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Smallest unsigned type holding an element
+    //!
+    typedef typename std::conditional<(Bits <= U08_BIT_COUNT), uint8_t,
+            typename std::conditional<(Bits <= U16_BIT_COUNT), uint16_t,
+            typename std::conditional<(Bits <= U32_BIT_COUNT), uint32_t,
+                                      uint64_t>::type>::type>::type Type;
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Element width
+    //!
+    static const std::size_t BITS = Bits;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Returns the storage size of an array
+    //!
+    //! \param count    The number of elements
+    //!
+    //! \return std::size_t The byte size, padding included
+    //!
+    static std::size_t storageSize(const std::size_t count)
+    {
+        return packedSize(Bits, count);
+    }
+
+    //!
+    //! \brief Constructs a packed array over caller storage
+    //!
+    //! \param data     The storage (storageSize(count) bytes)
+    //! \param count    The number of elements
+    //!
+    PackedArray(uint8_t* data, const std::size_t count)
+        : mData(data)
+        , mCount(count)
+    {
+    }
+
+    //!
+    //! \brief Destroys a packed array, the storage is kept
+    //!
+    ~PackedArray()
+    {
+    }
+
+    //!
+    //! \brief Returns the number of elements
+    //!
+    //! \return std::size_t The number of elements
+    //!
+    std::size_t size() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns the storage
+    //!
+    //! \return const uint8_t*  The packed elements
+    //!
+    const uint8_t* data() const
+    {
+        return mData;
+    }
+
+    //!
+    //! \brief Returns an element
+    //!
+    //! \param i    The element index (less than size())
+    //!
+    //! \return Type    The element
+    //!
+    Type get(const std::size_t i) const
+    {
+        const std::size_t offset = i * Bits;
+
+        return static_cast<Type>((loadU64(&mData[offset / U08_BIT_COUNT]) <<
+                                  (offset % U08_BIT_COUNT)) >> (U64_BIT_COUNT - Bits));
+    }
+
+    //!
+    //! \brief Replaces an element
+    //!
+    //! \param i        The element index (less than size())
+    //! \param value    The element (upper bits are ignored)
+    //!
+    void set(const std::size_t i, const Type value)
+    {
+        const std::size_t offset = i * Bits;
+
+        const std::size_t left = U64_BIT_COUNT - (offset % U08_BIT_COUNT) - Bits;
+
+        const uint64_t mask = (~0ULL >> (U64_BIT_COUNT - Bits)) << left;
+
+        uint8_t* word = &mData[offset / U08_BIT_COUNT];
+
+        storeU64(word, (loadU64(word) & ~mask) | ((static_cast<uint64_t>(value) << left) & mask));
+    }
+
+    //!
+    //! \brief Extracts consecutive elements
+    //!
+    //! \param first    The first element
+    //! \param count    The number of elements (clamped to size())
+    //! \param output   The elements
+    //!
+    void unpack(const std::size_t first, const std::size_t count, Type* output) const
+    {
+        if (first < mCount)
+        {
+            unpackFields(mData, storageSize(mCount), Bits, first,
+                         ((mCount - first) < count) ? (mCount - first) : count, output);
+        }
+    }
+
+    //!
+    //! \brief Replaces consecutive elements
+    //!
+    //! \param input    The elements (upper bits are ignored)
+    //! \param first    The first element
+    //! \param count    The number of elements (clamped to size())
+    //!
+    void pack(const Type* input, const std::size_t first, const std::size_t count)
+    {
+        if (first < mCount)
+        {
+            packFields(input, mData, Bits, first,
+                       ((mCount - first) < count) ? (mCount - first) : count);
+        }
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Element storage
+    //!
+    uint8_t* mData;
+
+    //!
+    //! \brief Number of elements
+    //!
+    const std::size_t mCount;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    PackedArray(const PackedArray&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    PackedArray& operator=(const PackedArray&);
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <std::size_t Bits>
+const std::size_t PackedArray<Bits>::BITS;
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef BIT_PLAN_H
+#define BIT_PLAN_H
+
+//!
+//! \file bit_plan.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Selective decode of a subset of the signals of a frame
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A consumer registers the signals it needs, each bound to its
+//!             destination variable. The plan keeps them sorted by buffer
+//!             position, so a decode walks the frame once, front to back,
+//!             and touches only the words holding the requested signals
+//!
+//! \note       Every decode writes the same destination variables, so a plan
+//!             serves a single consumer thread. Parallel consumers (i.e.
+//!             Scheduler workers) shall each own a plan of their own
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+#include "bit_field.h"
+#include "bit_recorder.h"
+
+namespace bit
+{
+template <std::size_t Capacity = 16UL>
+class DecodePlan
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the decode plan
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty plan
+    //!
+    DecodePlan()
+        : mCount(0UL)
+        , mSize(0UL)
+        , mStatus(Ok)
+    {
+    }
+
+    //!
+    //! \brief Destroys a decode plan object
+    //!
+    ~DecodePlan()
+    {
+    }
+
+    //!
+    //! \brief Returns the status of the plan
+    //!
+    //! \return Status  (Ok | Overflow)
+    //!
+    Status status() const
+    {
+        return mStatus;
+    }
+
+    //!
+    //! \brief Returns the number of requested signals
+    //!
+    //! \return std::size_t The signal count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns the minimum byte size of a frame holding every signal
+    //!
+    //! \return std::size_t The frame size
+    //!
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    //!
+    //! \brief Requests a signal, inserted in buffer position order
+    //!
+    //! \param destination  The variable updated by every decode
+    //!
+    //! \return Status  Ok, Overflow if the plan is full (not added)
+    //!
+    template <typename SignalType>
+    Status add(typename SignalType::Type& destination)
+    {
+        typedef Field<SignalType> Layout;
+
+        Status result = Overflow;
+
+        if (mCount < Capacity)
+        {
+            std::size_t i = mCount;
+
+            while ((i > 0UL) && (mEntries[i - 1UL].offset > Layout::OFFSET))
+            {
+                mEntries[i] = mEntries[i - 1UL];
+
+                i--;
+            }
+
+            mEntries[i].offset = Layout::OFFSET;
+            mEntries[i].width = Layout::WIDTH;
+            mEntries[i].store = &storeValue<typename SignalType::Type>;
+            mEntries[i].destination = &destination;
+
+            mSize = (Layout::END > mSize) ? Layout::END : mSize;
+
+            mCount++;
+
+            result = Ok;
+        }
+        else
+        {
+            mStatus = Overflow;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Removes every requested signal
+    //!
+    void clear()
+    {
+        mCount = 0UL;
+        mSize = 0UL;
+        mStatus = Ok;
+    }
+
+    //!
+    //! \brief Decodes the requested signals of a frame
+    //!
+    //! \param data The frame bytes
+    //! \param size The byte size of the frame
+    //!
+    //! \return Status  Ok, Overflow if the frame is shorter than size(), the
+    //!                 missing bits are decoded as zero
+    //!
+    Status decode(const uint8_t* data, const std::size_t size) const
+    {
+        BIT_TIME(DecodeCycles);
+        BIT_COUNT(FramesDecoded, 1ULL);
+        BIT_COUNT(SignalReads, mCount);
+        BIT_RECORD_BEGIN();
+
+        for (std::size_t i = 0UL; i < mCount; i++)
+        {
+            const Entry& entry = mEntries[i];
+
+            BIT_COUNT_ACCESS(entry.offset);
+
+            entry.store(extractField(data, size, entry.offset, entry.width),
+                        entry.width,
+                        entry.destination);
+        }
+
+        const Status result = (size < mSize) ? Overflow : Ok;
+
+        BIT_RECORD_END(FrameDecode, Recorder::frame(), mCount, result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Decodes the requested signals of a bit buffer
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return Status  Ok, Overflow if the frame is shorter than size()
+    //!
+    template <std::size_t Size>
+    Status decode(const Buffer<Size>& frame) const
+    {
+        return decode(frame.data(), Size);
+    }
+
+    //!
+    //! \brief Decodes the requested signals of a viewed frame
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return Status  Ok, Overflow if the frame is shorter than size()
+    //!
+    Status decode(const BufferView& frame) const
+    {
+        return decode(frame.data(), frame.size());
+    }
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Converts the field bits and stores them in the destination
+    //!
+    typedef void (*StoreFunction)(const uint64_t raw,
+                                  const std::size_t width,
+                                  void* destination);
+
+    //!
+    //! \brief Requested signal
+    //!
+    struct Entry
+    {
+        //!
+        //! \brief Field offset
+        //!
+        std::size_t offset;
+
+        //!
+        //! \brief Field width
+        //!
+        std::size_t width;
+
+        //!
+        //! \brief Conversion to the value type
+        //!
+        StoreFunction store;
+
+        //!
+        //! \brief Destination variable
+        //!
+        void* destination;
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Requested signals, sorted by field offset
+    //!
+    Entry mEntries[Capacity];
+
+    //!
+    //! \brief Number of requested signals
+    //!
+    std::size_t mCount;
+
+    //!
+    //! \brief Minimum byte size of a frame
+    //!
+    std::size_t mSize;
+
+    //!
+    //! \brief Returns the current status of the plan
+    //!
+    Status mStatus;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Store function of a value type
+    //!
+    template <typename T>
+    static void storeValue(const uint64_t raw,
+                           const std::size_t width,
+                           void* destination)
+    {
+        fieldValue(raw, width, *static_cast<T*>(destination));
+    }
+};
+}
+
+#endif
@@ -0,0 +1,386 @@
+#ifndef BIT_RECORDER_H
+#define BIT_RECORDER_H
+
+//!
+//! \file bit_recorder.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Per-thread flight recorder of codec events
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Every thread owns a ring of the last RECORDER_EVENTS events.
+//!             Recording an event is a release fence, four relaxed stores
+//!             and two release stores, without locks or allocation. Every
+//!             slot carries the sequence of its event, collect() and dump()
+//!             drop the events unfinished or overwritten while they were
+//!             being copied
+//!
+//! \note       The ring of an exiting thread is handed to the next new thread,
+//!             live threads beyond RECORDER_MAX_THREADS - 1 share the last
+//!             ring
+//!
+//! \note       The library encode and decode paths record through the
+//!             BIT_RECORD_BEGIN, BIT_RECORD_END and BIT_RECORD_OVERFLOW
+//!             macros, compiled out unless BIT_INSTRUMENTATION is defined
+//!             (see bit_counters.h)
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_counters.h"
+
+//----------------------------- Public macros ----------------------------------
+
+#if defined(BIT_INSTRUMENTATION)
+
+#define BIT_RECORD_BEGIN() const uint64_t bitRecordStart = bit::Counters::cycles()
+#define BIT_RECORD_END(operation, frame, signal, status) \
+        bit::Recorder::record((operation), (frame), (signal), \
+                              bit::Counters::cycles() - bitRecordStart, (status))
+#define BIT_RECORD_OVERFLOW(index) \
+        bit::Recorder::record(bit::BufferOverflow, bit::Recorder::frame(), (index), 0ULL, 1UL)
+
+#else
+
+#define BIT_RECORD_BEGIN() ((void) 0)
+#define BIT_RECORD_END(operation, frame, signal, status) ((void) 0)
+#define BIT_RECORD_OVERFLOW(index) ((void) 0)
+
+#endif
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Codec operations
+//!
+enum Operation
+{
+    SignalEncode = 0,
+    SignalDecode,
+    FrameDecode,
+    FramePublish,
+    FrameWrite,
+    BufferOverflow,
+    UserEvent
+};
+
+//!
+//! \brief Number of events of every thread ring (power of 2)
+//!
+const std::size_t RECORDER_EVENTS = 1024UL;
+
+//!
+//! \brief Number of thread rings
+//!
+const std::size_t RECORDER_MAX_THREADS = 32UL;
+
+static_assert(RECORDER_MAX_THREADS <= 64UL, "Free rings are tracked in 64 bits");
+
+//!
+//! \brief Dump file identifier ("BREC")
+//!
+const uint32_t RECORDER_MAGIC = 0x43455242UL;
+
+//!
+//! \brief Dump file format version
+//!
+const uint16_t RECORDER_VERSION = 1U;
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Recorded event (24 bytes)
+//!
+struct RecorderEvent
+{
+    //!
+    //! \brief Counters::cycles() at the end of the operation
+    //!
+    uint64_t timestamp;
+
+    //!
+    //! \brief Frame id (setFrame(), capture index or bus sequence)
+    //!
+    uint32_t frame;
+
+    //!
+    //! \brief Duration in cycles
+    //!
+    uint32_t duration;
+
+    //!
+    //! \brief Signal id (field offset, slot, signal count or overflow index)
+    //!
+    uint16_t signal;
+
+    //!
+    //! \brief Ring (thread) that recorded the event
+    //!
+    uint16_t thread;
+
+    //!
+    //! \brief Operation
+    //!
+    uint8_t operation;
+
+    //!
+    //! \brief Status of the operation (0 Ok)
+    //!
+    uint8_t status;
+
+    //!
+    //! \brief Reserved, zero
+    //!
+    uint16_t reserved;
+};
+
+//!
+//! \brief Header at the start of a dump file, followed by eventCount events
+//!
+struct RecorderHeader
+{
+    //!
+    //! \brief RECORDER_MAGIC
+    //!
+    uint32_t magic;
+
+    //!
+    //! \brief RECORDER_VERSION
+    //!
+    uint16_t version;
+
+    //!
+    //! \brief Byte size of an event
+    //!
+    uint16_t eventSize;
+
+    //!
+    //! \brief Number of events
+    //!
+    uint64_t eventCount;
+};
+
+class Recorder
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of a dump
+    //!
+    enum Status
+    {
+        Ok = 0,
+        OpenError,
+        WriteError
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Records an event in the ring of the calling thread
+    //!
+    //! \param operation    The operation
+    //! \param frame        The frame id
+    //! \param signal       The signal id
+    //! \param duration     The duration in cycles (saturated to 32 bits)
+    //! \param status       The status of the operation
+    //!
+    static void record(const Operation operation,
+                       const uint64_t frame,
+                       const std::size_t signal,
+                       const uint64_t duration,
+                       const std::size_t status)
+    {
+        Ring& ring = local();
+
+        const bool shared = isShared(ring);
+
+        const uint64_t head = shared ?
+                              ring.head.fetch_add(1ULL, std::memory_order_relaxed) :
+                              ring.head.load(std::memory_order_relaxed);
+
+        std::atomic<uint64_t>* slot = ring.slots[head & (RECORDER_EVENTS - 1UL)];
+
+        const uint64_t time = (duration < 0xFFFFFFFFULL) ? duration : 0xFFFFFFFFULL;
+
+        // The slot is marked busy before it is overwritten, collect() then
+        // detects the overwrite
+        slot[3].store(0ULL, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot[0].store(Counters::cycles(), std::memory_order_relaxed);
+        slot[1].store((frame & 0xFFFFFFFFULL) | (time << U32_BIT_COUNT),
+                      std::memory_order_relaxed);
+        slot[2].store((static_cast<uint64_t>(signal) & 0xFFFFULL) |
+                      (static_cast<uint64_t>(operation & 0xFFU) << U16_BIT_COUNT) |
+                      (static_cast<uint64_t>(status & 0xFFUL) << (U16_BIT_COUNT + U08_BIT_COUNT)),
+                      std::memory_order_relaxed);
+
+        slot[3].store(head + 1ULL, std::memory_order_release);
+
+        if (!shared)
+        {
+            ring.head.store(head + 1ULL, std::memory_order_release);
+        }
+    }
+
+    //!
+    //! \brief Sets the frame id of the events recorded by the calling thread
+    //!         on paths without a frame identity of their own
+    //!
+    //! \param frame    The frame id (capture index, sequence number...)
+    //!
+    static void setFrame(const uint64_t frame)
+    {
+        tFrame = frame;
+    }
+
+    //!
+    //! \brief Returns the frame id set by the calling thread
+    //!
+    //! \return uint64_t    The frame id, 0 if never set
+    //!
+    static uint64_t frame()
+    {
+        return tFrame;
+    }
+
+    //!
+    //! \brief Returns the number of rings in use
+    //!
+    //! \return std::size_t The number of threads that recorded an event
+    //!
+    static std::size_t threads();
+
+    //!
+    //! \brief Copies the retained events of a ring, oldest first
+    //!
+    //! \details    Events being written or overwritten are skipped
+    //!
+    //! \param thread   The ring index (0 - threads()-1)
+    //! \param events   The events (RECORDER_EVENTS capacity)
+    //!
+    //! \return std::size_t The number of events copied
+    //!
+    static std::size_t collect(const std::size_t thread, RecorderEvent* events);
+
+    //!
+    //! \brief Writes the retained events of every ring to a file
+    //!
+    //! \param path The file path (created or truncated)
+    //!
+    //! \return Status  Ok, OpenError or WriteError
+    //!
+    static Status dump(const char* path);
+
+    //!
+    //! \brief Drops the events of every ring
+    //!
+    //! \note   Not safe against concurrent recording
+    //!
+    static void reset();
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Event ring of a thread
+    //!
+    struct alignas(CACHE_LINE_SIZE) Ring
+    {
+        //!
+        //! \brief Number of events ever recorded
+        //!
+        std::atomic<uint64_t> head;
+
+        //!
+        //! \brief Packed events (timestamp, frame and duration, the rest,
+        //!        event index + 1 once written, 0 while written)
+        //!
+        std::atomic<uint64_t> slots[RECORDER_EVENTS][4];
+    };
+
+    //!
+    //! \brief Returns the ring of its thread to the free rings on exit
+    //!
+    struct Release
+    {
+        //!
+        //! \brief Frees the ring of the exiting thread
+        //!
+        ~Release();
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Event rings
+    //!
+    static Ring sRings[RECORDER_MAX_THREADS];
+
+    //!
+    //! \brief Number of rings handed out
+    //!
+    static std::atomic<std::size_t> sThreads;
+
+    //!
+    //! \brief Rings of exited threads (bit i set if sRings[i] is free)
+    //!
+    static std::atomic<uint64_t> sFree;
+
+    //!
+    //! \brief Ring of the calling thread, 0 until its first event
+    //!
+    static thread_local Ring* tRing;
+
+    //!
+    //! \brief Frame id of the calling thread
+    //!
+    static thread_local uint64_t tFrame;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Hands out the ring of the calling thread
+    //!
+    static Ring& attach();
+
+    //!
+    //! \brief Returns true for the last ring, shared by the extra threads
+    //!
+    static bool isShared(const Ring& ring)
+    {
+        return (&ring == &sRings[RECORDER_MAX_THREADS - 1UL]);
+    }
+
+    //!
+    //! \brief Returns the ring of the calling thread
+    //!
+    static Ring& local()
+    {
+        Ring* ring = tRing;
+
+        return (ring != 0) ? *ring : attach();
+    }
+};
+}
+
+#endif
@@ -0,0 +1,769 @@
+#ifndef BIT_RING_H
+#define BIT_RING_H
+
+//!
+//! \file bit_ring.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Lock-free fixed capacity rings of bit buffer slots
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Producers may write frames in place: reserve() hands out a
+//!             cleared slot of the ring and commit() publishes it. Consumers
+//!             decode in place with front() and free the slots with release()
+//!
+//! \note       Slots are cache line aligned, rings shall be allocated
+//!             statically or with an allocator honouring the alignment
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+
+#include <atomic>
+
+namespace bit
+{
+//!
+//! \brief Single producer, single consumer ring
+//!
+template <std::size_t Size, std::size_t Capacity>
+class SpscRing
+{
+    static_assert((Capacity != 0UL) && ((Capacity & (Capacity - 1UL)) == 0UL),
+                  "Ring capacity shall be a power of two");
+
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty ring
+    //!
+    SpscRing()
+        : mTail(0UL)
+        , mHeadCache(0UL)
+        , mReserved(0UL)
+        , mHead(0UL)
+        , mTailCache(0UL)
+        , mSlots()
+    {
+    }
+
+    //!
+    //! \brief Destroys a ring object
+    //!
+    ~SpscRing()
+    {
+    }
+
+    //!
+    //! \brief Returns the number of slots of the ring
+    //!
+    //! \return std::size_t The capacity
+    //!
+    std::size_t capacity() const
+    {
+        return Capacity;
+    }
+
+    //!
+    //! \brief Returns the number of published frames (approximate if called
+    //!        while the other side is running)
+    //!
+    //! \return std::size_t The frame count
+    //!
+    std::size_t size() const
+    {
+        return mTail.load(std::memory_order_acquire) -
+               mHead.load(std::memory_order_acquire);
+    }
+
+    //!
+    //! \brief Reserves a cleared slot to be written in place (producer)
+    //!
+    //! \return Buffer<Size>*   The slot, null if the ring is full
+    //!
+    Buffer<Size>* reserve()
+    {
+        Buffer<Size>* result = 0;
+
+        (void) reserve(&result, 1UL);
+
+        return result;
+    }
+
+    //!
+    //! \brief Reserves up to count cleared slots (producer)
+    //!
+    //! \param frames   The reserved slots
+    //! \param count    The number of slots wanted
+    //!
+    //! \return std::size_t The number of slots reserved
+    //!
+    std::size_t reserve(Buffer<Size>** frames, const std::size_t count)
+    {
+        const std::size_t pos = mTail.load(std::memory_order_relaxed) + mReserved;
+
+        std::size_t available = Capacity - (pos - mHeadCache);
+
+        if (available < count)
+        {
+            mHeadCache = mHead.load(std::memory_order_acquire);
+
+            available = Capacity - (pos - mHeadCache);
+        }
+
+        const std::size_t result = (available < count) ? available : count;
+
+        for (std::size_t i = 0UL; i < result; i++)
+        {
+            frames[i] = &mSlots[(pos + i) & MASK].frame;
+
+            frames[i]->clear();
+        }
+
+        mReserved += result;
+
+        return result;
+    }
+
+    //!
+    //! \brief Publishes the oldest reserved slot (producer)
+    //!
+    //! \param frame    The slot, slots are published in reservation order
+    //!
+    void commit(Buffer<Size>* frame)
+    {
+        (void) frame;
+
+        commit(1UL);
+    }
+
+    //!
+    //! \brief Publishes reserved slots (producer)
+    //!
+    //! \param frames   The slots, slots are published in reservation order
+    //! \param count    The number of slots
+    //!
+    void commit(Buffer<Size>* const* frames, const std::size_t count)
+    {
+        (void) frames;
+
+        commit(count);
+    }
+
+    //!
+    //! \brief Publishes the oldest reserved slots (producer)
+    //!
+    //! \param count    The number of slots to publish
+    //!
+    void commit(const std::size_t count)
+    {
+        const std::size_t n = (count < mReserved) ? count : mReserved;
+
+        mReserved -= n;
+
+        mTail.store(mTail.load(std::memory_order_relaxed) + n,
+                    std::memory_order_release);
+    }
+
+    //!
+    //! \brief Copies a frame into the ring (producer)
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return bool    True if the frame was queued, false if the ring is full
+    //!                 or slots are reserved and not yet committed
+    //!
+    bool push(const Buffer<Size>& frame)
+    {
+        return (push(&frame, 1UL) == 1UL);
+    }
+
+    //!
+    //! \brief Copies a batch of frames into the ring (producer)
+    //!
+    //! \param frames   The frames
+    //! \param count    The number of frames
+    //!
+    //! \return std::size_t The number of frames queued, 0 while slots are
+    //!                     reserved and not yet committed (the slots are
+    //!                     published in order, the pushed frames would
+    //!                     publish the reserved slots instead)
+    //!
+    std::size_t push(const Buffer<Size>* frames, const std::size_t count)
+    {
+        const std::size_t pos = mTail.load(std::memory_order_relaxed);
+
+        std::size_t available = 0UL;
+
+        if (0UL == mReserved)
+        {
+            available = Capacity - (pos - mHeadCache);
+
+            if (available < count)
+            {
+                mHeadCache = mHead.load(std::memory_order_acquire);
+
+                available = Capacity - (pos - mHeadCache);
+            }
+        }
+
+        const std::size_t result = (available < count) ? available : count;
+
+        for (std::size_t i = 0UL; i < result; i++)
+        {
+            mSlots[(pos + i) & MASK].frame = frames[i];
+        }
+
+        mReserved += result;
+
+        commit(result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the oldest published frame (consumer)
+    //!
+    //! \return Buffer<Size>*   The frame, null if the ring is empty
+    //!
+    Buffer<Size>* front()
+    {
+        Buffer<Size>* result = 0;
+
+        (void) front(&result, 1UL);
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns up to count of the oldest published frames (consumer)
+    //!
+    //! \param frames   The frames, to be decoded in place
+    //! \param count    The number of frames wanted
+    //!
+    //! \return std::size_t The number of frames returned
+    //!
+    std::size_t front(Buffer<Size>** frames, const std::size_t count)
+    {
+        const std::size_t pos = mHead.load(std::memory_order_relaxed);
+
+        std::size_t available = mTailCache - pos;
+
+        if (available < count)
+        {
+            mTailCache = mTail.load(std::memory_order_acquire);
+
+            available = mTailCache - pos;
+        }
+
+        const std::size_t result = (available < count) ? available : count;
+
+        for (std::size_t i = 0UL; i < result; i++)
+        {
+            frames[i] = &mSlots[(pos + i) & MASK].frame;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Frees the oldest frames returned by front() (consumer)
+    //!
+    //! \param count    The number of frames to free
+    //!
+    void release(const std::size_t count = 1UL)
+    {
+        mHead.store(mHead.load(std::memory_order_relaxed) + count,
+                    std::memory_order_release);
+    }
+
+    //!
+    //! \brief Copies the oldest frame out of the ring (consumer)
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return bool    True if a frame was dequeued, false if the ring is empty
+    //!
+    bool pop(Buffer<Size>& frame)
+    {
+        return (pop(&frame, 1UL) == 1UL);
+    }
+
+    //!
+    //! \brief Copies a batch of the oldest frames out of the ring (consumer)
+    //!
+    //! \param frames   The frames
+    //! \param count    The capacity of frames
+    //!
+    //! \return std::size_t The number of frames dequeued
+    //!
+    std::size_t pop(Buffer<Size>* frames, const std::size_t count)
+    {
+        const std::size_t pos = mHead.load(std::memory_order_relaxed);
+
+        std::size_t available = mTailCache - pos;
+
+        if (available < count)
+        {
+            mTailCache = mTail.load(std::memory_order_acquire);
+
+            available = mTailCache - pos;
+        }
+
+        const std::size_t result = (available < count) ? available : count;
+
+        for (std::size_t i = 0UL; i < result; i++)
+        {
+            frames[i] = mSlots[(pos + i) & MASK].frame;
+        }
+
+        release(result);
+
+        return result;
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Slot index mask
+    //!
+    static const std::size_t MASK = Capacity - 1UL;
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Cache line aligned frame slot
+    //!
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        //!
+        //! \brief The frame
+        //!
+        Buffer<Size> frame;
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Next slot to publish (written by the producer)
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> mTail;
+
+    //!
+    //! \brief Last head seen by the producer
+    //!
+    std::size_t mHeadCache;
+
+    //!
+    //! \brief Number of reserved, not yet published slots
+    //!
+    std::size_t mReserved;
+
+    //!
+    //! \brief Next slot to consume (written by the consumer)
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> mHead;
+
+    //!
+    //! \brief Last tail seen by the consumer
+    //!
+    std::size_t mTailCache;
+
+    //!
+    //! \brief Frame slots
+    //!
+    Slot mSlots[Capacity];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    SpscRing(const SpscRing&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    SpscRing& operator=(const SpscRing&);
+};
+
+//!
+//! \brief Multiple producer, single consumer ring
+//!
+//! \details    Every slot carries a sequence number, producers claim slots
+//!             with a CAS on the tail and publish them independently, so a
+//!             slow producer never blocks the slots of another one
+//!
+template <std::size_t Size, std::size_t Capacity>
+class MpscRing
+{
+    static_assert((Capacity != 0UL) && ((Capacity & (Capacity - 1UL)) == 0UL),
+                  "Ring capacity shall be a power of two");
+
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty ring
+    //!
+    MpscRing()
+        : mTail(0UL)
+        , mHead(0UL)
+        , mSlots()
+    {
+        for (std::size_t i = 0UL; i < Capacity; i++)
+        {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    //!
+    //! \brief Destroys a ring object
+    //!
+    ~MpscRing()
+    {
+    }
+
+    //!
+    //! \brief Returns the number of slots of the ring
+    //!
+    //! \return std::size_t The capacity
+    //!
+    std::size_t capacity() const
+    {
+        return Capacity;
+    }
+
+    //!
+    //! \brief Returns the number of claimed slots, published or not
+    //!        (approximate if called while the ring is in use)
+    //!
+    //! \return std::size_t The slot count
+    //!
+    std::size_t size() const
+    {
+        return mTail.load(std::memory_order_acquire) -
+               mHead.load(std::memory_order_acquire);
+    }
+
+    //!
+    //! \brief Reserves a cleared slot to be written in place (producer)
+    //!
+    //! \return Buffer<Size>*   The slot, null if the ring is full
+    //!
+    Buffer<Size>* reserve()
+    {
+        Buffer<Size>* result = 0;
+
+        (void) reserve(&result, 1UL);
+
+        return result;
+    }
+
+    //!
+    //! \brief Reserves up to count consecutive cleared slots (producer)
+    //!
+    //! \param frames   The reserved slots
+    //! \param count    The number of slots wanted
+    //!
+    //! \return std::size_t The number of slots reserved
+    //!
+    std::size_t reserve(Buffer<Size>** frames, const std::size_t count)
+    {
+        std::size_t pos = mTail.load(std::memory_order_relaxed);
+
+        std::size_t result = 0UL;
+
+        bool isDone = (0UL == count);
+
+        while (!isDone)
+        {
+            // Slots behind the head are free for this lap
+            const std::size_t used = pos - mHead.load(std::memory_order_acquire);
+
+            if (used > Capacity)
+            {
+                // Other producers and the consumer moved past a stale tail
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                const std::size_t available = Capacity - used;
+
+                result = (available < count) ? available : count;
+
+                isDone = (0UL == result) ||
+                         mTail.compare_exchange_weak(pos, pos + result,
+                                                     std::memory_order_relaxed);
+            }
+        }
+
+        for (std::size_t i = 0UL; i < result; i++)
+        {
+            frames[i] = &mSlots[(pos + i) & MASK].frame;
+
+            frames[i]->clear();
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Publishes a reserved slot (producer)
+    //!
+    //! \param frame    The slot returned by reserve()
+    //!
+    void commit(Buffer<Size>* frame)
+    {
+        commit(&frame, 1UL);
+    }
+
+    //!
+    //! \brief Publishes reserved slots (producer)
+    //!
+    //! \param frames   The slots returned by reserve()
+    //! \param count    The number of slots
+    //!
+    void commit(Buffer<Size>* const* frames, const std::size_t count)
+    {
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            // The frame is the first member of its slot
+            Slot* slot = reinterpret_cast<Slot*>(frames[i]);
+
+            const std::size_t pos = slot->sequence.load(std::memory_order_relaxed);
+
+            slot->sequence.store(pos + 1UL, std::memory_order_release);
+        }
+    }
+
+    //!
+    //! \brief Copies a frame into the ring (producer)
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return bool    True if the frame was queued, false if the ring is full
+    //!
+    bool push(const Buffer<Size>& frame)
+    {
+        return (push(&frame, 1UL) == 1UL);
+    }
+
+    //!
+    //! \brief Copies a batch of frames into consecutive slots (producer)
+    //!
+    //! \param frames   The frames
+    //! \param count    The number of frames
+    //!
+    //! \return std::size_t The number of frames queued
+    //!
+    std::size_t push(const Buffer<Size>* frames, const std::size_t count)
+    {
+        Buffer<Size>* slots[BATCH_SIZE];
+
+        std::size_t result = 0UL;
+
+        bool isDone = false;
+
+        while (!isDone && (result < count))
+        {
+            const std::size_t wanted = ((count - result) < BATCH_SIZE) ?
+                                       (count - result) : BATCH_SIZE;
+
+            const std::size_t n = reserve(slots, wanted);
+
+            for (std::size_t i = 0UL; i < n; i++)
+            {
+                *slots[i] = frames[result + i];
+            }
+
+            commit(slots, n);
+
+            result += n;
+
+            isDone = (n < wanted);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the oldest published frame (consumer)
+    //!
+    //! \return Buffer<Size>*   The frame, null if the ring is empty
+    //!
+    Buffer<Size>* front()
+    {
+        Buffer<Size>* result = 0;
+
+        (void) front(&result, 1UL);
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns up to count of the oldest published frames (consumer)
+    //!
+    //! \param frames   The frames, to be decoded in place
+    //! \param count    The number of frames wanted
+    //!
+    //! \return std::size_t The number of consecutive published frames
+    //!
+    std::size_t front(Buffer<Size>** frames, const std::size_t count)
+    {
+        const std::size_t pos = mHead.load(std::memory_order_relaxed);
+
+        std::size_t result = 0UL;
+
+        while ((result < count) &&
+               (mSlots[(pos + result) & MASK].sequence.load(
+                        std::memory_order_acquire) == (pos + result + 1UL)))
+        {
+            frames[result] = &mSlots[(pos + result) & MASK].frame;
+
+            result++;
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Frees the oldest frames returned by front() (consumer)
+    //!
+    //! \param count    The number of frames to free
+    //!
+    void release(const std::size_t count = 1UL)
+    {
+        const std::size_t pos = mHead.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            mSlots[(pos + i) & MASK].sequence.store(pos + i + Capacity,
+                                                    std::memory_order_relaxed);
+        }
+
+        mHead.store(pos + count, std::memory_order_release);
+    }
+
+    //!
+    //! \brief Copies the oldest frame out of the ring (consumer)
+    //!
+    //! \param frame    The frame
+    //!
+    //! \return bool    True if a frame was dequeued, false if the ring is empty
+    //!
+    bool pop(Buffer<Size>& frame)
+    {
+        return (pop(&frame, 1UL) == 1UL);
+    }
+
+    //!
+    //! \brief Copies a batch of the oldest frames out of the ring (consumer)
+    //!
+    //! \param frames   The frames
+    //! \param count    The capacity of frames
+    //!
+    //! \return std::size_t The number of frames dequeued
+    //!
+    std::size_t pop(Buffer<Size>* frames, const std::size_t count)
+    {
+        const std::size_t pos = mHead.load(std::memory_order_relaxed);
+
+        std::size_t result = 0UL;
+
+        while ((result < count) &&
+               (mSlots[(pos + result) & MASK].sequence.load(
+                        std::memory_order_acquire) == (pos + result + 1UL)))
+        {
+            frames[result] = mSlots[(pos + result) & MASK].frame;
+
+            result++;
+        }
+
+        release(result);
+
+        return result;
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Slot index mask
+    //!
+    static const std::size_t MASK = Capacity - 1UL;
+
+    //!
+    //! \brief Number of slots reserved at once by push()
+    //!
+    static const std::size_t BATCH_SIZE = 16UL;
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Cache line aligned frame slot
+    //!
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        //!
+        //! \brief The frame (first member, see commit())
+        //!
+        Buffer<Size> frame;
+
+        //!
+        //! \brief Position of the slot: pos when free, pos + 1 when published
+        //!
+        std::atomic<std::size_t> sequence;
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Next slot to claim (shared by the producers)
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> mTail;
+
+    //!
+    //! \brief Next slot to consume (written by the consumer)
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> mHead;
+
+    //!
+    //! \brief Frame slots
+    //!
+    Slot mSlots[Capacity];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    MpscRing(const MpscRing&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    MpscRing& operator=(const MpscRing&);
+};
+}
+
+#endif
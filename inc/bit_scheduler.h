@@ -0,0 +1,353 @@
+#ifndef BIT_SCHEDULER_H
+#define BIT_SCHEDULER_H
+
+//!
+//! \file bit_scheduler.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Multi-channel decode scheduler with work stealing
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Frames are submitted per channel and grouped into batches.
+//!             Every sealed batch is queued to the home worker of its
+//!             channel, idle workers steal batches from the queues of busy
+//!             workers so a hot channel spreads across the pool
+//!
+//! \note       POSIX only (threads), not available on Generic targets
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bit
+{
+class Scheduler
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of a scheduler operation
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Full,
+        InvalidChannel,
+        Stopped
+    };
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Decode plan of a channel
+    //!
+    //! \param context  The channel context
+    //! \param worker   The index of the worker thread (0 - workers-1)
+    //! \param frame    The frame to decode
+    //!
+    typedef void (*DecodeFunction)(void* context,
+                                   const std::size_t worker,
+                                   BufferView& frame);
+
+    //!
+    //! \brief Run time statistics of a channel
+    //!
+    struct ChannelStatistics
+    {
+        //!
+        //! \brief Frames submitted and not decoded yet (queue depth)
+        //!
+        std::size_t depth;
+
+        //!
+        //! \brief Frames accepted by submit()
+        //!
+        uint64_t submitted;
+
+        //!
+        //! \brief Frames decoded
+        //!
+        uint64_t decoded;
+
+        //!
+        //! \brief Frames rejected because every batch of the channel was busy
+        //!
+        uint64_t dropped;
+
+        //!
+        //! \brief Mean submit to decode latency (ns)
+        //!
+        uint64_t latencyMean;
+
+        //!
+        //! \brief Maximum submit to decode latency (ns)
+        //!
+        uint64_t latencyMax;
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a stopped scheduler
+    //!
+    //! \param workers      The number of worker threads
+    //! \param frameSize    The byte size of every frame
+    //! \param batchSize    The number of frames of a batch
+    //! \param batches      The number of batches of every channel
+    //!
+    Scheduler(const std::size_t workers,
+              const std::size_t frameSize,
+              const std::size_t batchSize = 32UL,
+              const std::size_t batches = 64UL);
+
+    //!
+    //! \brief Destroys the scheduler, stopping the workers
+    //!
+    ~Scheduler();
+
+    //!
+    //! \brief Adds a channel (before start())
+    //!
+    //! \param function The decode plan of the channel
+    //! \param context  The context of the decode plan
+    //!
+    //! \return std::size_t The channel index
+    //!
+    std::size_t addChannel(DecodeFunction function, void* context);
+
+    //!
+    //! \brief Adds a channel decoded by a plan object (before start())
+    //!
+    //! \param plan The plan, called concurrently as plan(worker, frame)
+    //!
+    //! \return std::size_t The channel index
+    //!
+    template <typename Plan>
+    std::size_t addChannel(Plan& plan)
+    {
+        return addChannel(&decodePlan<Plan>, &plan);
+    }
+
+    //!
+    //! \brief Starts the worker threads
+    //!
+    void start();
+
+    //!
+    //! \brief Stops the worker threads, open and queued batches are decoded
+    //!        first
+    //!
+    //! \note   Shall be called once the feeding threads stopped submitting
+    //!
+    void stop();
+
+    //!
+    //! \brief Copies a frame into the open batch of a channel
+    //!
+    //! \param channel  The channel index
+    //! \param data     The frame bytes (frameSize bytes)
+    //!
+    //! \return Status  Ok, Full if the frame was dropped, Stopped if the
+    //!                 scheduler is not running
+    //!
+    //! \note   Each channel shall be fed by a single thread, after start()
+    //!
+    Status submit(const std::size_t channel, const uint8_t* data);
+
+    //!
+    //! \brief Copies a bit buffer into the open batch of a channel
+    //!
+    //! \param channel  The channel index
+    //! \param frame    The frame, its size must be the scheduler frame size
+    //!
+    //! \return Status  Ok, Full if the frame was dropped
+    //!
+    template <std::size_t Size>
+    Status submit(const std::size_t channel, const Buffer<Size>& frame)
+    {
+        Status result = Full;
+
+        if (Size == mFrameSize)
+        {
+            result = submit(channel, frame.data());
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Queues the partially filled batch of a channel
+    //!
+    //! \param channel  The channel index (called from its feeding thread)
+    //!
+    //! \note   Nothing is queued while the scheduler is not running
+    //!
+    void flush(const std::size_t channel);
+
+    //!
+    //! \brief Flushes every channel and waits until every frame is decoded
+    //!
+    void wait();
+
+    //!
+    //! \brief Returns the run time statistics of a channel
+    //!
+    //! \param channel  The channel index
+    //!
+    //! \return ChannelStatistics   The statistics
+    //!
+    ChannelStatistics statistics(const std::size_t channel) const;
+
+    //!
+    //! \brief Returns the queue depth of a channel
+    //!
+    //! \param channel  The channel index
+    //!
+    //! \return std::size_t Frames submitted and not decoded yet
+    //!
+    std::size_t depth(const std::size_t channel) const;
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    struct Batch;
+    struct Channel;
+    struct Worker;
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Byte size of a frame
+    //!
+    std::size_t mFrameSize;
+
+    //!
+    //! \brief Number of frames of a batch
+    //!
+    std::size_t mBatchSize;
+
+    //!
+    //! \brief Number of batches of a channel
+    //!
+    std::size_t mBatchCount;
+
+    //!
+    //! \brief Channels
+    //!
+    std::vector<Channel*> mChannels;
+
+    //!
+    //! \brief Batches of every channel (mBatchCount per channel)
+    //!
+    std::vector<Batch*> mBatches;
+
+    //!
+    //! \brief Worker run queues
+    //!
+    std::vector<Worker*> mWorkers;
+
+    //!
+    //! \brief Worker threads
+    //!
+    std::vector<std::thread> mThreads;
+
+    //!
+    //! \brief Cleared to stop the workers
+    //!
+    std::atomic<bool> mIsRunning;
+
+    //!
+    //! \brief Number of sleeping workers
+    //!
+    std::atomic<std::size_t> mSleepers;
+
+    //!
+    //! \brief Protects the sleep of the workers
+    //!
+    std::mutex mMutex;
+
+    //!
+    //! \brief Wakes up sleeping workers
+    //!
+    std::condition_variable mWakeUp;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    Scheduler(const Scheduler&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    Scheduler& operator=(const Scheduler&);
+
+    //!
+    //! \brief Queues the open batch of a channel
+    //!
+    //! \param channel  The channel
+    //!
+    void seal(Channel& channel);
+
+    //!
+    //! \brief Decodes the frames of a batch
+    //!
+    //! \param worker   The index of the worker
+    //! \param task     The batch index
+    //!
+    void process(const std::size_t worker, const std::size_t task);
+
+    //!
+    //! \brief Takes a batch from the own queue or steals one
+    //!
+    //! \param worker   The index of the worker
+    //! \param task     The batch index
+    //!
+    //! \return bool    True if a batch was found
+    //!
+    bool take(const std::size_t worker, std::size_t& task);
+
+    //!
+    //! \brief Worker thread main loop
+    //!
+    //! \param worker   The index of the worker
+    //!
+    void run(const std::size_t worker);
+
+    //!
+    //! \brief Decode function of a plan object
+    //!
+    template <typename Plan>
+    static void decodePlan(void* context,
+                           const std::size_t worker,
+                           BufferView& frame)
+    {
+        (*static_cast<Plan*>(context))(worker, frame);
+    }
+};
+}
+
+#endif
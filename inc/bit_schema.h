@@ -0,0 +1,424 @@
+#ifndef BIT_SCHEMA_H
+#define BIT_SCHEMA_H
+
+//!
+//! \file bit_schema.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Run time signal layouts and their flat decode table
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       A Schema is loaded from a text description, one signal per
+//!             line and '#' comments:
+//!
+//!                 # name      position  width  type      order     scale  offset
+//!                 speed       7         16     unsigned  motorola  0.01   0
+//!                 trim        16        12     signed    intel
+//!
+//!             Types are bool, unsigned, signed, float (32 bits), double
+//!             (64 bits), half and bfloat16 (16 bits). Motorola positions
+//!             follow Signal (BitPos, the bit of the most significant bit, 7
+//!             being the MSB of byte 0). Intel positions are the bit of the
+//!             least significant bit, bit 0 being the LSB of byte 0. Scale
+//!             and offset are optional
+//!
+//! \note       DecodeTable::compile() turns a schema into a flat array of
+//!             32-byte entries holding the precomputed byte, shift and mask
+//!             of every signal, decoded with one 64-bit load each
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_base.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Maximum number of signals of a schema
+//!
+const std::size_t SCHEMA_MAX_SIGNALS = 128UL;
+
+//!
+//! \brief Maximum length of a signal name (terminator included)
+//!
+const std::size_t SCHEMA_NAME_SIZE = 32UL;
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Value type of a run time signal
+//!
+enum ValueType
+{
+    Boolean = 0,
+    Unsigned,
+    Signed,
+    Float32,
+    Float64,
+    Float16,
+    BFloat16
+};
+
+//!
+//! \brief Byte order of a run time signal
+//!
+enum ByteOrder
+{
+    Motorola = 0,
+    Intel
+};
+
+//!
+//! \brief Run time layout of a signal
+//!
+struct SchemaSignal
+{
+    //!
+    //! \brief Signal name
+    //!
+    char name[SCHEMA_NAME_SIZE];
+
+    //!
+    //! \brief Bit position (MSB for Motorola, LSB for Intel)
+    //!
+    uint32_t position;
+
+    //!
+    //! \brief Bit width (1-64)
+    //!
+    uint32_t width;
+
+    //!
+    //! \brief Value type
+    //!
+    ValueType type;
+
+    //!
+    //! \brief Byte order
+    //!
+    ByteOrder order;
+
+    //!
+    //! \brief Physical value = raw value * scale + offset
+    //!
+    double scale;
+
+    //!
+    //! \brief Physical value = raw value * scale + offset
+    //!
+    double offset;
+};
+
+class Schema
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of a schema operation
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow,
+        SyntaxError,
+        RangeError,
+        OpenError
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty schema
+    //!
+    Schema();
+
+    //!
+    //! \brief Destroys a schema object
+    //!
+    ~Schema();
+
+    //!
+    //! \brief Removes every signal
+    //!
+    void clear();
+
+    //!
+    //! \brief Adds a signal
+    //!
+    //! \param signal   The signal layout
+    //!
+    //! \return Status  Ok, Overflow if full, RangeError if the width does not
+    //!                 suit the type
+    //!
+    Status add(const SchemaSignal& signal);
+
+    //!
+    //! \brief Adds the signals of a text description
+    //!
+    //! \param text The description, null terminated
+    //! \param line The line of the error (1 based), 0 if Ok
+    //!
+    //! \return Status  Ok, SyntaxError, RangeError or Overflow
+    //!
+    Status load(const char* text, std::size_t& line);
+
+    //!
+    //! \brief Adds the signals of a text description file
+    //!
+    //! \param path The file path
+    //! \param line The line of the error (1 based), 0 if Ok
+    //!
+    //! \return Status  Ok, OpenError, SyntaxError, RangeError or Overflow
+    //!
+    Status loadFile(const char* path, std::size_t& line);
+
+    //!
+    //! \brief Returns the number of signals
+    //!
+    //! \return std::size_t The signal count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns a signal layout
+    //!
+    //! \param i    The signal index (0 - count()-1)
+    //!
+    //! \return const SchemaSignal& The signal layout
+    //!
+    const SchemaSignal& signal(const std::size_t i) const
+    {
+        return mSignals[i];
+    }
+
+    //!
+    //! \brief Finds a signal by name
+    //!
+    //! \param name The signal name
+    //!
+    //! \return std::size_t The signal index, count() if not found
+    //!
+    std::size_t find(const char* name) const;
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Signal layouts
+    //!
+    SchemaSignal mSignals[SCHEMA_MAX_SIGNALS];
+
+    //!
+    //! \brief Number of signals
+    //!
+    std::size_t mCount;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Parses one line of a text description
+    //!
+    //! \param text The line, not null terminated
+    //! \param size The byte size of the line
+    //!
+    //! \return Status  Ok, SyntaxError, RangeError or Overflow
+    //!
+    Status parse(const char* text, const std::size_t size);
+};
+
+class DecodeTable
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the decode table
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs an empty decode table
+    //!
+    DecodeTable();
+
+    //!
+    //! \brief Destroys a decode table object
+    //!
+    ~DecodeTable();
+
+    //!
+    //! \brief Precomputes the decode entries of every signal of a schema
+    //!
+    //! \param schema   The schema, entry i decodes signal i
+    //!
+    void compile(const Schema& schema);
+
+    //!
+    //! \brief Returns the number of entries
+    //!
+    //! \return std::size_t The entry count
+    //!
+    std::size_t count() const
+    {
+        return mCount;
+    }
+
+    //!
+    //! \brief Returns the minimum byte size of a frame holding every signal
+    //!
+    //! \return std::size_t The frame size
+    //!
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    //!
+    //! \brief Decodes the raw field bits of every signal
+    //!
+    //! \param data The frame bytes
+    //! \param size The byte size of the frame
+    //! \param raw  The field bits of every signal (count() values), signed
+    //!             fields sign extended
+    //!
+    //! \return Status  Ok, Overflow if the frame is shorter than size(), the
+    //!                 missing bits are decoded as zero
+    //!
+    Status decodeRaw(const uint8_t* data, const std::size_t size, uint64_t* raw) const;
+
+    //!
+    //! \brief Decodes the physical value of every signal
+    //!
+    //! \param data     The frame bytes
+    //! \param size     The byte size of the frame
+    //! \param values   The scaled values of every signal (count() values)
+    //!
+    //! \return Status  Ok, Overflow if the frame is shorter than size()
+    //!
+    Status decode(const uint8_t* data, const std::size_t size, double* values) const;
+
+    //!
+    //! \brief Decodes the physical value of one signal
+    //!
+    //! \param i    The entry index (0 - count()-1)
+    //! \param data The frame bytes
+    //! \param size The byte size of the frame
+    //!
+    //! \return double  The scaled value
+    //!
+    double value(const std::size_t i, const uint8_t* data, const std::size_t size) const;
+
+private:
+
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Precomputed decode of a signal (32 bytes)
+    //!
+    struct Entry
+    {
+        //!
+        //! \brief First byte of the 64-bit window
+        //!
+        uint32_t byte;
+
+        //!
+        //! \brief Right shift of the window (Motorola: to the field LSB)
+        //!
+        uint8_t shift;
+
+        //!
+        //! \brief Field width
+        //!
+        uint8_t width;
+
+        //!
+        //! \brief ValueType
+        //!
+        uint8_t type;
+
+        //!
+        //! \brief Flags (ByteOrder, wide field)
+        //!
+        uint8_t flags;
+
+        //!
+        //! \brief Field mask, right aligned
+        //!
+        uint64_t mask;
+
+        //!
+        //! \brief Scale of the physical value
+        //!
+        double scale;
+
+        //!
+        //! \brief Offset of the physical value
+        //!
+        double offset;
+    };
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Decode entries, in schema order
+    //!
+    Entry mEntries[SCHEMA_MAX_SIGNALS];
+
+    //!
+    //! \brief Number of entries
+    //!
+    std::size_t mCount;
+
+    //!
+    //! \brief Minimum byte size of a frame
+    //!
+    std::size_t mSize;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Extracts the field bits of an entry
+    //!
+    static uint64_t extract(const Entry& entry,
+                            const uint8_t* data,
+                            const std::size_t size);
+
+    //!
+    //! \brief Converts the field bits of an entry to its physical value
+    //!
+    static double convert(const Entry& entry, const uint64_t raw);
+};
+}
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef BIT_SHARED_BUFFER_H
+#define BIT_SHARED_BUFFER_H
+
+//!
+//! \file bit_shared_buffer.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Seqlock protected bit buffer, one writer and many readers
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The writer never waits. Readers never lock, they copy the
+//!             words they need and retry if the writer published in the
+//!             meantime, so every read is a consistent frame
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+#include "bit_field.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace bit
+{
+template <std::size_t Size>
+class SharedBuffer
+{
+public:
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a cleared shared buffer
+    //!
+    SharedBuffer()
+        : mSequence(0U)
+        , mFrame()
+        , mWords()
+    {
+        for (std::size_t i = 0UL; i < WORD_COUNT; i++)
+        {
+            mWords[i].store(0ULL, std::memory_order_relaxed);
+        }
+    }
+
+    //!
+    //! \brief Destroys a shared buffer object
+    //!
+    ~SharedBuffer()
+    {
+    }
+
+    //!
+    //! \brief Returns the writer copy of the frame (writer)
+    //!
+    //! \details    The frame is updated in place with the Buffer API and
+    //!             made visible to the readers with publish()
+    //!
+    //! \return Buffer<Size>&   The writer frame
+    //!
+    Buffer<Size>& frame()
+    {
+        return mFrame;
+    }
+
+    //!
+    //! \brief Publishes the writer frame (writer)
+    //!
+    void publish()
+    {
+        BIT_COUNT(FramesEncoded, 1ULL);
+
+        publish(0UL, WORD_COUNT);
+    }
+
+    //!
+    //! \brief Replaces and publishes the frame (writer)
+    //!
+    //! \param frame    The new frame
+    //!
+    void write(const Buffer<Size>& frame)
+    {
+        mFrame = frame;
+
+        publish();
+    }
+
+    //!
+    //! \brief Updates one signal in place and publishes it (writer)
+    //!
+    //! \param value    The new signal value
+    //!
+    //! \note   Only the words holding the signal are published
+    //!
+    template <typename SignalType>
+    void write(const typename SignalType::Type& value)
+    {
+        typedef Field<SignalType> Layout;
+
+        Layout::write(mFrame.data(), Size, value);
+
+        publish(Layout::OFFSET / U64_BIT_COUNT,
+                ((Layout::OFFSET + Layout::WIDTH - 1UL) / U64_BIT_COUNT) + 1UL);
+    }
+
+    //!
+    //! \brief Takes a consistent copy of the frame (reader)
+    //!
+    //! \param frame    The copy
+    //!
+    void snapshot(Buffer<Size>& frame) const
+    {
+        uint64_t words[WORD_COUNT];
+
+        load(words, 0UL, WORD_COUNT);
+
+        (void) std::memcpy(frame.data(), words, Size);
+    }
+
+    //!
+    //! \brief Reads one signal of a consistent frame (reader)
+    //!
+    //! \return Type    The signal value
+    //!
+    //! \note   Only the words holding the signal are copied
+    //!
+    template <typename SignalType>
+    typename SignalType::Type read() const
+    {
+        typedef Field<SignalType> Layout;
+
+        const std::size_t first = Layout::OFFSET / U64_BIT_COUNT;
+        const std::size_t last = (Layout::OFFSET + Layout::WIDTH - 1UL) /
+                                 U64_BIT_COUNT;
+
+        uint64_t words[2] = {0ULL, 0ULL};
+
+        load(words, first, (last - first) + 1UL);
+
+        typename SignalType::Type result;
+
+        fieldValue(extractField(reinterpret_cast<const uint8_t*>(words),
+                                sizeof(words),
+                                Layout::OFFSET - (first * U64_BIT_COUNT),
+                                Layout::WIDTH),
+                   Layout::WIDTH,
+                   result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns the number of publications so far
+    //!
+    //! \return uint32_t    The version of the frame
+    //!
+    uint32_t version() const
+    {
+        return mSequence.load(std::memory_order_acquire) / 2U;
+    }
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Number of 64-bit words holding the frame
+    //!
+    static const std::size_t WORD_COUNT = (Size + sizeof(uint64_t) - 1UL) /
+                                          sizeof(uint64_t);
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Sequence counter, odd while the writer is publishing
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> mSequence;
+
+    //!
+    //! \brief Writer copy of the frame
+    //!
+    Buffer<Size> mFrame;
+
+    //!
+    //! \brief Published frame
+    //!
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> mWords[WORD_COUNT];
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    SharedBuffer(const SharedBuffer&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    SharedBuffer& operator=(const SharedBuffer&);
+
+    //!
+    //! \brief Publishes the words [first, last) of the writer frame
+    //!
+    //! \param first    The first word
+    //! \param last     One past the last word
+    //!
+    void publish(const std::size_t first, const std::size_t last)
+    {
+        const std::size_t end = (last < WORD_COUNT) ? last : WORD_COUNT;
+
+        uint64_t words[WORD_COUNT];
+
+        // Only the range is copied, the last frame word is zero padded
+        if (first < end)
+        {
+            const std::size_t offset = first * sizeof(uint64_t);
+            const std::size_t bytes = end * sizeof(uint64_t);
+
+            words[end - 1UL] = 0ULL;
+
+            (void) std::memcpy(&words[first], &mFrame.data()[offset],
+                               ((bytes < Size) ? bytes : Size) - offset);
+        }
+
+        const uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+
+        mSequence.store(sequence + 1U, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = first; i < end; i++)
+        {
+            mWords[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        mSequence.store(sequence + 2U, std::memory_order_release);
+    }
+
+    //!
+    //! \brief Copies consistent published words, retrying on a publication
+    //!
+    //! \param words    The copy
+    //! \param first    The first word
+    //! \param count    The number of words
+    //!
+    void load(uint64_t* words, const std::size_t first, const std::size_t count) const
+    {
+        bool isConsistent = false;
+
+        while (!isConsistent)
+        {
+            const uint32_t begin = mSequence.load(std::memory_order_acquire);
+
+            for (std::size_t i = 0UL; i < count; i++)
+            {
+                words[i] = ((first + i) < WORD_COUNT) ?
+                           mWords[first + i].load(std::memory_order_relaxed) : 0ULL;
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            const uint32_t end = mSequence.load(std::memory_order_relaxed);
+
+            isConsistent = ((begin & 1U) == 0U) && (begin == end);
+        }
+    }
+};
+
+//------------------------ Static member definitions ---------------------------
+
+template <std::size_t Size>
+const std::size_t SharedBuffer<Size>::WORD_COUNT;
+}
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef BIT_SHM_BUS_H
+#define BIT_SHM_BUS_H
+
+//!
+//! \file bit_shm_bus.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Cross-process shared memory frame bus
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       The segment is a ShmBusHeader, a control cache line and a
+//!             table of slots. Every slot holds one frame protected by its
+//!             own sequence counter (seqlock), so one producer per slot
+//!             publishes while any number of processes read it in place.
+//!             Consumers block on a futex bumped on every publication
+//!
+//! \note       POSIX only (shm_open, mmap), not available on Generic targets.
+//!             The futex and anonymous (memfd) segments are Linux only, other
+//!             systems poll
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer_view.h"
+#include "bit_field.h"
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Shared memory bus identifier ("BSHM")
+//!
+const uint32_t SHM_BUS_MAGIC = 0x4D485342UL;
+
+//!
+//! \brief Shared memory bus layout version
+//!
+const uint16_t SHM_BUS_VERSION = 1U;
+
+//----------------------------- Public types -----------------------------------
+
+//!
+//! \brief Header at the start of a shared memory bus segment
+//!
+struct ShmBusHeader
+{
+    //!
+    //! \brief SHM_BUS_MAGIC
+    //!
+    uint32_t magic;
+
+    //!
+    //! \brief SHM_BUS_VERSION
+    //!
+    uint16_t version;
+
+    //!
+    //! \brief Reserved, zero
+    //!
+    uint16_t reserved;
+
+    //!
+    //! \brief Byte size of a frame
+    //!
+    uint32_t frameSize;
+
+    //!
+    //! \brief Byte size of a slot (sequence, frame and padding)
+    //!
+    uint32_t slotSize;
+
+    //!
+    //! \brief Number of slots
+    //!
+    uint64_t slotCount;
+};
+
+class ShmBus
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Possible status of the shared memory bus
+    //!
+    enum Status
+    {
+        Ok = 0,
+        OpenError,
+        MapError,
+        FormatError,
+        InvalidSlot
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a detached bus
+    //!
+    ShmBus();
+
+    //!
+    //! \brief Destroys the bus, detaching from the segment
+    //!
+    ~ShmBus();
+
+    //!
+    //! \brief Creates a segment and attaches to it
+    //!
+    //! \param name         The shm_open name ("/name"), 0 for an anonymous
+    //!                     segment shared through descriptor()
+    //! \param frameSize    The byte size of every frame
+    //! \param slotCount    The number of frame slots
+    //!
+    //! \return Status  Ok if the segment was created (or already existed with
+    //!                 this layout) and mapped, FormatError if it exists with
+    //!                 another layout
+    //!
+    //! \note   An existing named segment is attached as is, never
+    //!         re-initialized, since other processes may have it mapped.
+    //!         unlink() it first to start from zeroed slots
+    //!
+    Status create(const char* name,
+                  const std::size_t frameSize,
+                  const std::size_t slotCount);
+
+    //!
+    //! \brief Attaches to an existing named segment
+    //!
+    //! \param name The shm_open name ("/name")
+    //!
+    //! \return Status  Ok if the segment was mapped and the header is valid
+    //!
+    Status open(const char* name);
+
+    //!
+    //! \brief Attaches to an existing segment by descriptor (i.e. inherited
+    //!        or received over a UNIX socket)
+    //!
+    //! \param file The segment descriptor, duplicated
+    //!
+    //! \return Status  Ok if the segment was mapped and the header is valid
+    //!
+    Status open(const int file);
+
+    //!
+    //! \brief Detaches from the segment, every view is invalidated
+    //!
+    void close();
+
+    //!
+    //! \brief Removes a named segment, attached processes keep their mapping
+    //!
+    //! \param name The shm_open name ("/name")
+    //!
+    static void unlink(const char* name);
+
+    //!
+    //! \brief Returns the descriptor of the segment
+    //!
+    //! \return int The descriptor, -1 if detached
+    //!
+    int descriptor() const
+    {
+        return mFile;
+    }
+
+    //!
+    //! \brief Returns the number of frame slots
+    //!
+    //! \return std::size_t The slot count
+    //!
+    std::size_t count() const
+    {
+        return mSlotCount;
+    }
+
+    //!
+    //! \brief Returns the byte size of the frames
+    //!
+    //! \return std::size_t The frame size
+    //!
+    std::size_t frameSize() const
+    {
+        return mFrameSize;
+    }
+
+    //!
+    //! \brief Publishes a frame into a slot and notifies the consumers
+    //!
+    //! \param slot The slot index (0 - count()-1)
+    //! \param data The frame bytes (frameSize bytes)
+    //!
+    //! \return Status  Ok, InvalidSlot if out of range
+    //!
+    //! \note   Each slot shall be published by a single thread at a time.
+    //!         A publication left incomplete by a producer that died is
+    //!         taken over and completed by the next one
+    //!
+    Status publish(const std::size_t slot, const uint8_t* data);
+
+    //!
+    //! \brief Publishes a bit buffer into a slot and notifies the consumers
+    //!
+    //! \param slot     The slot index (0 - count()-1)
+    //! \param frame    The frame, its size must be the bus frame size
+    //!
+    //! \return Status  Ok, InvalidSlot if out of range or of other size
+    //!
+    template <std::size_t Size>
+    Status publish(const std::size_t slot, const Buffer<Size>& frame)
+    {
+        Status result = InvalidSlot;
+
+        if (Size == mFrameSize)
+        {
+            result = publish(slot, frame.data());
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Copies a consistent frame out of a slot
+    //!
+    //! \param slot The slot index (0 - count()-1)
+    //! \param data The frame copy (frameSize bytes)
+    //!
+    //! \return Status  Ok, InvalidSlot if out of range
+    //!
+    Status snapshot(const std::size_t slot, uint8_t* data) const;
+
+    //!
+    //! \brief Copies a consistent frame out of a slot into a bit buffer
+    //!
+    //! \param slot     The slot index (0 - count()-1)
+    //! \param frame    The frame copy, its size must be the bus frame size
+    //!
+    //! \return Status  Ok, InvalidSlot if out of range or of other size
+    //!
+    template <std::size_t Size>
+    Status snapshot(const std::size_t slot, Buffer<Size>& frame) const
+    {
+        Status result = InvalidSlot;
+
+        if (Size == mFrameSize)
+        {
+            result = snapshot(slot, frame.data());
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Reads one signal of a consistent frame, copying only the words
+    //!        holding it
+    //!
+    //! \param slot The slot index (0 - count()-1), not checked
+    //!
+    //! \return Type    The signal value
+    //!
+    template <typename SignalType>
+    typename SignalType::Type read(const std::size_t slot) const
+    {
+        typedef Field<SignalType> Layout;
+
+        const std::size_t first = Layout::OFFSET / U64_BIT_COUNT;
+        const std::size_t last = (Layout::OFFSET + Layout::WIDTH - 1UL) /
+                                 U64_BIT_COUNT;
+
+        uint64_t words[2] = {0ULL, 0ULL};
+
+        load(slot, first, (last - first) + 1UL,
+             reinterpret_cast<uint8_t*>(words), sizeof(words));
+
+        typename SignalType::Type result;
+
+        fieldValue(extractField(reinterpret_cast<const uint8_t*>(words),
+                                sizeof(words),
+                                Layout::OFFSET - (first * U64_BIT_COUNT),
+                                Layout::WIDTH),
+                   Layout::WIDTH,
+                   result);
+
+        return result;
+    }
+
+    //!
+    //! \brief Returns a zero-copy view of the frame of a slot
+    //!
+    //! \param slot The slot index (0 - count()-1), not checked
+    //!
+    //! \return BufferView  The frame view, valid until close()
+    //!
+    //! \note   The view reads the slot in place while it may be published.
+    //!         Take version() before decoding and check isCurrent() after
+    //!         it, decode again if it is not
+    //!
+    BufferView view(const std::size_t slot) const
+    {
+        return BufferView(&mSlots[(slot * mSlotSize) + SEQUENCE_SIZE],
+                          mFrameSize);
+    }
+
+    //!
+    //! \brief Returns the version of a slot, waiting a bounded time for a
+    //!        publication in progress to complete
+    //!
+    //! \param slot The slot index (0 - count()-1), not checked
+    //!
+    //! \return uint32_t    The slot version, odd if the publication did not
+    //!                     complete in time (isCurrent() is then false)
+    //!
+    //! \note   A slot stays odd if its producer died mid-write, until a new
+    //!         producer publishes it again. snapshot() and read() wait for
+    //!         that publication
+    //!
+    uint32_t version(const std::size_t slot) const;
+
+    //!
+    //! \brief Checks that a slot was not published since version()
+    //!
+    //! \param slot     The slot index (0 - count()-1), not checked
+    //! \param version  The value returned by version()
+    //!
+    //! \return bool    True if everything read since version() is consistent,
+    //!                 false for an odd version
+    //!
+    bool isCurrent(const std::size_t slot, const uint32_t version) const;
+
+    //!
+    //! \brief Returns the number of publications on the bus (wraps around)
+    //!
+    //! \return uint32_t    The notification counter
+    //!
+    uint32_t notifications() const;
+
+    //!
+    //! \brief Waits until the bus is published after a given notification
+    //!
+    //! \param seen     The last value returned by notifications()
+    //! \param timeout  The maximum wait (ms)
+    //!
+    //! \return bool    True if there were publications since seen
+    //!
+    bool wait(const uint32_t seen, const uint32_t timeout) const;
+
+private:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Byte size of the slot sequence counter (word aligned)
+    //!
+    static const std::size_t SEQUENCE_SIZE = sizeof(uint64_t);
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Segment descriptor
+    //!
+    int mFile;
+
+    //!
+    //! \brief Start of the mapped segment
+    //!
+    uint8_t* mMap;
+
+    //!
+    //! \brief Byte size of the mapping
+    //!
+    std::size_t mLength;
+
+    //!
+    //! \brief First byte of the first slot
+    //!
+    uint8_t* mSlots;
+
+    //!
+    //! \brief Number of slots
+    //!
+    std::size_t mSlotCount;
+
+    //!
+    //! \brief Byte size of a frame
+    //!
+    std::size_t mFrameSize;
+
+    //!
+    //! \brief Byte size of a slot
+    //!
+    std::size_t mSlotSize;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    ShmBus(const ShmBus&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    ShmBus& operator=(const ShmBus&);
+
+    //!
+    //! \brief Maps a segment descriptor and validates its header
+    //!
+    //! \param file The segment descriptor, owned on success
+    //!
+    //! \return Status  Ok if the segment was mapped and the header is valid
+    //!
+    Status attach(const int file);
+
+    //!
+    //! \brief Copies consistent words of a slot, retrying on a publication
+    //!
+    //! \param slot     The slot index
+    //! \param first    The first word
+    //! \param count    The number of words
+    //! \param data     The copy
+    //! \param size     The byte size of the copy (up to count words)
+    //!
+    void load(const std::size_t slot,
+              const std::size_t first,
+              const std::size_t count,
+              uint8_t* data,
+              const std::size_t size) const;
+};
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 //---------------------------- Include files -----------------------------------
 
+#include "bit_numeric.h"
 #include "bit_signal_data.h"
 
 //!
@@ -54,6 +55,25 @@ class Signal : public SignalData
 {
 public:
 
+    //---------------------------- Member types --------------------------------
+
+    //!
+    //! \brief Value type of the signal
+    //!
+    typedef T Type;
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Bit position of the most significant bit of the signal
+    //!
+    static const std::size_t BIT_POSITION = BitPos;
+
+    //!
+    //! \brief Number of bits the signal occupies in the buffer
+    //!
+    static const std::size_t BIT_WIDTH = typeBitSize(T);
+
     //--------------------------- Member methods -------------------------------
 
     //!
@@ -98,6 +118,9 @@ public:
     //!
     //! \return T   The signal value
     //!
+    //! \note   Signed integers narrower than T are sign extended from their
+    //!         most significant bit, as Field reads them
+    //!
     void read(T& value)
     {
         read_(value);
@@ -121,7 +144,8 @@ private:
     //! \brief Bytes used by the signal in the buffer
     //!
     static const std::size_t BYTE_SIZE =
-            (BIT_OFFSET + typeBitSize(T) + BIT_MAX_POS) / U08_BIT_COUNT;
+            ((BIT_MAX_POS - BIT_OFFSET) + typeBitSize(T) + BIT_MAX_POS) /
+            U08_BIT_COUNT;
 
     //------------------------- Member variables -------------------------------
 
@@ -206,6 +230,26 @@ private:
         return ((sizeof(T) * U08_BIT_COUNT) - BitSize);
     }
 
+    //!
+    //! \brief Sign extends a value read from the BitSize bits of the buffer
+    //!
+    //! \param data The value, right aligned
+    //!
+    //! \return uint32_t    The value with the sign bit (BitSize - 1) copied to
+    //!                     every upper bit
+    //!
+    uint32_t signExtend(const uint32_t data) const
+    {
+        uint32_t result = data;
+
+        if ((BitSize < U32_BIT_COUNT) && (((data >> (BitSize - 1UL)) & 1UL) != 0UL))
+        {
+            result |= static_cast<uint32_t>(~0ULL << BitSize);
+        }
+
+        return result;
+    }
+
     //!
     //! \brief Helper method to write an 8-bit array
     //!
@@ -265,7 +309,11 @@ private:
     //!
     void read_(int8_t& value)
     {
-        read_(static_cast<uint8_t>(value));
+        uint8_t data;
+
+        read_(data);
+
+        value = static_cast<int8_t>(signExtend(data));
     }
 
     //!
@@ -305,7 +353,11 @@ private:
     //!
     void read_(int16_t& value)
     {
-        read_(static_cast<uint16_t>(value));
+        uint16_t data;
+
+        read_(data);
+
+        value = static_cast<int16_t>(signExtend(data));
     }
 
     //!
@@ -349,7 +401,11 @@ private:
     //!
     void read_(int32_t& value)
     {
-        read_(static_cast<uint32_t>(value));
+        uint32_t data;
+
+        read_(data);
+
+        value = static_cast<int32_t>(signExtend(data));
     }
 
     //!
@@ -426,14 +482,94 @@ private:
         //!             in order to write the data to the buffer
         //!
         //lint -e925 -e9110 -e9176
-        const void* address = static_cast<const void*>(&value);
+        void* address = static_cast<void*>(&value);
 
-        const uint32_t* data = static_cast<const uint32_t*>(address);
+        uint32_t* data = static_cast<uint32_t*>(address);
         //lint +e925 +e9110 +e9176
 
         read_(*data);
     }
 
+    //!
+    //! \brief Helper method to write a half precision floating point
+    //!
+    //! \param value    The half precision floating point
+    //!
+    void write_(const Half& value)
+    {
+        write_(value.bits());
+    }
+
+    //!
+    //! \brief Helper method to read a half precision floating point
+    //!
+    //! \param value    The half precision floating point
+    //!
+    void read_(Half& value)
+    {
+        uint16_t data;
+
+        read_(data);
+
+        value = Half::fromBits(data);
+    }
+
+    //!
+    //! \brief Helper method to write a bfloat16 floating point
+    //!
+    //! \param value    The bfloat16 floating point
+    //!
+    void write_(const BrainFloat& value)
+    {
+        write_(value.bits());
+    }
+
+    //!
+    //! \brief Helper method to read a bfloat16 floating point
+    //!
+    //! \param value    The bfloat16 floating point
+    //!
+    void read_(BrainFloat& value)
+    {
+        uint16_t data;
+
+        read_(data);
+
+        value = BrainFloat::fromBits(data);
+    }
+
+    //!
+    //! \brief Helper method to write a fixed-point value
+    //!
+    //! \param value    The fixed-point value
+    //!
+    template<typename Raw, std::size_t FracBits>
+    void write_(const Fixed<Raw, FracBits>& value)
+    {
+        write_(value.bits());
+    }
+
+    //!
+    //! \brief Helper method to read a fixed-point value
+    //!
+    //! \param value    The fixed-point value, sign extended if signed
+    //!
+    template<typename Raw, std::size_t FracBits>
+    void read_(Fixed<Raw, FracBits>& value)
+    {
+        typedef typename std::make_unsigned<Raw>::type Bits;
+
+        Raw data;
+
+        read_(data);
+
+        // The field bits are moved up to the sign bit and back
+        const Bits shifted = static_cast<Bits>(static_cast<Bits>(data) << bitMaskShift());
+
+        value = Fixed<Raw, FracBits>::fromBits(static_cast<Raw>(static_cast<Raw>(shifted) >>
+                                                                bitMaskShift()));
+    }
+
     //!
     //! \brief Helper method to write a double precision floating point
     //!
@@ -492,6 +628,14 @@ private:
         (void) data;
     }
 };
+
+//------------------------ Static member definitions ---------------------------
+
+template<typename T, const std::size_t BitPos, const std::size_t BitSize>
+const std::size_t Signal<T, BitPos, BitSize>::BIT_POSITION;
+
+template<typename T, const std::size_t BitPos, const std::size_t BitSize>
+const std::size_t Signal<T, BitPos, BitSize>::BIT_WIDTH;
 }
 
 #endif
@@ -0,0 +1,169 @@
+#ifndef BIT_STUFFER_H
+#define BIT_STUFFER_H
+
+//!
+//! \file bit_stuffer.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Bit stuffing and destuffing of serial link bit streams
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Bit streams are sent most significant bit first, bit 0 of a
+//!             stream is bit 7 of its first byte (the Buffer bit order)
+//!
+//! \note       The streams are processed 64 bits at a time: the ends of the
+//!             runs of five equal bits of a word are found with a few shifts
+//!             and ands, then visited with a bit scan. The bits in between
+//!             are copied as whole words
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_base.h"
+
+#include <cstddef>
+
+namespace bit
+{
+class BitStuffer
+{
+public:
+
+    //-------------------------- Member constants ------------------------------
+
+    //!
+    //! \brief Stuffing rules
+    //!
+    enum Rule
+    {
+        Can = 0,        //!< Complement bit after 5 equal bits (stuff bits count)
+        Hdlc            //!< 0 after five 1s
+    };
+
+    //!
+    //! \brief Possible status of a stuffing or destuffing
+    //!
+    enum Status
+    {
+        Ok = 0,
+        Overflow,
+        StuffError
+    };
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Constructs a bit stuffer
+    //!
+    //! \param rule The stuffing rule
+    //!
+    explicit BitStuffer(const Rule rule);
+
+    //!
+    //! \brief Destroys a bit stuffer
+    //!
+    ~BitStuffer();
+
+    //!
+    //! \brief Inserts the stuff bits into a bit stream
+    //!
+    //! \param input    The bit stream
+    //! \param bits     The number of bits of the stream
+    //! \param output   The stuffed stream ((capacity + 7) / 8 bytes)
+    //! \param capacity The bit capacity of the output
+    //!
+    //! \return Status  Ok or Overflow (output truncated to capacity bits)
+    //!
+    //! \note   A stuff bit follows the last bit if it ends a run
+    //!
+    Status stuff(const uint8_t* input,
+                 const std::size_t bits,
+                 uint8_t* output,
+                 const std::size_t capacity);
+
+    //!
+    //! \brief Removes the stuff bits from a bit stream
+    //!
+    //! \param input        The stuffed bit stream
+    //! \param bits         The number of bits of the stream
+    //! \param output       The stream ((capacity + 7) / 8 bytes)
+    //! \param capacity     The bit capacity of the output
+    //! \param positions    The input bit index of every stuff error (optional)
+    //! \param maxPositions The capacity of the positions array
+    //!
+    //! \return Status  Ok, Overflow or StuffError. A stuff error is a bit that
+    //!                 repeats the run it should break, it is kept as data
+    //!
+    Status destuff(const uint8_t* input,
+                   const std::size_t bits,
+                   uint8_t* output,
+                   const std::size_t capacity,
+                   std::size_t* positions = 0,
+                   const std::size_t maxPositions = 0UL);
+
+    //!
+    //! \brief Returns the number of output bits of the last call
+    //!
+    //! \return std::size_t The number of bits written
+    //!
+    std::size_t bits() const
+    {
+        return mBits;
+    }
+
+    //!
+    //! \brief Returns the number of stuff errors of the last destuff()
+    //!
+    //! \return std::size_t The number of errors (positions keeps the first)
+    //!
+    std::size_t errors() const
+    {
+        return mErrors;
+    }
+
+private:
+
+    //------------------------- Member variables -------------------------------
+
+    //!
+    //! \brief Stuffing rule
+    //!
+    const Rule mRule;
+
+    //!
+    //! \brief Output bits of the last call
+    //!
+    std::size_t mBits;
+
+    //!
+    //! \brief Stuff errors of the last destuff()
+    //!
+    std::size_t mErrors;
+
+    //--------------------------- Member methods -------------------------------
+
+    //!
+    //! \brief Not copyable
+    //!
+    BitStuffer(const BitStuffer&);
+
+    //!
+    //! \brief Not copyable
+    //!
+    BitStuffer& operator=(const BitStuffer&);
+};
+}
+
+#endif
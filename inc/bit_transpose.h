@@ -0,0 +1,135 @@
+#ifndef BIT_TRANSPOSE_H
+#define BIT_TRANSPOSE_H
+
+//!
+//! \file bit_transpose.h
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Bit matrix transposes and per-flag bitmaps of frame blocks
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \note       Matrices and bitmaps use the Buffer bit order: bit j of a row
+//!             (or frame j of a bitmap) is bit 63 - j of its word, row i of
+//!             an 8x8 matrix is byte i of the word most significant first
+//!
+//! \note       transposeFlags() loads the 64-bit column holding a flag from
+//!             64 frames at a time. A column holding many flags is transposed
+//!             whole, otherwise every flag is picked with shifts, four rows
+//!             per AVX2 movemask when the CPU supports it
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_buffer.h"
+
+#include <cstddef>
+
+namespace bit
+{
+//--------------------------- Public constants ---------------------------------
+
+//!
+//! \brief Number of frames of a bitmap word
+//!
+const std::size_t TRANSPOSE_FRAMES = 64UL;
+
+//--------------------------- Public methods -----------------------------------
+
+//!
+//! \brief Transposes an 8x8 bit matrix
+//!
+//! \param matrix   The matrix, row 0 in the most significant byte
+//!
+//! \return uint64_t    The transposed matrix
+//!
+//! \note   Every column is gathered into a byte with one multiply: the shift
+//!         moves it to the byte MSBs, the multiply adds each MSB to a
+//!         distinct bit of the top byte
+//!
+inline uint64_t transpose8x8(const uint64_t matrix)
+{
+    uint64_t result = 0ULL;
+
+    for (std::size_t j = 0UL; j < U08_BIT_COUNT; j++)
+    {
+        const uint64_t column = (((matrix << j) & 0x8080808080808080ULL) *
+                                 0x0002040810204081ULL) >> (U64_BIT_COUNT - U08_BIT_COUNT);
+
+        result |= column << (U64_BIT_COUNT - U08_BIT_COUNT - (j * U08_BIT_COUNT));
+    }
+
+    return result;
+}
+
+//!
+//! \brief Transposes a 64x64 bit matrix in place
+//!
+//! \param rows The 64 rows of the matrix
+//!
+//! \note   Recursive block swaps: the off-diagonal 32x32 blocks are swapped,
+//!         then the 16x16 blocks of every 32x32 block, down to single bits
+//!
+void transpose64x64(uint64_t* rows);
+
+//!
+//! \brief Returns one bitmap per flag across a block of frames
+//!
+//! \param frames   The first frame
+//! \param size     The byte size of a frame
+//! \param stride   The byte distance between two frames
+//! \param count    The number of frames
+//! \param offsets  The field offset of every flag (see Field::OFFSET)
+//! \param flags    The number of flags
+//! \param bitmaps  The bitmaps, (count + 63) / 64 words per flag, the bitmap
+//!                 of flag f starts at word f * ((count + 63) / 64)
+//!
+//! \note   Frame n is bit 63 - n % 64 of word n / 64 of a bitmap. The bits
+//!         past count, and the bitmaps of flags past the frame size, are 0
+//!
+//! \note   Flags sorted by offset share the loads of their 64-bit column
+//!
+void transposeFlags(const uint8_t* frames,
+                    const std::size_t size,
+                    const std::size_t stride,
+                    const std::size_t count,
+                    const std::size_t* offsets,
+                    const std::size_t flags,
+                    uint64_t* bitmaps);
+
+//!
+//! \brief Returns one bitmap per flag across an array of bit buffers
+//!
+//! \param frames   The bit buffers
+//! \param count    The number of bit buffers
+//! \param offsets  The field offset of every flag (see Field::OFFSET)
+//! \param flags    The number of flags
+//! \param bitmaps  The bitmaps, (count + 63) / 64 words per flag
+//!
+template <std::size_t Size>
+void transposeFlags(const Buffer<Size>* frames,
+                    const std::size_t count,
+                    const std::size_t* offsets,
+                    const std::size_t flags,
+                    uint64_t* bitmaps)
+{
+    if (count != 0UL)
+    {
+        transposeFlags(frames[0].data(), Size, sizeof(Buffer<Size>), count,
+                       offsets, flags, bitmaps);
+    }
+}
+}
+
+#endif
@@ -0,0 +1,357 @@
+//!
+//! \file bit_capture.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Fixed-record frame capture files
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_capture.h"
+
+#include "bit_recorder.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Byte size of the record timestamp
+//!
+const std::size_t TIMESTAMP_SIZE = sizeof(uint64_t);
+
+//!
+//! \brief Default byte size of a parallel chunk
+//!
+const std::size_t CHUNK_BYTES = 4UL * 1024UL * 1024UL;
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+void advise(const uint8_t* map,
+            const uint8_t* first,
+            const uint8_t* last,
+            const int advice)
+{
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+    const std::size_t offset = static_cast<std::size_t>(first - map);
+
+    const std::size_t start = offset - (offset % page);
+
+    const std::size_t length = static_cast<std::size_t>(last - map) - start;
+
+    (void) madvise(const_cast<uint8_t*>(&map[start]), length, advice);
+}
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+std::size_t captureRecordSize(const std::size_t frameSize)
+{
+    const std::size_t align = sizeof(uint64_t);
+
+    return ((TIMESTAMP_SIZE + frameSize + align - 1UL) / align) * align;
+}
+
+//------------------------------------------------------------------------------
+CaptureWriter::CaptureWriter()
+    : mFile(0)
+    , mHeader()
+{
+}
+
+//------------------------------------------------------------------------------
+CaptureWriter::~CaptureWriter()
+{
+    (void) close();
+}
+
+//------------------------------------------------------------------------------
+CaptureWriter::Status CaptureWriter::open(const char* path,
+                                          const std::size_t frameSize)
+{
+    Status result = OpenError;
+
+    (void) close();
+
+    mHeader.magic = CAPTURE_MAGIC;
+    mHeader.version = CAPTURE_VERSION;
+    mHeader.reserved = 0U;
+    mHeader.frameSize = static_cast<uint32_t>(frameSize);
+    mHeader.recordSize = static_cast<uint32_t>(captureRecordSize(frameSize));
+    mHeader.frameCount = 0ULL;
+
+    mFile = std::fopen(path, "wb");
+
+    if (mFile != 0)
+    {
+        result = Ok;
+
+        if (std::fwrite(&mHeader, sizeof(mHeader), 1U, mFile) != 1U)
+        {
+            (void) std::fclose(mFile);
+
+            mFile = 0;
+
+            result = WriteError;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+CaptureWriter::Status CaptureWriter::write(const uint64_t timestamp,
+                                           const uint8_t* data)
+{
+    static const uint8_t padding[sizeof(uint64_t)] = { 0U };
+
+    BIT_RECORD_BEGIN();
+
+    Status result = WriteError;
+
+    if (mFile != 0)
+    {
+        const std::size_t pad =
+                mHeader.recordSize - TIMESTAMP_SIZE - mHeader.frameSize;
+
+        if ((std::fwrite(&timestamp, sizeof(timestamp), 1U, mFile) == 1U) &&
+            (std::fwrite(data, 1U, mHeader.frameSize, mFile) == mHeader.frameSize) &&
+            (std::fwrite(padding, 1U, pad, mFile) == pad))
+        {
+            mHeader.frameCount++;
+
+            BIT_COUNT(FramesEncoded, 1ULL);
+
+            result = Ok;
+        }
+    }
+
+    BIT_RECORD_END(FrameWrite, mHeader.frameCount, 0UL, result);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+CaptureWriter::Status CaptureWriter::close()
+{
+    Status result = Ok;
+
+    if (mFile != 0)
+    {
+        if ((std::fseek(mFile, 0L, SEEK_SET) != 0) ||
+            (std::fwrite(&mHeader, sizeof(mHeader), 1U, mFile) != 1U))
+        {
+            result = WriteError;
+        }
+
+        if (std::fclose(mFile) != 0)
+        {
+            result = WriteError;
+        }
+
+        mFile = 0;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+CaptureReader::CaptureReader()
+    : mMap(0)
+    , mLength(0UL)
+    , mRecords(0)
+    , mFrames(0)
+    , mCount(0UL)
+    , mFrameSize(0UL)
+    , mStride(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+CaptureReader::~CaptureReader()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+CaptureReader::Status CaptureReader::open(const char* path)
+{
+    Status result = OpenError;
+
+    close();
+
+    const int file = ::open(path, O_RDONLY);
+
+    if (file >= 0)
+    {
+        struct stat info;
+
+        result = FormatError;
+
+        if ((fstat(file, &info) == 0) &&
+            (static_cast<std::size_t>(info.st_size) >= sizeof(CaptureHeader)))
+        {
+            mLength = static_cast<std::size_t>(info.st_size);
+
+            void* map = mmap(0, mLength, PROT_READ, MAP_PRIVATE, file, 0);
+
+            result = MapError;
+
+            if (map != MAP_FAILED)
+            {
+                mMap = static_cast<uint8_t*>(map);
+
+                (void) madvise(map, mLength, MADV_SEQUENTIAL);
+
+                CaptureHeader header;
+
+                (void) std::memcpy(&header, mMap, sizeof(header));
+
+                const std::size_t available =
+                        (mLength - sizeof(CaptureHeader)) /
+                        ((header.recordSize != 0U) ? header.recordSize : 1U);
+
+                if ((header.magic == CAPTURE_MAGIC) &&
+                    (header.version == CAPTURE_VERSION) &&
+                    (header.recordSize == captureRecordSize(header.frameSize)) &&
+                    (header.frameCount <= available))
+                {
+                    mRecords = &mMap[sizeof(CaptureHeader)];
+                    mFrames = &mRecords[TIMESTAMP_SIZE];
+                    mCount = static_cast<std::size_t>(header.frameCount);
+                    mFrameSize = header.frameSize;
+                    mStride = header.recordSize;
+
+                    result = Ok;
+                }
+                else
+                {
+                    result = FormatError;
+
+                    close();
+                }
+            }
+        }
+
+        (void) ::close(file);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void CaptureReader::close()
+{
+    if (mMap != 0)
+    {
+        (void) munmap(mMap, mLength);
+    }
+
+    mMap = 0;
+    mLength = 0UL;
+    mRecords = 0;
+    mFrames = 0;
+    mCount = 0UL;
+    mFrameSize = 0UL;
+    mStride = 0UL;
+}
+
+//------------------------------------------------------------------------------
+uint64_t CaptureReader::timestamp(const std::size_t i) const
+{
+    uint64_t result;
+
+    (void) std::memcpy(&result, &mRecords[i * mStride], sizeof(result));
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void CaptureReader::parallel(const std::size_t workers,
+                             const std::size_t chunkFrames,
+                             ChunkFunction function,
+                             void* context) const
+{
+    const std::size_t threads = (workers != 0UL) ? workers : 1UL;
+
+    std::size_t frames = chunkFrames;
+
+    if (0UL == frames)
+    {
+        frames = (mStride != 0UL) ? (CHUNK_BYTES / mStride) : 1UL;
+
+        frames = (frames != 0UL) ? frames : 1UL;
+    }
+
+    std::atomic<std::size_t> next(0UL);
+
+    const CaptureReader* reader = this;
+
+    auto work = [reader, frames, function, context, &next](const std::size_t worker)
+    {
+        bool isDone = false;
+
+        while (!isDone)
+        {
+            const std::size_t first = next.fetch_add(frames);
+
+            isDone = (first >= reader->mCount);
+
+            if (!isDone)
+            {
+                const std::size_t last = ((reader->mCount - first) < frames) ?
+                                         reader->mCount : (first + frames);
+
+                advise(reader->mMap,
+                       &reader->mRecords[first * reader->mStride],
+                       &reader->mRecords[last * reader->mStride],
+                       MADV_WILLNEED);
+
+                function(context, worker, first, last);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+
+    for (std::size_t i = 1UL; i < threads; i++)
+    {
+        pool.push_back(std::thread(work, i));
+    }
+
+    work(0UL);
+
+    for (std::size_t i = 0UL; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+}
+}
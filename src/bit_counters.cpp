@@ -0,0 +1,192 @@
+//!
+//! \file bit_counters.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Per-thread hot path counters and cycle timing
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_counters.h"
+
+namespace bit
+{
+//------------------------ Static member definitions ---------------------------
+
+Counters::Block Counters::sBlocks[COUNTER_MAX_THREADS];
+
+std::atomic<std::size_t> Counters::sThreads(0UL);
+
+std::atomic<uint64_t> Counters::sFree(0ULL);
+
+std::atomic<OverflowHook> Counters::sHook(0);
+
+std::atomic<void*> Counters::sContext(0);
+
+thread_local Counters::Block* Counters::tBlock = 0;
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+void Counters::overflow(const void* source, const std::size_t index)
+{
+    add(Overflows, 1ULL);
+
+    const OverflowHook hook = sHook.load(std::memory_order_acquire);
+
+    if (hook != 0)
+    {
+        hook(sContext.load(std::memory_order_relaxed), source, index);
+    }
+}
+
+//------------------------------------------------------------------------------
+void Counters::setOverflowHook(OverflowHook hook, void* context)
+{
+    sContext.store(context, std::memory_order_relaxed);
+    sHook.store(hook, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+std::size_t Counters::threads()
+{
+    const std::size_t result = sThreads.load(std::memory_order_acquire);
+
+    return (result < COUNTER_MAX_THREADS) ? result : COUNTER_MAX_THREADS;
+}
+
+//------------------------------------------------------------------------------
+void Counters::snapshot(CounterSnapshot& snapshot)
+{
+    const std::size_t count = threads();
+
+    for (std::size_t i = 0UL; i < COUNTER_COUNT; i++)
+    {
+        snapshot.values[i] = 0ULL;
+    }
+
+    for (std::size_t i = 0UL; i < COUNTER_SIGNAL_SLOTS; i++)
+    {
+        snapshot.signals[i] = 0ULL;
+    }
+
+    for (std::size_t thread = 0UL; thread < count; thread++)
+    {
+        const Block& block = sBlocks[thread];
+
+        for (std::size_t i = 0UL; i < COUNTER_COUNT; i++)
+        {
+            snapshot.values[i] += block.values[i].load(std::memory_order_relaxed);
+        }
+
+        for (std::size_t i = 0UL; i < COUNTER_SIGNAL_SLOTS; i++)
+        {
+            snapshot.signals[i] += block.signals[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Counters::threadSnapshot(const std::size_t thread, CounterSnapshot& snapshot)
+{
+    const Block& block = sBlocks[thread % COUNTER_MAX_THREADS];
+
+    for (std::size_t i = 0UL; i < COUNTER_COUNT; i++)
+    {
+        snapshot.values[i] = block.values[i].load(std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0UL; i < COUNTER_SIGNAL_SLOTS; i++)
+    {
+        snapshot.signals[i] = block.signals[i].load(std::memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+void Counters::reset()
+{
+    for (std::size_t thread = 0UL; thread < COUNTER_MAX_THREADS; thread++)
+    {
+        Block& block = sBlocks[thread];
+
+        for (std::size_t i = 0UL; i < COUNTER_COUNT; i++)
+        {
+            block.values[i].store(0ULL, std::memory_order_relaxed);
+        }
+
+        for (std::size_t i = 0UL; i < COUNTER_SIGNAL_SLOTS; i++)
+        {
+            block.signals[i].store(0ULL, std::memory_order_relaxed);
+        }
+    }
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+Counters::Block& Counters::attach()
+{
+    Block* block = 0;
+
+    uint64_t free = sFree.load(std::memory_order_acquire);
+
+    // Blocks of exited threads first, their last updates are acquired
+    while ((0 == block) && (free != 0ULL))
+    {
+        const std::size_t index = trailingZeros(free);
+
+        if (sFree.compare_exchange_weak(free, free & (free - 1ULL),
+                                        std::memory_order_acquire))
+        {
+            block = &sBlocks[index];
+        }
+    }
+
+    if (0 == block)
+    {
+        const std::size_t index = sThreads.fetch_add(1UL, std::memory_order_acq_rel);
+
+        block = &sBlocks[COUNTER_MAX_THREADS - 1UL];
+
+        if (index < (COUNTER_MAX_THREADS - 1UL))
+        {
+            block = &sBlocks[index];
+        }
+    }
+
+    // Constructed once per thread, destroyed when the thread exits
+    static thread_local Release release;
+
+    tBlock = block;
+
+    return *block;
+}
+
+//------------------------------------------------------------------------------
+Counters::Release::~Release()
+{
+    Block* block = tBlock;
+
+    if ((block != 0) && !isShared(*block))
+    {
+        // Updates from later thread_local destructors go to the shared block
+        tBlock = &sBlocks[COUNTER_MAX_THREADS - 1UL];
+
+        (void) sFree.fetch_or(1ULL << static_cast<std::size_t>(block - sBlocks),
+                              std::memory_order_release);
+    }
+}
+}
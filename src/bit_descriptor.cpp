@@ -0,0 +1,113 @@
+//!
+//! \file bit_descriptor.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Compact signal descriptors and their shared decode kernels
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_descriptor.h"
+
+namespace bit
+{
+//--------------------------- Public methods -----------------------------------
+
+//------------------------------------------------------------------------------
+bool describe(const SchemaSignal& signal, Descriptor& descriptor)
+{
+    const std::size_t offset = (Intel == signal.order) ? signal.position :
+                               fieldOffset(signal.position);
+
+    const bool result = (offset <= 0xFFFFUL) && (signal.width != 0U) &&
+                        (signal.width <= U64_BIT_COUNT);
+
+    if (result)
+    {
+        descriptor.offset = static_cast<uint16_t>(offset);
+        descriptor.width = static_cast<uint8_t>(signal.width);
+        descriptor.flags = static_cast<uint8_t>(signal.type);
+
+        if (Intel == signal.order)
+        {
+            descriptor.flags |= DESCRIPTOR_INTEL;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+uint64_t readRaw(const Descriptor& descriptor, const uint8_t* data, const std::size_t size)
+{
+    uint64_t result;
+
+    if ((descriptor.flags & DESCRIPTOR_INTEL) != 0U)
+    {
+        result = extractIntelField(data, size, descriptor.offset, descriptor.width);
+    }
+    else
+    {
+        result = extractField(data, size, descriptor.offset, descriptor.width);
+    }
+
+    if (((descriptor.flags & DESCRIPTOR_TYPE_MASK) == Signed) &&
+        (descriptor.width < U64_BIT_COUNT) &&
+        (((result >> (descriptor.width - 1U)) & 1ULL) != 0ULL))
+    {
+        result |= ~0ULL << descriptor.width;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void writeRaw(const Descriptor& descriptor,
+              uint8_t* data,
+              const std::size_t size,
+              const uint64_t raw)
+{
+    if ((descriptor.flags & DESCRIPTOR_INTEL) != 0U)
+    {
+        insertIntelField(data, size, descriptor.offset, descriptor.width, raw);
+    }
+    else
+    {
+        insertField(data, size, descriptor.offset, descriptor.width, raw);
+    }
+}
+
+//------------------------------------------------------------------------------
+double readValue(const Descriptor& descriptor, const uint8_t* data, const std::size_t size)
+{
+    return fieldNumber(readRaw(descriptor, data, size),
+                       descriptor.width,
+                       static_cast<ValueType>(descriptor.flags & DESCRIPTOR_TYPE_MASK));
+}
+
+//------------------------------------------------------------------------------
+void readAll(const Descriptor* descriptors,
+             const std::size_t count,
+             const uint8_t* data,
+             const std::size_t size,
+             uint64_t* raw)
+{
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        raw[i] = readRaw(descriptors[i], data, size);
+    }
+}
+}
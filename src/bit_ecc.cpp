@@ -0,0 +1,391 @@
+//!
+//! \file bit_ecc.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    SECDED Hamming(72,64) and Hamming(39,32) error-correcting codes
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_ecc.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_ECC_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Number of words checked per batch step
+//!
+const std::size_t CHUNK_SIZE = 64UL;
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Computes the check bits of 64-bit words
+//!
+typedef void (*Encode64)(const uint64_t* data, uint8_t* check, const std::size_t count);
+
+//!
+//! \brief Computes the check bits of 32-bit words
+//!
+typedef void (*Encode32)(const uint32_t* data, uint8_t* check, const std::size_t count);
+
+//!
+//! \brief Batch kernels of the running CPU
+//!
+struct Kernels
+{
+    //!
+    //! \brief 64-bit word kernel
+    //!
+    Encode64 encode64;
+
+    //!
+    //! \brief 32-bit word kernel
+    //!
+    Encode32 encode32;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+template <typename Word>
+Secded::Status correctWord(Word& data, uint8_t& check, const std::size_t bits)
+{
+    const uint8_t syndrome = Secded::syndrome(data, check);
+
+    const uint8_t top = static_cast<uint8_t>(1U << (bits - 1UL));
+
+    const uint8_t hamming = syndrome & static_cast<uint8_t>(top - 1U);
+
+    Secded::Status result = Secded::Corrected;
+
+    if (0U == syndrome)
+    {
+        result = Secded::Ok;
+    }
+    else if (0U == (syndrome & top))
+    {
+        // Even number of errors
+        result = Secded::Uncorrectable;
+    }
+    else if (0U == hamming)
+    {
+        check ^= top;
+    }
+    else if (0U == (hamming & (hamming - 1U)))
+    {
+        check ^= hamming;
+    }
+    else
+    {
+        std::size_t msb = 0UL;
+
+        while ((hamming >> (msb + 1UL)) != 0U)
+        {
+            msb++;
+        }
+
+        // Position minus the powers of 2 below it, minus the first position (3)
+        const std::size_t index = hamming - msb - 2UL;
+
+        if (index < (sizeof(Word) * U08_BIT_COUNT))
+        {
+            data ^= static_cast<Word>(static_cast<Word>(1U) << index);
+        }
+        else
+        {
+            result = Secded::Uncorrectable;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+template <typename Word>
+Secded::Status correctBuffer(Word* data, uint8_t* check, const std::size_t count,
+                             const std::size_t bits,
+                             void (*encode)(const Word*, uint8_t*, const std::size_t))
+{
+    const uint8_t used = static_cast<uint8_t>((1UL << bits) - 1UL);
+
+    uint8_t expected[CHUNK_SIZE];
+
+    Secded::Status result = Secded::Ok;
+
+    for (std::size_t first = 0UL; first < count; first += CHUNK_SIZE)
+    {
+        const std::size_t size = ((count - first) < CHUNK_SIZE) ?
+                                 (count - first) : CHUNK_SIZE;
+
+        encode(&data[first], expected, size);
+
+        for (std::size_t i = 0UL; i < size; i++)
+        {
+            if (expected[i] != (check[first + i] & used))
+            {
+                const Secded::Status status =
+                        correctWord(data[first + i], check[first + i], bits);
+
+                result = (status > result) ? status : result;
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void encode64Scalar(const uint64_t* data, uint8_t* check, const std::size_t count)
+{
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        check[i] = Secded::encode(data[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void encode32Scalar(const uint32_t* data, uint8_t* check, const std::size_t count)
+{
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        check[i] = Secded::encode(data[i]);
+    }
+}
+
+#ifdef BIT_ECC_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline uint32_t checkBlockAvx2(const __m256i words, const __m256i (&masks)[8])
+{
+    // Fold tree of the 8 masked words down to one byte per check bit. The
+    // tree leaves the words in byte order 0 4 2 6 1 5 3 7, masks[] is
+    // permuted so that byte i of every lane holds check bit i
+    const __m256i v0 = _mm256_and_si256(words, masks[0]);
+    const __m256i v1 = _mm256_and_si256(words, masks[1]);
+    const __m256i v2 = _mm256_and_si256(words, masks[2]);
+    const __m256i v3 = _mm256_and_si256(words, masks[3]);
+    const __m256i v4 = _mm256_and_si256(words, masks[4]);
+    const __m256i v5 = _mm256_and_si256(words, masks[5]);
+    const __m256i v6 = _mm256_and_si256(words, masks[6]);
+    const __m256i v7 = _mm256_and_si256(words, masks[7]);
+
+    // 64 to 32 bits, low dword from the first word, high from the second
+    const __m256i a01 = _mm256_blend_epi32(
+            _mm256_xor_si256(v0, _mm256_srli_epi64(v0, 32)),
+            _mm256_xor_si256(v1, _mm256_slli_epi64(v1, 32)), 0xAA);
+    const __m256i a23 = _mm256_blend_epi32(
+            _mm256_xor_si256(v2, _mm256_srli_epi64(v2, 32)),
+            _mm256_xor_si256(v3, _mm256_slli_epi64(v3, 32)), 0xAA);
+    const __m256i a45 = _mm256_blend_epi32(
+            _mm256_xor_si256(v4, _mm256_srli_epi64(v4, 32)),
+            _mm256_xor_si256(v5, _mm256_slli_epi64(v5, 32)), 0xAA);
+    const __m256i a67 = _mm256_blend_epi32(
+            _mm256_xor_si256(v6, _mm256_srli_epi64(v6, 32)),
+            _mm256_xor_si256(v7, _mm256_slli_epi64(v7, 32)), 0xAA);
+
+    // 32 to 16 bits
+    const __m256i b0 = _mm256_blend_epi16(
+            _mm256_xor_si256(a01, _mm256_srli_epi64(a01, 16)),
+            _mm256_xor_si256(a23, _mm256_slli_epi64(a23, 16)), 0xAA);
+    const __m256i b1 = _mm256_blend_epi16(
+            _mm256_xor_si256(a45, _mm256_srli_epi64(a45, 16)),
+            _mm256_xor_si256(a67, _mm256_slli_epi64(a67, 16)), 0xAA);
+
+    // 16 to 8 bits
+    __m256i c = _mm256_blendv_epi8(
+            _mm256_xor_si256(b0, _mm256_srli_epi64(b0, 8)),
+            _mm256_xor_si256(b1, _mm256_slli_epi64(b1, 8)),
+            _mm256_set1_epi16(static_cast<short>(0xFF00)));
+
+    // 8 to 1 bit, bit 0 of every byte
+    c = _mm256_xor_si256(c, _mm256_srli_epi64(c, 4));
+    c = _mm256_xor_si256(c, _mm256_srli_epi64(c, 2));
+    c = _mm256_xor_si256(c, _mm256_srli_epi64(c, 1));
+
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi64(c, 7)));
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void loadMasks(const uint64_t (&source)[SECDED64_CHECK_BITS], __m256i (&masks)[8])
+{
+    static const std::size_t order[SECDED64_CHECK_BITS] = { 0UL, 4UL, 2UL, 6UL,
+                                                            1UL, 5UL, 3UL, 7UL };
+
+    for (std::size_t i = 0UL; i < SECDED64_CHECK_BITS; i++)
+    {
+        masks[order[i]] = _mm256_set1_epi64x(static_cast<long long>(source[i]));
+    }
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void encode64Avx2(const uint64_t* data, uint8_t* check, const std::size_t count)
+{
+    __m256i masks[8];
+
+    loadMasks(Secded::MASKS64, masks);
+
+    std::size_t i = 0UL;
+
+    for (; (i + 4UL) <= count; i += 4UL)
+    {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[i]));
+
+        const uint32_t bytes = checkBlockAvx2(words, masks);
+
+        (void) std::memcpy(&check[i], &bytes, sizeof(bytes));
+    }
+
+    encode64Scalar(&data[i], &check[i], count - i);
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void encode32Avx2(const uint32_t* data, uint8_t* check, const std::size_t count)
+{
+    uint64_t source[SECDED64_CHECK_BITS] = { 0ULL };
+
+    for (std::size_t i = 0UL; i < SECDED32_CHECK_BITS; i++)
+    {
+        source[i] = Secded::MASKS32[i];
+    }
+
+    __m256i masks[8];
+
+    loadMasks(source, masks);
+
+    std::size_t i = 0UL;
+
+    for (; (i + 4UL) <= count; i += 4UL)
+    {
+        const __m256i words = _mm256_cvtepu32_epi64(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i])));
+
+        const uint32_t bytes = checkBlockAvx2(words, masks);
+
+        (void) std::memcpy(&check[i], &bytes, sizeof(bytes));
+    }
+
+    encode32Scalar(&data[i], &check[i], count - i);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+Kernels selectKernels()
+{
+    Kernels result = { &encode64Scalar, &encode32Scalar };
+
+#ifdef BIT_ECC_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        result.encode64 = &encode64Avx2;
+        result.encode32 = &encode32Avx2;
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+const Kernels& kernels()
+{
+    static const Kernels result = selectKernels();
+
+    return result;
+}
+}
+
+//------------------------ Static member definitions ---------------------------
+
+const uint64_t Secded::MASKS64[SECDED64_CHECK_BITS] =
+{
+    0xAB55555556AAAD5BULL,
+    0xCD9999999B33366DULL,
+    0xF1E1E1E1E3C3C78EULL,
+    0x01FE01FE03FC07F0ULL,
+    0x01FFFE0003FFF800ULL,
+    0x01FFFFFFFC000000ULL,
+    0xFE00000000000000ULL,
+    0x972CD2D32DA65CB7ULL
+};
+
+const uint32_t Secded::MASKS32[SECDED32_CHECK_BITS] =
+{
+    0x56AAAD5BUL,
+    0x9B33366DUL,
+    0xE3C3C78EUL,
+    0x03FC07F0UL,
+    0x03FFF800UL,
+    0xFC000000UL,
+    0x2DA65CB7UL
+};
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+Secded::Status Secded::correct(uint64_t& data, uint8_t& check)
+{
+    return correctWord(data, check, SECDED64_CHECK_BITS);
+}
+
+//------------------------------------------------------------------------------
+Secded::Status Secded::correct(uint32_t& data, uint8_t& check)
+{
+    return correctWord(data, check, SECDED32_CHECK_BITS);
+}
+
+//------------------------------------------------------------------------------
+void Secded::encode(const uint64_t* data, uint8_t* check, const std::size_t count)
+{
+    kernels().encode64(data, check, count);
+}
+
+//------------------------------------------------------------------------------
+void Secded::encode(const uint32_t* data, uint8_t* check, const std::size_t count)
+{
+    kernels().encode32(data, check, count);
+}
+
+//------------------------------------------------------------------------------
+Secded::Status Secded::correct(uint64_t* data, uint8_t* check, const std::size_t count)
+{
+    return correctBuffer(data, check, count, SECDED64_CHECK_BITS, kernels().encode64);
+}
+
+//------------------------------------------------------------------------------
+Secded::Status Secded::correct(uint32_t* data, uint8_t* check, const std::size_t count)
+{
+    return correctBuffer(data, check, count, SECDED32_CHECK_BITS, kernels().encode32);
+}
+}
@@ -0,0 +1,524 @@
+//!
+//! \file bit_filter.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Masked bit pattern filter over arrays of fixed layout frames
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_filter.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_FILTER_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Number of frames tested per match block (one bitmap word)
+//!
+const std::size_t BLOCK_SIZE = 64UL;
+
+//!
+//! \brief Byte size of a scalar compare word
+//!
+const std::size_t WORD_SIZE = sizeof(uint64_t);
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Masked pattern prepared for a scan
+//!
+struct Pattern
+{
+    //!
+    //! \brief The pattern mask
+    //!
+    const uint8_t* mask;
+
+    //!
+    //! \brief The pattern value
+    //!
+    const uint8_t* value;
+
+    //!
+    //! \brief Byte size of the frame layout
+    //!
+    std::size_t size;
+
+    //!
+    //! \brief First byte with mask bits
+    //!
+    std::size_t first;
+
+    //!
+    //! \brief One past the last byte with mask bits
+    //!
+    std::size_t last;
+
+    //!
+    //! \brief Start of the single word window (word mode only)
+    //!
+    std::size_t window;
+
+    //!
+    //! \brief Set if every mask bit fits into one 64-bit word window
+    //!
+    bool isWord;
+
+    //!
+    //! \brief Mask of the word window
+    //!
+    uint64_t wordMask;
+
+    //!
+    //! \brief Masked value of the word window
+    //!
+    uint64_t wordValue;
+};
+
+//!
+//! \brief Tests up to BLOCK_SIZE frames, returns one bit per frame
+//!
+typedef uint64_t (*MatchBlock)(const uint8_t* frames,
+                               const std::size_t count,
+                               const std::size_t stride,
+                               const Pattern& pattern);
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+inline uint64_t load64(const uint8_t* data)
+{
+    uint64_t result;
+
+    (void) std::memcpy(&result, data, sizeof(result));
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Pattern prepare(const uint8_t* mask,
+                const uint8_t* value,
+                const std::size_t size)
+{
+    Pattern pattern;
+
+    pattern.mask = mask;
+    pattern.value = value;
+    pattern.size = size;
+    pattern.first = size;
+    pattern.last = 0UL;
+    pattern.window = 0UL;
+    pattern.isWord = false;
+    pattern.wordMask = 0ULL;
+    pattern.wordValue = 0ULL;
+
+    for (std::size_t i = 0UL; i < size; i++)
+    {
+        if (mask[i] != 0U)
+        {
+            if (pattern.first == size)
+            {
+                pattern.first = i;
+            }
+
+            pattern.last = i + 1UL;
+        }
+    }
+
+    if (pattern.first == size)
+    {
+        pattern.first = 0UL;
+    }
+
+    if ((size >= WORD_SIZE) && ((pattern.last - pattern.first) <= WORD_SIZE))
+    {
+        pattern.isWord = true;
+
+        pattern.window = (pattern.first < (size - WORD_SIZE)) ?
+                          pattern.first : (size - WORD_SIZE);
+
+        pattern.wordMask = load64(&mask[pattern.window]);
+        pattern.wordValue = load64(&value[pattern.window]) & pattern.wordMask;
+    }
+
+    return pattern;
+}
+
+//------------------------------------------------------------------------------
+bool matchScalar(const uint8_t* frame, const Pattern& pattern)
+{
+    bool result = true;
+
+    if (pattern.isWord)
+    {
+        result = ((load64(&frame[pattern.window]) & pattern.wordMask) ==
+                  pattern.wordValue);
+    }
+    else if (pattern.size < WORD_SIZE)
+    {
+        for (std::size_t i = pattern.first; i < pattern.last; i++)
+        {
+            result = result &&
+                    ((frame[i] & pattern.mask[i]) ==
+                     (pattern.value[i] & pattern.mask[i]));
+        }
+    }
+    else
+    {
+        for (std::size_t i = pattern.first; result && (i < pattern.last);
+             i += WORD_SIZE)
+        {
+            const std::size_t w = (i < (pattern.size - WORD_SIZE)) ?
+                                   i : (pattern.size - WORD_SIZE);
+
+            const uint64_t m = load64(&pattern.mask[w]);
+
+            result = ((load64(&frame[w]) & m) ==
+                      (load64(&pattern.value[w]) & m));
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+uint64_t matchBlockScalar(const uint8_t* frames,
+                          const std::size_t count,
+                          const std::size_t stride,
+                          const Pattern& pattern)
+{
+    uint64_t result = 0ULL;
+
+    if (pattern.isWord)
+    {
+        const uint8_t* frame = &frames[pattern.window];
+
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            const uint64_t bit =
+                    ((load64(frame) & pattern.wordMask) == pattern.wordValue) ?
+                    1ULL : 0ULL;
+
+            result |= bit << i;
+
+            frame += stride;
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            if (matchScalar(&frames[i * stride], pattern))
+            {
+                result |= 1ULL << i;
+            }
+        }
+    }
+
+    return result;
+}
+
+#ifdef BIT_FILTER_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+uint64_t matchBlockAvx2(const uint8_t* frames,
+                        const std::size_t count,
+                        const std::size_t stride,
+                        const Pattern& pattern)
+{
+    const std::size_t lanes = 4UL;
+
+    uint64_t result = 0ULL;
+
+    std::size_t i = 0UL;
+
+    if (pattern.isWord)
+    {
+        const __m256i mask =
+                _mm256_set1_epi64x(static_cast<long long>(pattern.wordMask));
+        const __m256i value =
+                _mm256_set1_epi64x(static_cast<long long>(pattern.wordValue));
+
+        const long long step = static_cast<long long>(stride);
+
+        const __m256i index = _mm256_set_epi64x(3LL * step, 2LL * step, step, 0LL);
+
+        for (; (i + lanes) <= count; i += lanes)
+        {
+            const uint8_t* base = &frames[(i * stride) + pattern.window];
+
+            const __m256i words = _mm256_i64gather_epi64(
+                    reinterpret_cast<const long long*>(base), index, 1);
+
+            const __m256i equal =
+                    _mm256_cmpeq_epi64(_mm256_and_si256(words, mask), value);
+
+            const uint64_t bits = static_cast<uint32_t>(
+                    _mm256_movemask_pd(_mm256_castsi256_pd(equal)));
+
+            result |= bits << i;
+        }
+    }
+    else if (pattern.size >= sizeof(__m256i))
+    {
+        const std::size_t width = sizeof(__m256i);
+
+        for (; i < count; i++)
+        {
+            const uint8_t* frame = &frames[i * stride];
+
+            bool isMatch = true;
+
+            for (std::size_t o = pattern.first; isMatch && (o < pattern.last);
+                 o += width)
+            {
+                const std::size_t w = (o < (pattern.size - width)) ?
+                                       o : (pattern.size - width);
+
+                const __m256i m = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(&pattern.mask[w]));
+                const __m256i v = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(&pattern.value[w]));
+                const __m256i f = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(&frame[w]));
+
+                const __m256i equal = _mm256_cmpeq_epi8(
+                        _mm256_and_si256(f, m), _mm256_and_si256(v, m));
+
+                isMatch = (_mm256_movemask_epi8(equal) == -1);
+            }
+
+            if (isMatch)
+            {
+                result |= 1ULL << i;
+            }
+        }
+    }
+    else
+    {
+        // Layouts smaller than a vector register
+    }
+
+    if (i < count)
+    {
+        result |= matchBlockScalar(&frames[i * stride], count - i, stride,
+                                   pattern) << i;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512bw")))
+uint64_t matchBlockAvx512(const uint8_t* frames,
+                          const std::size_t count,
+                          const std::size_t stride,
+                          const Pattern& pattern)
+{
+    const std::size_t lanes = 8UL;
+
+    uint64_t result = 0ULL;
+
+    std::size_t i = 0UL;
+
+    if (pattern.isWord)
+    {
+        const __m512i mask =
+                _mm512_set1_epi64(static_cast<long long>(pattern.wordMask));
+        const __m512i value =
+                _mm512_set1_epi64(static_cast<long long>(pattern.wordValue));
+
+        const long long step = static_cast<long long>(stride);
+
+        const __m512i index = _mm512_set_epi64(7LL * step, 6LL * step,
+                                               5LL * step, 4LL * step,
+                                               3LL * step, 2LL * step,
+                                               step, 0LL);
+
+        for (; (i + lanes) <= count; i += lanes)
+        {
+            const uint8_t* base = &frames[(i * stride) + pattern.window];
+
+            // The merge source keeps the gather from reading an undefined vector
+            const __m512i words = _mm512_mask_i64gather_epi64(
+                    _mm512_setzero_si512(), 0xFF, index, base, 1);
+
+            const uint64_t bits = _mm512_cmpeq_epi64_mask(
+                    _mm512_and_si512(words, mask), value);
+
+            result |= bits << i;
+        }
+    }
+    else
+    {
+        const std::size_t width = sizeof(__m512i);
+
+        for (; i < count; i++)
+        {
+            const uint8_t* frame = &frames[i * stride];
+
+            bool isMatch = true;
+
+            for (std::size_t o = pattern.first; isMatch && (o < pattern.last);
+                 o += width)
+            {
+                const std::size_t remaining = pattern.last - o;
+
+                // Masked loads never touch bytes past the end of the layout
+                const __mmask64 k = (remaining >= width) ?
+                        ~static_cast<__mmask64>(0U) :
+                        ((static_cast<__mmask64>(1U) << remaining) - 1U);
+
+                const __m512i m = _mm512_maskz_loadu_epi8(k, &pattern.mask[o]);
+                const __m512i v = _mm512_maskz_loadu_epi8(k, &pattern.value[o]);
+                const __m512i f = _mm512_maskz_loadu_epi8(k, &frame[o]);
+
+                isMatch = (0U == _mm512_cmpneq_epi8_mask(
+                        _mm512_and_si512(f, m), _mm512_and_si512(v, m)));
+            }
+
+            if (isMatch)
+            {
+                result |= 1ULL << i;
+            }
+        }
+    }
+
+    if (i < count)
+    {
+        result |= matchBlockScalar(&frames[i * stride], count - i, stride,
+                                   pattern) << i;
+    }
+
+    return result;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+MatchBlock selectKernel()
+{
+    MatchBlock result = &matchBlockScalar;
+
+#ifdef BIT_FILTER_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        result = &matchBlockAvx512;
+    }
+    else if (__builtin_cpu_supports("avx2"))
+    {
+        result = &matchBlockAvx2;
+    }
+    else
+    {
+        // Scalar kernel
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+MatchBlock kernel()
+{
+    static const MatchBlock result = selectKernel();
+
+    return result;
+}
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+std::size_t filterBitmap(const uint8_t* frames,
+                         const std::size_t count,
+                         const std::size_t stride,
+                         const uint8_t* mask,
+                         const uint8_t* value,
+                         const std::size_t size,
+                         uint64_t* bitmap)
+{
+    const Pattern pattern = prepare(mask, value, size);
+
+    const MatchBlock match = kernel();
+
+    std::size_t result = 0UL;
+
+    for (std::size_t i = 0UL; i < count; i += BLOCK_SIZE)
+    {
+        const std::size_t n = ((count - i) < BLOCK_SIZE) ? (count - i) : BLOCK_SIZE;
+
+        const uint64_t bits = match(&frames[i * stride], n, stride, pattern);
+
+        bitmap[i / BLOCK_SIZE] = bits;
+
+        result += popcount(bits);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::size_t filterIndices(const uint8_t* frames,
+                          const std::size_t count,
+                          const std::size_t stride,
+                          const uint8_t* mask,
+                          const uint8_t* value,
+                          const std::size_t size,
+                          std::size_t* indices,
+                          const std::size_t maxIndices)
+{
+    const Pattern pattern = prepare(mask, value, size);
+
+    const MatchBlock match = kernel();
+
+    std::size_t result = 0UL;
+
+    for (std::size_t i = 0UL; (i < count) && (result < maxIndices);
+         i += BLOCK_SIZE)
+    {
+        const std::size_t n = ((count - i) < BLOCK_SIZE) ? (count - i) : BLOCK_SIZE;
+
+        uint64_t bits = match(&frames[i * stride], n, stride, pattern);
+
+        while ((bits != 0ULL) && (result < maxIndices))
+        {
+            indices[result] = i + trailingZeros(bits);
+
+            result++;
+
+            bits &= bits - 1ULL;
+        }
+    }
+
+    return result;
+}
+}
@@ -0,0 +1,480 @@
+//!
+//! \file bit_framing.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    COBS and SLIP byte stream framing of buffer payloads
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_framing.h"
+
+#include "bit_field.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_FRAMING_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Byte 0x01 repeated
+//!
+const uint64_t BYTES_01 = 0x0101010101010101ULL;
+
+//!
+//! \brief Byte 0x7F repeated
+//!
+const uint64_t BYTES_7F = 0x7F7F7F7F7F7F7F7FULL;
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Returns the index of the first byte equal to first or second
+//!
+typedef std::size_t (*Find)(const uint8_t* data,
+                            const std::size_t size,
+                            const uint8_t first,
+                            const uint8_t second);
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+inline uint64_t zeroBytes(const uint64_t word)
+{
+    // 0x80 in every zero byte, exact (no carry crosses a byte)
+    return ~(((word & BYTES_7F) + BYTES_7F) | word | BYTES_7F);
+}
+
+//------------------------------------------------------------------------------
+std::size_t findScalar(const uint8_t* data,
+                       const std::size_t size,
+                       const uint8_t first,
+                       const uint8_t second)
+{
+    const uint64_t firstBytes = BYTES_01 * first;
+    const uint64_t secondBytes = BYTES_01 * second;
+
+    std::size_t result = size;
+
+    std::size_t i = 0UL;
+
+    for (; ((i + sizeof(uint64_t)) <= size) && (size == result); i += sizeof(uint64_t))
+    {
+        // Byte i is the most significant
+        const uint64_t word = loadU64(&data[i]);
+
+        const uint64_t matches = zeroBytes(word ^ firstBytes) | zeroBytes(word ^ secondBytes);
+
+        if (matches != 0ULL)
+        {
+            result = i + (leadingZeros(matches) / U08_BIT_COUNT);
+        }
+    }
+
+    for (; (i < size) && (size == result); i++)
+    {
+        if ((first == data[i]) || (second == data[i]))
+        {
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+#ifdef BIT_FRAMING_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+std::size_t findAvx2(const uint8_t* data,
+                     const std::size_t size,
+                     const uint8_t first,
+                     const uint8_t second)
+{
+    const __m256i firstBytes = _mm256_set1_epi8(static_cast<char>(first));
+    const __m256i secondBytes = _mm256_set1_epi8(static_cast<char>(second));
+
+    std::size_t result = size;
+
+    std::size_t i = 0UL;
+
+    for (; ((i + sizeof(__m256i)) <= size) && (size == result); i += sizeof(__m256i))
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[i]));
+
+        const uint32_t matches = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, firstBytes),
+                                _mm256_cmpeq_epi8(bytes, secondBytes))));
+
+        if (matches != 0U)
+        {
+            result = i + trailingZeros(matches);
+        }
+    }
+
+    if (size == result)
+    {
+        result = i + findScalar(&data[i], size - i, first, second);
+    }
+
+    return result;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+Find selectFind()
+{
+    Find result = &findScalar;
+
+#ifdef BIT_FRAMING_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        result = &findAvx2;
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::size_t find(const uint8_t* data,
+                 const std::size_t size,
+                 const uint8_t first,
+                 const uint8_t second)
+{
+    static const Find kernel = selectFind();
+
+    return kernel(data, size, first, second);
+}
+
+//------------------------------------------------------------------------------
+std::size_t encodeCobs(const uint8_t* data,
+                       const std::size_t size,
+                       uint8_t* output)
+{
+    std::size_t result = 0UL;
+
+    std::size_t i = 0UL;
+
+    bool isDone = false;
+
+    while (!isDone)
+    {
+        // One block: the bytes up to the next zero, at most COBS_BLOCK_SIZE.
+        // A block ended by a zero is always followed by another one
+        const std::size_t count = ((size - i) < COBS_BLOCK_SIZE) ? (size - i) : COBS_BLOCK_SIZE;
+
+        const std::size_t run = find(&data[i], count, COBS_DELIMITER, COBS_DELIMITER);
+
+        output[result] = static_cast<uint8_t>(run + 1UL);
+
+        (void)memcpy(&output[result + 1UL], &data[i], run);
+
+        result += run + 1UL;
+        i += run;
+
+        if (run < count)
+        {
+            i++;
+        }
+        else
+        {
+            isDone = (size == i);
+        }
+    }
+
+    output[result] = COBS_DELIMITER;
+
+    return result + 1UL;
+}
+
+//------------------------------------------------------------------------------
+std::size_t encodeSlip(const uint8_t* data,
+                       const std::size_t size,
+                       uint8_t* output)
+{
+    std::size_t result = 0UL;
+
+    std::size_t i = 0UL;
+
+    while (i < size)
+    {
+        const std::size_t run = find(&data[i], size - i, SLIP_END, SLIP_ESC);
+
+        (void)memcpy(&output[result], &data[i], run);
+
+        result += run;
+        i += run;
+
+        if (i < size)
+        {
+            output[result] = SLIP_ESC;
+            output[result + 1UL] = (SLIP_END == data[i]) ? SLIP_ESC_END : SLIP_ESC_ESC;
+
+            result += 2UL;
+            i++;
+        }
+    }
+
+    output[result] = SLIP_END;
+
+    return result + 1UL;
+}
+}
+
+//--------------------------- Public methods -----------------------------------
+
+//------------------------------------------------------------------------------
+std::size_t encodeFrame(const Framing framing,
+                        const uint8_t* data,
+                        const std::size_t size,
+                        uint8_t* output,
+                        const std::size_t capacity)
+{
+    std::size_t result = 0UL;
+
+    if (capacity < maxFrameSize(framing, size))
+    {
+        // Does not fit
+    }
+    else if (Cobs == framing)
+    {
+        result = encodeCobs(data, size, output);
+    }
+    else
+    {
+        result = encodeSlip(data, size, output);
+    }
+
+    return result;
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+FrameDecoder::FrameDecoder(const Framing framing, uint8_t* storage, const std::size_t capacity)
+    : mFraming(framing)
+    , mStorage(storage)
+    , mCapacity(capacity)
+    , mSize(0UL)
+    , mStatus(Ok)
+    , mIsComplete(false)
+    , mIsStarted(false)
+    , mIsEscaped(false)
+    , mIsZeroPending(false)
+    , mRemaining(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+FrameDecoder::~FrameDecoder()
+{
+}
+
+//------------------------------------------------------------------------------
+std::size_t FrameDecoder::feed(const uint8_t* data, const std::size_t size)
+{
+    std::size_t result = 0UL;
+
+    if (mIsComplete)
+    {
+        // Waiting for next()
+    }
+    else if (Cobs == mFraming)
+    {
+        result = feedCobs(data, size);
+    }
+    else
+    {
+        result = feedSlip(data, size);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void FrameDecoder::next()
+{
+    mSize = 0UL;
+    mStatus = Ok;
+    mIsComplete = false;
+    mIsStarted = false;
+    mIsEscaped = false;
+    mIsZeroPending = false;
+    mRemaining = 0UL;
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+void FrameDecoder::put(const uint8_t* data, const std::size_t size)
+{
+    // An overflowed frame is dropped up to its delimiter
+    if ((mSize + size) > mCapacity)
+    {
+        mStatus = Overflow;
+    }
+    else if (mStatus != Overflow)
+    {
+        (void)memcpy(&mStorage[mSize], data, size);
+
+        mSize += size;
+    }
+    else
+    {
+        // Overflowed
+    }
+}
+
+//------------------------------------------------------------------------------
+std::size_t FrameDecoder::feedCobs(const uint8_t* data, const std::size_t size)
+{
+    static const uint8_t ZERO = 0x00U;
+
+    std::size_t result = 0UL;
+
+    while ((result < size) && !mIsComplete)
+    {
+        if (0UL == mRemaining)
+        {
+            // Code byte, the implicit zero of the previous block is dropped
+            // at the end of the frame
+            const uint8_t code = data[result];
+
+            result++;
+
+            if (COBS_DELIMITER == code)
+            {
+                mIsComplete = mIsStarted;
+            }
+            else
+            {
+                if (mIsZeroPending)
+                {
+                    put(&ZERO, 1UL);
+                }
+
+                mIsStarted = true;
+                mIsZeroPending = (code <= COBS_BLOCK_SIZE);
+                mRemaining = code - 1UL;
+            }
+        }
+        else
+        {
+            const std::size_t count = ((size - result) < mRemaining) ? (size - result) : mRemaining;
+
+            const std::size_t run = find(&data[result], count, COBS_DELIMITER, COBS_DELIMITER);
+
+            put(&data[result], run);
+
+            result += run;
+            mRemaining -= run;
+
+            // A delimiter inside a block ends a truncated frame
+            if (run < count)
+            {
+                if (mStatus != Overflow)
+                {
+                    mStatus = FrameError;
+                }
+
+                result++;
+
+                mIsComplete = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::size_t FrameDecoder::feedSlip(const uint8_t* data, const std::size_t size)
+{
+    std::size_t result = 0UL;
+
+    while ((result < size) && !mIsComplete)
+    {
+        if (mIsEscaped)
+        {
+            const uint8_t byte = data[result];
+
+            result++;
+
+            if (SLIP_ESC_END == byte)
+            {
+                put(&SLIP_END, 1UL);
+            }
+            else if (SLIP_ESC_ESC == byte)
+            {
+                put(&SLIP_ESC, 1UL);
+            }
+            else
+            {
+                // Kept as data, as RFC 1055 does
+                if (mStatus != Overflow)
+                {
+                    mStatus = FrameError;
+                }
+
+                put(&byte, 1UL);
+            }
+
+            mIsEscaped = false;
+        }
+        else
+        {
+            const std::size_t run = find(&data[result], size - result, SLIP_END, SLIP_ESC);
+
+            put(&data[result], run);
+
+            mIsStarted = mIsStarted || (run != 0UL);
+
+            result += run;
+
+            if (result < size)
+            {
+                if (SLIP_END == data[result])
+                {
+                    mIsComplete = mIsStarted;
+                }
+                else
+                {
+                    mIsStarted = true;
+                    mIsEscaped = true;
+                }
+
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+}
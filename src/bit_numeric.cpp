@@ -0,0 +1,456 @@
+//!
+//! \file bit_numeric.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Half precision, bfloat16 and fixed-point signal value types
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_numeric.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_NUMERIC_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Converts 16-bit floating point values, returns the number converted
+//!
+typedef std::size_t (*ToFloat)(const uint16_t* input,
+                               const std::size_t count,
+                               float* output);
+
+//!
+//! \brief Converts to 16-bit floating point values, returns the number converted
+//!
+typedef std::size_t (*FromFloat)(const float* input,
+                                 const std::size_t count,
+                                 uint16_t* output);
+
+//!
+//! \brief Converts fixed-point values, returns the number converted
+//!
+typedef std::size_t (*FixedS16ToFloat)(const int16_t* input,
+                                       const std::size_t count,
+                                       const float scale,
+                                       float* output);
+
+//!
+//! \brief Converts fixed-point values, returns the number converted
+//!
+typedef std::size_t (*FixedU16ToFloat)(const uint16_t* input,
+                                       const std::size_t count,
+                                       const float scale,
+                                       float* output);
+
+//!
+//! \brief Converts fixed-point values, returns the number converted
+//!
+typedef std::size_t (*FixedS32ToFloat)(const int32_t* input,
+                                       const std::size_t count,
+                                       const float scale,
+                                       float* output);
+
+//!
+//! \brief Array conversion kernels of the running CPU
+//!
+struct Kernels
+{
+    //!
+    //! \brief Half precision to float kernel
+    //!
+    ToFloat halfToFloat;
+
+    //!
+    //! \brief Float to half precision kernel
+    //!
+    FromFloat floatToHalf;
+
+    //!
+    //! \brief bfloat16 to float kernel
+    //!
+    ToFloat brainToFloat;
+
+    //!
+    //! \brief Float to bfloat16 kernel
+    //!
+    FromFloat floatToBrain;
+
+    //!
+    //! \brief Signed 16-bit fixed-point kernel
+    //!
+    FixedS16ToFloat fixedS16;
+
+    //!
+    //! \brief Unsigned 16-bit fixed-point kernel
+    //!
+    FixedU16ToFloat fixedU16;
+
+    //!
+    //! \brief Signed 32-bit fixed-point kernel
+    //!
+    FixedS32ToFloat fixedS32;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+template <typename T, typename U>
+std::size_t convertNone(const T* input, const std::size_t count, U* output)
+{
+    (void) input;
+    (void) count;
+    (void) output;
+
+    return 0UL;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+std::size_t fixedNone(const T* input,
+                      const std::size_t count,
+                      const float scale,
+                      float* output)
+{
+    (void) input;
+    (void) count;
+    (void) scale;
+    (void) output;
+
+    return 0UL;
+}
+
+//------------------------------------------------------------------------------
+float fixedScale(const std::size_t fraction)
+{
+    return 1.0F / static_cast<float>(1ULL << fraction);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void fixedScalar(const T* input, const std::size_t count, const float scale, float* output)
+{
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        output[i] = static_cast<float>(input[i]) * scale;
+    }
+}
+
+#ifdef BIT_NUMERIC_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx,f16c")))
+std::size_t halfToFloatF16c(const uint16_t* input, const std::size_t count, float* output)
+{
+    std::size_t i = 0UL;
+
+    for (; (i + 8UL) <= count; i += 8UL)
+    {
+        const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+
+        _mm256_storeu_ps(&output[i], _mm256_cvtph_ps(bits));
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx,f16c")))
+std::size_t floatToHalfF16c(const float* input, const std::size_t count, uint16_t* output)
+{
+    std::size_t i = 0UL;
+
+    for (; (i + 8UL) <= count; i += 8UL)
+    {
+        const __m128i bits = _mm256_cvtps_ph(_mm256_loadu_ps(&input[i]), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), bits);
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+std::size_t halfToFloatAvx512(const uint16_t* input, const std::size_t count, float* output)
+{
+    std::size_t i = 0UL;
+
+    for (; (i + 16UL) <= count; i += 16UL)
+    {
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input[i]));
+
+        // The zero-masking form does not merge into an undefined vector
+        _mm512_storeu_ps(&output[i], _mm512_maskz_cvtph_ps(0xFFFF, bits));
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+std::size_t floatToHalfAvx512(const float* input, const std::size_t count, uint16_t* output)
+{
+    std::size_t i = 0UL;
+
+    for (; (i + 16UL) <= count; i += 16UL)
+    {
+        // Explicit zero merge source, the unmasked form merges into an
+        // undefined vector
+        const __m256i bits = _mm512_mask_cvtps_ph(_mm256_setzero_si256(),
+                                                  0xFFFF,
+                                                  _mm512_loadu_ps(&input[i]),
+                                                  _MM_FROUND_TO_NEAREST_INT);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]), bits);
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+std::size_t brainToFloatAvx2(const uint16_t* input, const std::size_t count, float* output)
+{
+    std::size_t i = 0UL;
+
+    for (; (i + 8UL) <= count; i += 8UL)
+    {
+        const __m256i bits = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i])));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]), _mm256_slli_epi32(bits, 16));
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+std::size_t floatToBrainAvx2(const float* input, const std::size_t count, uint16_t* output)
+{
+    const __m256i magnitude = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i half = _mm256_set1_epi32(0x7FFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+
+    std::size_t i = 0UL;
+
+    for (; (i + 8UL) <= count; i += 8UL)
+    {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input[i]));
+
+        const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(data, 16), one);
+
+        const __m256i rounded = _mm256_srli_epi32(
+                _mm256_add_epi32(_mm256_add_epi32(data, half), odd), 16);
+
+        const __m256i nan = _mm256_or_si256(_mm256_srli_epi32(data, 16), quiet);
+
+        const __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(data, magnitude), infinity);
+
+        const __m256i bits = _mm256_blendv_epi8(rounded, nan, isNan);
+
+        const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(bits, bits), 0x08);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm256_castsi256_si128(words));
+    }
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline __m256i loadStep(const int16_t* input)
+{
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline __m256i loadStep(const uint16_t* input)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline __m256i loadStep(const int32_t* input)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+__attribute__((target("avx2")))
+std::size_t fixedAvx2(const T* input,
+                      const std::size_t count,
+                      const float scale,
+                      float* output)
+{
+    const __m256 factor = _mm256_set1_ps(scale);
+
+    std::size_t i = 0UL;
+
+    for (; (i + 8UL) <= count; i += 8UL)
+    {
+        _mm256_storeu_ps(&output[i],
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(loadStep(&input[i])), factor));
+    }
+
+    return i;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+Kernels selectKernels()
+{
+    Kernels result = { &convertNone<uint16_t, float>,
+                       &convertNone<float, uint16_t>,
+                       &convertNone<uint16_t, float>,
+                       &convertNone<float, uint16_t>,
+                       &fixedNone<int16_t>,
+                       &fixedNone<uint16_t>,
+                       &fixedNone<int32_t> };
+
+#ifdef BIT_NUMERIC_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        result.halfToFloat = &halfToFloatAvx512;
+        result.floatToHalf = &floatToHalfAvx512;
+    }
+    else if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+    {
+        result.halfToFloat = &halfToFloatF16c;
+        result.floatToHalf = &floatToHalfF16c;
+    }
+    else
+    {
+        // Scalar kernels
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        result.brainToFloat = &brainToFloatAvx2;
+        result.floatToBrain = &floatToBrainAvx2;
+        result.fixedS16 = &fixedAvx2<int16_t>;
+        result.fixedU16 = &fixedAvx2<uint16_t>;
+        result.fixedS32 = &fixedAvx2<int32_t>;
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+const Kernels& kernels()
+{
+    static const Kernels result = selectKernels();
+
+    return result;
+}
+}
+
+//--------------------------- Public methods -----------------------------------
+
+//------------------------------------------------------------------------------
+void halfToFloat(const uint16_t* input, const std::size_t count, float* output)
+{
+    for (std::size_t i = kernels().halfToFloat(input, count, output); i < count; i++)
+    {
+        output[i] = halfToFloat(input[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void floatToHalf(const float* input, const std::size_t count, uint16_t* output)
+{
+    for (std::size_t i = kernels().floatToHalf(input, count, output); i < count; i++)
+    {
+        output[i] = floatToHalf(input[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void brainToFloat(const uint16_t* input, const std::size_t count, float* output)
+{
+    for (std::size_t i = kernels().brainToFloat(input, count, output); i < count; i++)
+    {
+        output[i] = brainToFloat(input[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void floatToBrain(const float* input, const std::size_t count, uint16_t* output)
+{
+    for (std::size_t i = kernels().floatToBrain(input, count, output); i < count; i++)
+    {
+        output[i] = floatToBrain(input[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void fixedToFloat(const int16_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output)
+{
+    const float scale = fixedScale(fraction);
+
+    const std::size_t done = kernels().fixedS16(input, count, scale, output);
+
+    fixedScalar(&input[done], count - done, scale, &output[done]);
+}
+
+//------------------------------------------------------------------------------
+void fixedToFloat(const uint16_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output)
+{
+    const float scale = fixedScale(fraction);
+
+    const std::size_t done = kernels().fixedU16(input, count, scale, output);
+
+    fixedScalar(&input[done], count - done, scale, &output[done]);
+}
+
+//------------------------------------------------------------------------------
+void fixedToFloat(const int32_t* input,
+                  const std::size_t count,
+                  const std::size_t fraction,
+                  float* output)
+{
+    const float scale = fixedScale(fraction);
+
+    const std::size_t done = kernels().fixedS32(input, count, scale, output);
+
+    fixedScalar(&input[done], count - done, scale, &output[done]);
+}
+}
@@ -0,0 +1,401 @@
+//!
+//! \file bit_packed.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Densely packed arrays of fixed width unsigned integers
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_packed.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_PACKED_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Elements per unpack step (one 32-bit lane each)
+//!
+const std::size_t STEP_COUNT = 8UL;
+
+//!
+//! \brief Widest element of an unpack step (shift and element in 32 bits)
+//!
+const std::size_t STEP_MAX_BITS = U32_BIT_COUNT - (U08_BIT_COUNT - 1UL);
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Extracts a range of elements, returns the number extracted
+//!
+typedef std::size_t (*Unpack16)(const uint8_t* data,
+                                const std::size_t size,
+                                const std::size_t bits,
+                                const std::size_t first,
+                                const std::size_t count,
+                                uint16_t* output);
+
+//!
+//! \brief Extracts a range of elements, returns the number extracted
+//!
+typedef std::size_t (*Unpack32)(const uint8_t* data,
+                                const std::size_t size,
+                                const std::size_t bits,
+                                const std::size_t first,
+                                const std::size_t count,
+                                uint32_t* output);
+
+//!
+//! \brief Unpack kernels of the running CPU
+//!
+struct Kernels
+{
+    //!
+    //! \brief 16-bit element kernel
+    //!
+    Unpack16 unpack16;
+
+    //!
+    //! \brief 32-bit element kernel
+    //!
+    Unpack32 unpack32;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+template <typename T>
+void unpackScalar(const uint8_t* data,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  T* output)
+{
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        const std::size_t offset = (first + i) * bits;
+
+        output[i] = static_cast<T>((loadU64(&data[offset / U08_BIT_COUNT]) <<
+                                    (offset % U08_BIT_COUNT)) >> (U64_BIT_COUNT - bits));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+std::size_t unpackNone(const uint8_t* data,
+                       const std::size_t size,
+                       const std::size_t bits,
+                       const std::size_t first,
+                       const std::size_t count,
+                       T* output)
+{
+    (void) data;
+    (void) size;
+    (void) bits;
+    (void) first;
+    (void) count;
+    (void) output;
+
+    return 0UL;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void packScalar(const T* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count)
+{
+    const uint64_t mask = ~0ULL >> (U64_BIT_COUNT - bits);
+
+    const std::size_t offset = first * bits;
+
+    std::size_t byte = offset / U08_BIT_COUNT;
+
+    // The accumulator starts with the bits preceding the range in its first
+    // byte. Only its accBits lowest bits are pending
+    std::size_t accBits = offset % U08_BIT_COUNT;
+
+    uint64_t acc = (accBits != 0UL) ? (data[byte] >> (U08_BIT_COUNT - accBits)) : 0ULL;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        while ((accBits + bits) > U64_BIT_COUNT)
+        {
+            data[byte] = static_cast<uint8_t>(acc >> (accBits - U08_BIT_COUNT));
+
+            byte++;
+            accBits -= U08_BIT_COUNT;
+        }
+
+        acc = (acc << bits) | (static_cast<uint64_t>(input[i]) & mask);
+        accBits += bits;
+
+        if (accBits >= U32_BIT_COUNT)
+        {
+            const uint32_t word = static_cast<uint32_t>(acc >> (accBits - U32_BIT_COUNT));
+
+            data[byte] = static_cast<uint8_t>(word >> 24);
+            data[byte + 1UL] = static_cast<uint8_t>(word >> 16);
+            data[byte + 2UL] = static_cast<uint8_t>(word >> 8);
+            data[byte + 3UL] = static_cast<uint8_t>(word);
+
+            byte += sizeof(uint32_t);
+            accBits -= U32_BIT_COUNT;
+        }
+    }
+
+    while (accBits >= U08_BIT_COUNT)
+    {
+        data[byte] = static_cast<uint8_t>(acc >> (accBits - U08_BIT_COUNT));
+
+        byte++;
+        accBits -= U08_BIT_COUNT;
+    }
+
+    // The bits following the range in the last byte are kept
+    if (accBits != 0UL)
+    {
+        const uint8_t keep = static_cast<uint8_t>(0xFFU >> accBits);
+
+        data[byte] = static_cast<uint8_t>(((acc << (U08_BIT_COUNT - accBits)) & ~keep) |
+                                          (data[byte] & keep));
+    }
+}
+
+#ifdef BIT_PACKED_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline void storeStep(const __m256i elements, uint16_t* output)
+{
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(elements, elements), 0x08);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_castsi256_si128(words));
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline void storeStep(const __m256i elements, uint32_t* output)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), elements);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+__attribute__((target("avx2")))
+std::size_t unpackAvx2(const uint8_t* data,
+                       const std::size_t size,
+                       const std::size_t bits,
+                       const std::size_t first,
+                       const std::size_t count,
+                       T* output)
+{
+    std::size_t result = 0UL;
+
+    if ((bits <= STEP_MAX_BITS) && (bits <= (sizeof(T) * U08_BIT_COUNT)))
+    {
+        // A step starts on a byte (8 elements), its upper lane holds elements
+        // 4 - 7 and starts on the byte holding element 4
+        const std::size_t upperByte = (4UL * bits) / U08_BIT_COUNT;
+        const std::size_t upperBit = (4UL * bits) % U08_BIT_COUNT;
+
+        uint8_t shuffle[sizeof(__m256i)];
+        uint32_t shifts[STEP_COUNT];
+
+        for (std::size_t e = 0UL; e < STEP_COUNT; e++)
+        {
+            const std::size_t lane = e / 4UL;
+            const std::size_t bit = ((e % 4UL) * bits) + ((lane != 0UL) ? upperBit : 0UL);
+
+            // 4 bytes, the first one most significant
+            for (std::size_t k = 0UL; k < sizeof(uint32_t); k++)
+            {
+                shuffle[(e * sizeof(uint32_t)) + k] =
+                        static_cast<uint8_t>((bit / U08_BIT_COUNT) + (sizeof(uint32_t) - 1UL - k));
+            }
+
+            shifts[e] = static_cast<uint32_t>(bit % U08_BIT_COUNT);
+        }
+
+        const __m256i control = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffle));
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shifts));
+        const __m128i right = _mm_cvtsi32_si128(static_cast<int>(U32_BIT_COUNT - bits));
+
+        // Up to a byte aligned element, then whole steps while the loads
+        // stay within the storage
+        std::size_t i = ((STEP_COUNT - (first % STEP_COUNT)) % STEP_COUNT);
+
+        i = (i < count) ? i : count;
+
+        unpackScalar(data, bits, first, i, output);
+
+        while (((i + STEP_COUNT) <= count) &&
+               (((((first + i) * bits) / U08_BIT_COUNT) + upperByte + sizeof(__m128i)) <= size))
+        {
+            const uint8_t* bytes = &data[((first + i) * bits) / U08_BIT_COUNT];
+
+            const __m256i source = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[upperByte])), 1);
+
+            const __m256i elements = _mm256_srl_epi32(
+                    _mm256_sllv_epi32(_mm256_shuffle_epi8(source, control), left), right);
+
+            storeStep(elements, &output[i]);
+
+            i += STEP_COUNT;
+        }
+
+        result = i;
+    }
+
+    return result;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+Kernels selectKernels()
+{
+    Kernels result = { &unpackNone<uint16_t>, &unpackNone<uint32_t> };
+
+#ifdef BIT_PACKED_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        result.unpack16 = &unpackAvx2<uint16_t>;
+        result.unpack32 = &unpackAvx2<uint32_t>;
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+const Kernels& kernels()
+{
+    static const Kernels result = selectKernels();
+
+    return result;
+}
+}
+
+//--------------------------- Public methods -----------------------------------
+
+//------------------------------------------------------------------------------
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint8_t* output)
+{
+    (void) size;
+
+    unpackScalar(data, bits, first, count, output);
+}
+
+//------------------------------------------------------------------------------
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint16_t* output)
+{
+    const std::size_t done = kernels().unpack16(data, size, bits, first, count, output);
+
+    unpackScalar(data, bits, first + done, count - done, &output[done]);
+}
+
+//------------------------------------------------------------------------------
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint32_t* output)
+{
+    const std::size_t done = kernels().unpack32(data, size, bits, first, count, output);
+
+    unpackScalar(data, bits, first + done, count - done, &output[done]);
+}
+
+//------------------------------------------------------------------------------
+void unpackFields(const uint8_t* data,
+                  const std::size_t size,
+                  const std::size_t bits,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint64_t* output)
+{
+    (void) size;
+
+    unpackScalar(data, bits, first, count, output);
+}
+
+//------------------------------------------------------------------------------
+void packFields(const uint8_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count)
+{
+    packScalar(input, data, bits, first, count);
+}
+
+//------------------------------------------------------------------------------
+void packFields(const uint16_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count)
+{
+    packScalar(input, data, bits, first, count);
+}
+
+//------------------------------------------------------------------------------
+void packFields(const uint32_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count)
+{
+    packScalar(input, data, bits, first, count);
+}
+
+//------------------------------------------------------------------------------
+void packFields(const uint64_t* input,
+                uint8_t* data,
+                const std::size_t bits,
+                const std::size_t first,
+                const std::size_t count)
+{
+    packScalar(input, data, bits, first, count);
+}
+}
@@ -0,0 +1,221 @@
+//!
+//! \file bit_recorder.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Per-thread flight recorder of codec events
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_recorder.h"
+
+#include <cstdio>
+
+namespace bit
+{
+//------------------------ Static member definitions ---------------------------
+
+Recorder::Ring Recorder::sRings[RECORDER_MAX_THREADS];
+
+std::atomic<std::size_t> Recorder::sThreads(0UL);
+
+std::atomic<uint64_t> Recorder::sFree(0ULL);
+
+thread_local Recorder::Ring* Recorder::tRing = 0;
+
+thread_local uint64_t Recorder::tFrame = 0ULL;
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+std::size_t Recorder::threads()
+{
+    const std::size_t result = sThreads.load(std::memory_order_acquire);
+
+    return (result < RECORDER_MAX_THREADS) ? result : RECORDER_MAX_THREADS;
+}
+
+//------------------------------------------------------------------------------
+std::size_t Recorder::collect(const std::size_t thread, RecorderEvent* events)
+{
+    const Ring& ring = sRings[thread % RECORDER_MAX_THREADS];
+
+    const uint64_t head = ring.head.load(std::memory_order_acquire);
+
+    const uint64_t first = (head > RECORDER_EVENTS) ? (head - RECORDER_EVENTS) : 0ULL;
+
+    std::size_t result = 0UL;
+
+    for (uint64_t i = first; i < head; i++)
+    {
+        const std::atomic<uint64_t>* slot = ring.slots[i & (RECORDER_EVENTS - 1UL)];
+
+        const uint64_t sequence = slot[3].load(std::memory_order_acquire);
+
+        const uint64_t timestamp = slot[0].load(std::memory_order_relaxed);
+        const uint64_t timing = slot[1].load(std::memory_order_relaxed);
+        const uint64_t packed = slot[2].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // A writer reached the slot if its sequence changed or never matched
+        if ((sequence == (i + 1ULL)) &&
+            (slot[3].load(std::memory_order_relaxed) == sequence))
+        {
+            RecorderEvent& event = events[result];
+
+            event.timestamp = timestamp;
+            event.frame = static_cast<uint32_t>(timing);
+            event.duration = static_cast<uint32_t>(timing >> U32_BIT_COUNT);
+            event.signal = static_cast<uint16_t>(packed);
+            event.thread = static_cast<uint16_t>(thread % RECORDER_MAX_THREADS);
+            event.operation = static_cast<uint8_t>(packed >> U16_BIT_COUNT);
+            event.status = static_cast<uint8_t>(packed >> (U16_BIT_COUNT + U08_BIT_COUNT));
+            event.reserved = 0U;
+
+            result++;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Recorder::Status Recorder::dump(const char* path)
+{
+    RecorderEvent events[RECORDER_EVENTS];
+
+    RecorderHeader header;
+
+    header.magic = RECORDER_MAGIC;
+    header.version = RECORDER_VERSION;
+    header.eventSize = static_cast<uint16_t>(sizeof(RecorderEvent));
+    header.eventCount = 0ULL;
+
+    Status result = OpenError;
+
+    std::FILE* file = std::fopen(path, "wb");
+
+    if (file != 0)
+    {
+        result = Ok;
+
+        if (std::fwrite(&header, sizeof(header), 1U, file) != 1U)
+        {
+            result = WriteError;
+        }
+
+        const std::size_t count = threads();
+
+        for (std::size_t thread = 0UL; (thread < count) && (Ok == result); thread++)
+        {
+            const std::size_t size = collect(thread, events);
+
+            if (std::fwrite(events, sizeof(RecorderEvent), size, file) == size)
+            {
+                header.eventCount += size;
+            }
+            else
+            {
+                result = WriteError;
+            }
+        }
+
+        if ((std::fseek(file, 0L, SEEK_SET) != 0) ||
+            (std::fwrite(&header, sizeof(header), 1U, file) != 1U))
+        {
+            result = WriteError;
+        }
+
+        if (std::fclose(file) != 0)
+        {
+            result = WriteError;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void Recorder::reset()
+{
+    for (std::size_t thread = 0UL; thread < RECORDER_MAX_THREADS; thread++)
+    {
+        for (std::size_t i = 0UL; i < RECORDER_EVENTS; i++)
+        {
+            sRings[thread].slots[i][3].store(0ULL, std::memory_order_relaxed);
+        }
+
+        sRings[thread].head.store(0ULL, std::memory_order_release);
+    }
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+Recorder::Ring& Recorder::attach()
+{
+    Ring* ring = 0;
+
+    uint64_t free = sFree.load(std::memory_order_acquire);
+
+    // Rings of exited threads first, their last events are acquired
+    while ((0 == ring) && (free != 0ULL))
+    {
+        const std::size_t index = trailingZeros(free);
+
+        if (sFree.compare_exchange_weak(free, free & (free - 1ULL),
+                                        std::memory_order_acquire))
+        {
+            ring = &sRings[index];
+        }
+    }
+
+    if (0 == ring)
+    {
+        const std::size_t index = sThreads.fetch_add(1UL, std::memory_order_acq_rel);
+
+        ring = &sRings[RECORDER_MAX_THREADS - 1UL];
+
+        if (index < (RECORDER_MAX_THREADS - 1UL))
+        {
+            ring = &sRings[index];
+        }
+    }
+
+    // Constructed once per thread, destroyed when the thread exits
+    static thread_local Release release;
+
+    tRing = ring;
+
+    return *ring;
+}
+
+//------------------------------------------------------------------------------
+Recorder::Release::~Release()
+{
+    Ring* ring = tRing;
+
+    if ((ring != 0) && !isShared(*ring))
+    {
+        // Events from later thread_local destructors go to the shared ring
+        tRing = &sRings[RECORDER_MAX_THREADS - 1UL];
+
+        (void) sFree.fetch_or(1ULL << static_cast<std::size_t>(ring - sRings),
+                              std::memory_order_release);
+    }
+}
+}
@@ -0,0 +1,750 @@
+//!
+//! \file bit_scheduler.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Multi-channel decode scheduler with work stealing
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_scheduler.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Index of a channel without open batch
+//!
+const std::size_t NO_BATCH = ~0UL;
+
+//!
+//! \brief Number of failed steal rounds before a worker goes to sleep
+//!
+const std::size_t SPIN_COUNT = 64UL;
+
+//!
+//! \brief Maximum sleep of an idle worker
+//!
+const std::chrono::milliseconds SLEEP_TIME(1);
+
+//!
+//! \brief Batch states
+//!
+enum BatchState
+{
+    Free = 0,
+    Filling,
+    Queued
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+uint64_t now()
+{
+    return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//------------------------------------------------------------------------------
+std::size_t roundUp(const std::size_t value)
+{
+    std::size_t result = 1UL;
+
+    while (result < value)
+    {
+        result <<= 1U;
+    }
+
+    return result;
+}
+}
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Batch of frames of one channel
+//!
+struct Scheduler::Batch
+{
+    //!
+    //! \brief BatchState
+    //!
+    std::atomic<uint32_t> state;
+
+    //!
+    //! \brief Owning channel
+    //!
+    std::size_t channel;
+
+    //!
+    //! \brief Number of frames
+    //!
+    std::size_t count;
+
+    //!
+    //! \brief Frame bytes
+    //!
+    std::vector<uint8_t> frames;
+
+    //!
+    //! \brief Submit time of every frame (ns)
+    //!
+    std::vector<uint64_t> times;
+};
+
+//!
+//! \brief Decode channel
+//!
+struct Scheduler::Channel
+{
+    //!
+    //! \brief Decode plan
+    //!
+    DecodeFunction function;
+
+    //!
+    //! \brief Decode plan context
+    //!
+    void* context;
+
+    //!
+    //! \brief First batch of the channel in mBatches
+    //!
+    std::size_t first;
+
+    //!
+    //! \brief Open (filling) batch, NO_BATCH if none
+    //!
+    std::size_t open;
+
+    //!
+    //! \brief Next batch to try when opening one
+    //!
+    std::size_t next;
+
+    //!
+    //! \brief Worker the batches are queued to
+    //!
+    std::size_t home;
+
+    //!
+    //! \brief Keeps the submit counters off the line of the members above
+    //!
+    uint8_t padding0[CACHE_LINE_SIZE];
+
+    //!
+    //! \brief Frames submitted and not decoded yet
+    //!
+    std::atomic<std::size_t> depth;
+
+    //!
+    //! \brief Frames submitted
+    //!
+    std::atomic<uint64_t> submitted;
+
+    //!
+    //! \brief Frames dropped
+    //!
+    std::atomic<uint64_t> dropped;
+
+    //!
+    //! \brief Keeps the decode counters off the line of the submit counters
+    //!
+    uint8_t padding1[CACHE_LINE_SIZE];
+
+    //!
+    //! \brief Frames decoded
+    //!
+    std::atomic<uint64_t> decoded;
+
+    //!
+    //! \brief Sum of the latencies (ns)
+    //!
+    std::atomic<uint64_t> latencySum;
+
+    //!
+    //! \brief Maximum latency (ns)
+    //!
+    std::atomic<uint64_t> latencyMax;
+
+    //!
+    //! \brief Keeps the decode counters off the line of the next allocation
+    //!
+    uint8_t padding2[CACHE_LINE_SIZE];
+};
+
+//!
+//! \brief Run queue of a worker
+//!
+//! \details    Bounded lock-free MPMC queue of batch indices: channels push,
+//!             the owner and the thieves pop in FIFO order. Its capacity is
+//!             the total number of batches, so a push never fails
+//!
+//! \note       Hot members are separated by padding rather than alignas, the
+//!             C++11 operator new does not honour extended alignments
+//!
+struct Scheduler::Worker
+{
+    //!
+    //! \brief Queue cell
+    //!
+    struct Cell
+    {
+        //!
+        //! \brief Position of the cell: pos when free, pos + 1 when full
+        //!
+        std::atomic<std::size_t> sequence;
+
+        //!
+        //! \brief Batch index
+        //!
+        std::size_t task;
+    };
+
+    //!
+    //! \brief Constructs an empty queue
+    //!
+    //! \param capacity The capacity (power of two)
+    //!
+    explicit Worker(const std::size_t capacity)
+        : mask(capacity - 1UL)
+        , cells(new Cell[capacity])
+        , tail(0UL)
+        , head(0UL)
+    {
+        for (std::size_t i = 0UL; i < capacity; i++)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    //!
+    //! \brief Destroys the queue
+    //!
+    ~Worker()
+    {
+        delete[] cells;
+    }
+
+    //!
+    //! \brief Queues a batch
+    //!
+    //! \param task The batch index
+    //!
+    void push(const std::size_t task)
+    {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+
+        bool isDone = false;
+
+        while (!isDone)
+        {
+            Cell& cell = cells[pos & mask];
+
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == pos)
+            {
+                isDone = tail.compare_exchange_weak(pos, pos + 1UL,
+                                                    std::memory_order_relaxed);
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cells[pos & mask].task = task;
+        cells[pos & mask].sequence.store(pos + 1UL, std::memory_order_release);
+    }
+
+    //!
+    //! \brief Takes the oldest batch
+    //!
+    //! \param task The batch index
+    //!
+    //! \return bool    True if a batch was taken, false if the queue is empty
+    //!
+    bool pop(std::size_t& task)
+    {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+
+        bool result = false;
+
+        bool isDone = false;
+
+        while (!isDone)
+        {
+            Cell& cell = cells[pos & mask];
+
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == (pos + 1UL))
+            {
+                result = head.compare_exchange_weak(pos, pos + 1UL,
+                                                    std::memory_order_relaxed);
+
+                isDone = result;
+            }
+            else if (sequence < (pos + 1UL))
+            {
+                isDone = true;
+            }
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (result)
+        {
+            task = cells[pos & mask].task;
+
+            cells[pos & mask].sequence.store(pos + mask + 1UL,
+                                             std::memory_order_release);
+        }
+
+        return result;
+    }
+
+    //!
+    //! \brief Cell index mask
+    //!
+    const std::size_t mask;
+
+    //!
+    //! \brief Cells
+    //!
+    Cell* cells;
+
+    //!
+    //! \brief Keeps the tail off the line of the members above
+    //!
+    uint8_t padding0[CACHE_LINE_SIZE];
+
+    //!
+    //! \brief Next cell to fill
+    //!
+    std::atomic<std::size_t> tail;
+
+    //!
+    //! \brief Keeps the head off the line of the tail
+    //!
+    uint8_t padding1[CACHE_LINE_SIZE];
+
+    //!
+    //! \brief Next cell to take
+    //!
+    std::atomic<std::size_t> head;
+
+    //!
+    //! \brief Keeps the head off the line of the next allocation
+    //!
+    uint8_t padding2[CACHE_LINE_SIZE];
+};
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+Scheduler::Scheduler(const std::size_t workers,
+                     const std::size_t frameSize,
+                     const std::size_t batchSize,
+                     const std::size_t batches)
+    : mFrameSize(frameSize)
+    , mBatchSize((batchSize != 0UL) ? batchSize : 1UL)
+    , mBatchCount((batches != 0UL) ? batches : 1UL)
+    , mChannels()
+    , mBatches()
+    , mWorkers()
+    , mThreads()
+    , mIsRunning(false)
+    , mSleepers(0UL)
+    , mMutex()
+    , mWakeUp()
+{
+    const std::size_t count = (workers != 0UL) ? workers : 1UL;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        mWorkers.push_back(0);
+    }
+}
+
+//------------------------------------------------------------------------------
+Scheduler::~Scheduler()
+{
+    stop();
+
+    for (std::size_t i = 0UL; i < mWorkers.size(); i++)
+    {
+        delete mWorkers[i];
+    }
+
+    for (std::size_t i = 0UL; i < mBatches.size(); i++)
+    {
+        delete mBatches[i];
+    }
+
+    for (std::size_t i = 0UL; i < mChannels.size(); i++)
+    {
+        delete mChannels[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+std::size_t Scheduler::addChannel(DecodeFunction function, void* context)
+{
+    Channel* channel = new Channel();
+
+    channel->function = function;
+    channel->context = context;
+    channel->first = mBatches.size();
+    channel->open = NO_BATCH;
+    channel->next = 0UL;
+    channel->home = mChannels.size() % mWorkers.size();
+    channel->depth.store(0UL);
+    channel->submitted.store(0ULL);
+    channel->dropped.store(0ULL);
+    channel->decoded.store(0ULL);
+    channel->latencySum.store(0ULL);
+    channel->latencyMax.store(0ULL);
+
+    for (std::size_t i = 0UL; i < mBatchCount; i++)
+    {
+        Batch* batch = new Batch();
+
+        batch->state.store(Free);
+        batch->channel = mChannels.size();
+        batch->count = 0UL;
+        batch->frames.resize(mBatchSize * mFrameSize);
+        batch->times.resize(mBatchSize);
+
+        mBatches.push_back(batch);
+    }
+
+    mChannels.push_back(channel);
+
+    return mChannels.size() - 1UL;
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::start()
+{
+    if (!mIsRunning.load() && mThreads.empty())
+    {
+        const std::size_t capacity = roundUp(mBatches.size() + 1UL);
+
+        for (std::size_t i = 0UL; i < mWorkers.size(); i++)
+        {
+            delete mWorkers[i];
+
+            mWorkers[i] = new Worker(capacity);
+        }
+
+        mIsRunning.store(true);
+
+        for (std::size_t i = 0UL; i < mWorkers.size(); i++)
+        {
+            mThreads.push_back(std::thread(&Scheduler::run, this, i));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::stop()
+{
+    if (mIsRunning.load())
+    {
+        // Open batches are queued, the workers drain them before leaving
+        for (std::size_t i = 0UL; i < mChannels.size(); i++)
+        {
+            flush(i);
+        }
+
+        mIsRunning.store(false);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            mWakeUp.notify_all();
+        }
+
+        for (std::size_t i = 0UL; i < mThreads.size(); i++)
+        {
+            mThreads[i].join();
+        }
+
+        mThreads.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+Scheduler::Status Scheduler::submit(const std::size_t channel,
+                                    const uint8_t* data)
+{
+    Status result = InvalidChannel;
+
+    if (channel >= mChannels.size())
+    {
+        result = InvalidChannel;
+    }
+    else if (!mIsRunning.load(std::memory_order_acquire))
+    {
+        result = Stopped;
+    }
+    else
+    {
+        Channel& ch = *mChannels[channel];
+
+        result = Full;
+
+        for (std::size_t i = 0UL; (ch.open == NO_BATCH) && (i < mBatchCount); i++)
+        {
+            const std::size_t index = ch.first + ((ch.next + i) % mBatchCount);
+
+            if (mBatches[index]->state.load(std::memory_order_acquire) == Free)
+            {
+                mBatches[index]->state.store(Filling, std::memory_order_relaxed);
+                mBatches[index]->count = 0UL;
+
+                ch.open = index;
+                ch.next = (ch.next + i + 1UL) % mBatchCount;
+            }
+        }
+
+        if (ch.open != NO_BATCH)
+        {
+            Batch& batch = *mBatches[ch.open];
+
+            (void) std::memcpy(&batch.frames[batch.count * mFrameSize], data,
+                               mFrameSize);
+
+            batch.times[batch.count] = now();
+            batch.count++;
+
+            (void) ch.depth.fetch_add(1UL, std::memory_order_relaxed);
+            (void) ch.submitted.fetch_add(1ULL, std::memory_order_relaxed);
+
+            if (batch.count == mBatchSize)
+            {
+                seal(ch);
+            }
+
+            result = Ok;
+        }
+        else
+        {
+            (void) ch.dropped.fetch_add(1ULL, std::memory_order_relaxed);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::flush(const std::size_t channel)
+{
+    if ((channel < mChannels.size()) && mIsRunning.load(std::memory_order_acquire))
+    {
+        Channel& ch = *mChannels[channel];
+
+        if ((ch.open != NO_BATCH) && (mBatches[ch.open]->count != 0UL))
+        {
+            seal(ch);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::wait()
+{
+    for (std::size_t i = 0UL; i < mChannels.size(); i++)
+    {
+        flush(i);
+    }
+
+    for (std::size_t i = 0UL; i < mChannels.size(); i++)
+    {
+        while (mChannels[i]->depth.load(std::memory_order_acquire) != 0UL)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+Scheduler::ChannelStatistics Scheduler::statistics(const std::size_t channel) const
+{
+    ChannelStatistics result = { 0UL, 0ULL, 0ULL, 0ULL, 0ULL, 0ULL };
+
+    if (channel < mChannels.size())
+    {
+        const Channel& ch = *mChannels[channel];
+
+        result.depth = ch.depth.load(std::memory_order_relaxed);
+        result.submitted = ch.submitted.load(std::memory_order_relaxed);
+        result.decoded = ch.decoded.load(std::memory_order_relaxed);
+        result.dropped = ch.dropped.load(std::memory_order_relaxed);
+        result.latencyMax = ch.latencyMax.load(std::memory_order_relaxed);
+
+        if (result.decoded != 0ULL)
+        {
+            result.latencyMean =
+                    ch.latencySum.load(std::memory_order_relaxed) / result.decoded;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::size_t Scheduler::depth(const std::size_t channel) const
+{
+    std::size_t result = 0UL;
+
+    if (channel < mChannels.size())
+    {
+        result = mChannels[channel]->depth.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+void Scheduler::seal(Channel& channel)
+{
+    const std::size_t task = channel.open;
+
+    channel.open = NO_BATCH;
+
+    mBatches[task]->state.store(Queued, std::memory_order_relaxed);
+
+    mWorkers[channel.home]->push(task);
+
+    if (mSleepers.load(std::memory_order_seq_cst) != 0UL)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mWakeUp.notify_one();
+    }
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::process(const std::size_t worker, const std::size_t task)
+{
+    Batch& batch = *mBatches[task];
+
+    Channel& channel = *mChannels[batch.channel];
+
+    uint64_t latencySum = 0ULL;
+    uint64_t latencyMax = 0ULL;
+
+    for (std::size_t i = 0UL; i < batch.count; i++)
+    {
+        BufferView frame(&batch.frames[i * mFrameSize], mFrameSize);
+
+        channel.function(channel.context, worker, frame);
+
+        const uint64_t latency = now() - batch.times[i];
+
+        latencySum += latency;
+        latencyMax = (latency > latencyMax) ? latency : latencyMax;
+    }
+
+    uint64_t max = channel.latencyMax.load(std::memory_order_relaxed);
+
+    while ((latencyMax > max) &&
+           !channel.latencyMax.compare_exchange_weak(max, latencyMax,
+                                                     std::memory_order_relaxed))
+    {
+    }
+
+    const std::size_t count = batch.count;
+
+    (void) channel.latencySum.fetch_add(latencySum, std::memory_order_relaxed);
+    (void) channel.decoded.fetch_add(count, std::memory_order_relaxed);
+
+    batch.state.store(Free, std::memory_order_release);
+
+    (void) channel.depth.fetch_sub(count, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+bool Scheduler::take(const std::size_t worker, std::size_t& task)
+{
+    bool result = mWorkers[worker]->pop(task);
+
+    for (std::size_t i = 1UL; !result && (i < mWorkers.size()); i++)
+    {
+        result = mWorkers[(worker + i) % mWorkers.size()]->pop(task);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void Scheduler::run(const std::size_t worker)
+{
+    std::size_t idle = 0UL;
+
+    bool isDone = false;
+
+    while (!isDone)
+    {
+        std::size_t task;
+
+        if (take(worker, task))
+        {
+            process(worker, task);
+
+            idle = 0UL;
+        }
+        else if (!mIsRunning.load(std::memory_order_acquire))
+        {
+            isDone = true;
+        }
+        else if (idle < SPIN_COUNT)
+        {
+            idle++;
+
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            (void) mSleepers.fetch_add(1UL, std::memory_order_seq_cst);
+
+            // The timeout covers a batch queued right before the increment
+            (void) mWakeUp.wait_for(lock, SLEEP_TIME);
+
+            (void) mSleepers.fetch_sub(1UL, std::memory_order_seq_cst);
+
+            idle = 0UL;
+        }
+    }
+}
+}
@@ -0,0 +1,601 @@
+//!
+//! \file bit_schema.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Run time signal layouts and their flat decode table
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_schema.h"
+
+#include "bit_counters.h"
+#include "bit_field.h"
+#include "bit_recorder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Entry flag of the Intel byte order
+//!
+const uint8_t FLAG_INTEL = 0x01U;
+
+//!
+//! \brief Entry flag of a field spanning 9 bytes
+//!
+const uint8_t FLAG_WIDE = 0x02U;
+
+//!
+//! \brief Maximum number of tokens of a description line
+//!
+const std::size_t MAX_TOKENS = 8UL;
+
+//!
+//! \brief Maximum byte size of a description line
+//!
+const std::size_t MAX_LINE = 256UL;
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Token of a description line
+//!
+struct Token
+{
+    //!
+    //! \brief First character
+    //!
+    const char* text;
+
+    //!
+    //! \brief Number of characters
+    //!
+    std::size_t size;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+bool isSpace(const char c)
+{
+    return (' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c);
+}
+
+//------------------------------------------------------------------------------
+bool isToken(const Token& token, const char* text)
+{
+    return (std::strlen(text) == token.size) &&
+           (std::strncmp(token.text, text, token.size) == 0);
+}
+
+//------------------------------------------------------------------------------
+bool toUnsigned(const Token& token, uint32_t& value)
+{
+    bool result = false;
+
+    // A longer token is no number within range, it is not copied
+    if ((token.size != 0UL) && (token.size < MAX_LINE))
+    {
+        char copy[MAX_LINE];
+        char* end = 0;
+
+        (void) std::memcpy(copy, token.text, token.size);
+
+        copy[token.size] = '\0';
+
+        const unsigned long number = std::strtoul(copy, &end, 10);
+
+        value = static_cast<uint32_t>(number);
+
+        result = (end == &copy[token.size]) && (number <= 0xFFFFFFUL);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+bool toDouble(const Token& token, double& value)
+{
+    bool result = false;
+
+    if ((token.size != 0UL) && (token.size < MAX_LINE))
+    {
+        char copy[MAX_LINE];
+        char* end = 0;
+
+        (void) std::memcpy(copy, token.text, token.size);
+
+        copy[token.size] = '\0';
+
+        value = std::strtod(copy, &end);
+
+        result = (end == &copy[token.size]);
+    }
+
+    return result;
+}
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+Schema::Schema()
+    : mSignals()
+    , mCount(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+Schema::~Schema()
+{
+}
+
+//------------------------------------------------------------------------------
+void Schema::clear()
+{
+    mCount = 0UL;
+}
+
+//------------------------------------------------------------------------------
+Schema::Status Schema::add(const SchemaSignal& signal)
+{
+    Status result = Ok;
+
+    if ((0U == signal.width) || (signal.width > U64_BIT_COUNT) ||
+        ((Boolean == signal.type) && (signal.width != 1U)) ||
+        ((Float32 == signal.type) && (signal.width != 32U)) ||
+        ((Float64 == signal.type) && (signal.width != 64U)) ||
+        (((Float16 == signal.type) || (BFloat16 == signal.type)) && (signal.width != 16U)))
+    {
+        result = RangeError;
+    }
+    else if (mCount >= SCHEMA_MAX_SIGNALS)
+    {
+        result = Overflow;
+    }
+    else
+    {
+        mSignals[mCount] = signal;
+
+        mSignals[mCount].name[SCHEMA_NAME_SIZE - 1UL] = '\0';
+
+        mCount++;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Schema::Status Schema::load(const char* text, std::size_t& line)
+{
+    Status result = Ok;
+
+    const char* cursor = text;
+
+    line = 0UL;
+
+    while ((Ok == result) && (*cursor != '\0'))
+    {
+        const char* end = std::strchr(cursor, '\n');
+
+        const std::size_t size = (end != 0) ? static_cast<std::size_t>(end - cursor) :
+                                 std::strlen(cursor);
+
+        line++;
+
+        result = parse(cursor, size);
+
+        cursor = &cursor[size];
+
+        if ('\n' == *cursor)
+        {
+            cursor++;
+        }
+    }
+
+    if (Ok == result)
+    {
+        line = 0UL;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Schema::Status Schema::loadFile(const char* path, std::size_t& line)
+{
+    Status result = OpenError;
+
+    line = 0UL;
+
+    std::FILE* file = std::fopen(path, "r");
+
+    if (file != 0)
+    {
+        char text[MAX_LINE];
+
+        result = Ok;
+
+        while ((Ok == result) && (std::fgets(text, sizeof(text), file) != 0))
+        {
+            const std::size_t size = std::strlen(text);
+
+            line++;
+
+            if ((size == (sizeof(text) - 1UL)) && (text[size - 1UL] != '\n'))
+            {
+                result = SyntaxError;
+            }
+            else
+            {
+                result = parse(text, size);
+            }
+        }
+
+        (void) std::fclose(file);
+
+        if (Ok == result)
+        {
+            line = 0UL;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::size_t Schema::find(const char* name) const
+{
+    std::size_t result = mCount;
+
+    for (std::size_t i = 0UL; (i < mCount) && (result == mCount); i++)
+    {
+        if (std::strcmp(mSignals[i].name, name) == 0)
+        {
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+DecodeTable::DecodeTable()
+    : mEntries()
+    , mCount(0UL)
+    , mSize(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+DecodeTable::~DecodeTable()
+{
+}
+
+//------------------------------------------------------------------------------
+void DecodeTable::compile(const Schema& schema)
+{
+    mCount = schema.count();
+    mSize = 0UL;
+
+    for (std::size_t i = 0UL; i < mCount; i++)
+    {
+        const SchemaSignal& signal = schema.signal(i);
+
+        Entry& entry = mEntries[i];
+
+        // Bit offset of the field from the start of its first byte
+        std::size_t first;
+
+        if (Intel == signal.order)
+        {
+            first = signal.position;
+
+            entry.flags = FLAG_INTEL;
+        }
+        else
+        {
+            first = ((signal.position / U08_BIT_COUNT) * U08_BIT_COUNT) +
+                    ((U08_BIT_COUNT - 1UL) - (signal.position % U08_BIT_COUNT));
+
+            entry.flags = 0U;
+        }
+
+        const std::size_t bit = first % U08_BIT_COUNT;
+
+        entry.byte = static_cast<uint32_t>(first / U08_BIT_COUNT);
+        entry.width = static_cast<uint8_t>(signal.width);
+        entry.type = static_cast<uint8_t>(signal.type);
+        entry.mask = ~0ULL >> (U64_BIT_COUNT - signal.width);
+        entry.scale = signal.scale;
+        entry.offset = signal.offset;
+
+        if ((bit + signal.width) > U64_BIT_COUNT)
+        {
+            entry.flags |= FLAG_WIDE;
+            entry.shift = static_cast<uint8_t>(bit);
+        }
+        else if (Intel == signal.order)
+        {
+            entry.shift = static_cast<uint8_t>(bit);
+        }
+        else
+        {
+            entry.shift = static_cast<uint8_t>(U64_BIT_COUNT - bit - signal.width);
+        }
+
+        const std::size_t end = (first + signal.width + U08_BIT_COUNT - 1UL) /
+                                U08_BIT_COUNT;
+
+        mSize = (end > mSize) ? end : mSize;
+    }
+}
+
+//------------------------------------------------------------------------------
+DecodeTable::Status DecodeTable::decodeRaw(const uint8_t* data,
+                                           const std::size_t size,
+                                           uint64_t* raw) const
+{
+    BIT_TIME(DecodeCycles);
+    BIT_COUNT(FramesDecoded, 1ULL);
+    BIT_COUNT(SignalReads, mCount);
+    BIT_RECORD_BEGIN();
+
+    for (std::size_t i = 0UL; i < mCount; i++)
+    {
+        raw[i] = extract(mEntries[i], data, size);
+    }
+
+    const Status result = (size < mSize) ? Overflow : Ok;
+
+    BIT_RECORD_END(FrameDecode, Recorder::frame(), mCount, result);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+DecodeTable::Status DecodeTable::decode(const uint8_t* data,
+                                        const std::size_t size,
+                                        double* values) const
+{
+    BIT_TIME(DecodeCycles);
+    BIT_COUNT(FramesDecoded, 1ULL);
+    BIT_COUNT(SignalReads, mCount);
+    BIT_RECORD_BEGIN();
+
+    for (std::size_t i = 0UL; i < mCount; i++)
+    {
+        values[i] = convert(mEntries[i], extract(mEntries[i], data, size));
+    }
+
+    const Status result = (size < mSize) ? Overflow : Ok;
+
+    BIT_RECORD_END(FrameDecode, Recorder::frame(), mCount, result);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+double DecodeTable::value(const std::size_t i,
+                          const uint8_t* data,
+                          const std::size_t size) const
+{
+    return convert(mEntries[i], extract(mEntries[i], data, size));
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+Schema::Status Schema::parse(const char* text, const std::size_t size)
+{
+    Status result = SyntaxError;
+
+    Token tokens[MAX_TOKENS];
+
+    std::size_t count = 0UL;
+
+    std::size_t i = 0UL;
+
+    bool isDone = false;
+
+    while ((i < size) && !isDone)
+    {
+        if (isSpace(text[i]))
+        {
+            i++;
+        }
+        else if ('#' == text[i])
+        {
+            isDone = true;
+        }
+        else
+        {
+            const std::size_t start = i;
+
+            while ((i < size) && !isSpace(text[i]) && (text[i] != '#'))
+            {
+                i++;
+            }
+
+            if (count < MAX_TOKENS)
+            {
+                tokens[count].text = &text[start];
+                tokens[count].size = i - start;
+            }
+
+            count++;
+        }
+    }
+
+    if (0UL == count)
+    {
+        result = Ok;
+    }
+    else if ((count >= 4UL) && (count <= 7UL) && (tokens[0].size < SCHEMA_NAME_SIZE))
+    {
+        SchemaSignal signal;
+
+        bool isValid = toUnsigned(tokens[1], signal.position) &&
+                       toUnsigned(tokens[2], signal.width);
+
+        (void) std::memcpy(signal.name, tokens[0].text, tokens[0].size);
+
+        signal.name[tokens[0].size] = '\0';
+
+        if (isToken(tokens[3], "bool"))
+        {
+            signal.type = Boolean;
+        }
+        else if (isToken(tokens[3], "unsigned"))
+        {
+            signal.type = Unsigned;
+        }
+        else if (isToken(tokens[3], "signed"))
+        {
+            signal.type = Signed;
+        }
+        else if (isToken(tokens[3], "float"))
+        {
+            signal.type = Float32;
+        }
+        else if (isToken(tokens[3], "double"))
+        {
+            signal.type = Float64;
+        }
+        else if (isToken(tokens[3], "half"))
+        {
+            signal.type = Float16;
+        }
+        else if (isToken(tokens[3], "bfloat16"))
+        {
+            signal.type = BFloat16;
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        signal.order = Motorola;
+        signal.scale = 1.0;
+        signal.offset = 0.0;
+
+        if ((count > 4UL) && isToken(tokens[4], "intel"))
+        {
+            signal.order = Intel;
+        }
+        else if ((count > 4UL) && !isToken(tokens[4], "motorola"))
+        {
+            isValid = false;
+        }
+        else
+        {
+        }
+
+        if (count > 5UL)
+        {
+            isValid = toDouble(tokens[5], signal.scale) && isValid;
+        }
+
+        if (count > 6UL)
+        {
+            isValid = toDouble(tokens[6], signal.offset) && isValid;
+        }
+
+        if (isValid)
+        {
+            result = add(signal);
+        }
+    }
+    else
+    {
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+uint64_t DecodeTable::extract(const Entry& entry,
+                              const uint8_t* data,
+                              const std::size_t size)
+{
+    uint64_t result;
+
+    if ((entry.flags & FLAG_INTEL) != 0U)
+    {
+        result = extractIntelField(data,
+                                   size,
+                                   (entry.byte * U08_BIT_COUNT) + entry.shift,
+                                   entry.width);
+    }
+    else
+    {
+        const std::size_t needed = ((entry.flags & FLAG_WIDE) != 0U) ?
+                                   (sizeof(uint64_t) + 1UL) : sizeof(uint64_t);
+
+        uint8_t window[2UL * sizeof(uint64_t)];
+
+        const uint8_t* source = &data[entry.byte];
+
+        // Near the end of the frame the window is zero padded
+        if ((entry.byte + needed) > size)
+        {
+            const std::size_t available = (entry.byte < size) ? (size - entry.byte) : 0UL;
+
+            (void) std::memset(window, 0, sizeof(window));
+            (void) std::memcpy(window, source, available);
+
+            source = window;
+        }
+
+        if ((entry.flags & FLAG_WIDE) != 0U)
+        {
+            result = (loadU64(source) << entry.shift) |
+                     (source[sizeof(uint64_t)] >> (U08_BIT_COUNT - entry.shift));
+
+            result >>= (U64_BIT_COUNT - entry.width);
+        }
+        else
+        {
+            result = loadU64(source) >> entry.shift;
+        }
+
+        result &= entry.mask;
+    }
+
+    if ((Signed == entry.type) && (entry.width < U64_BIT_COUNT) &&
+        (((result >> (entry.width - 1U)) & 1ULL) != 0ULL))
+    {
+        result |= ~entry.mask;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+double DecodeTable::convert(const Entry& entry, const uint64_t raw)
+{
+    return (fieldNumber(raw, entry.width, static_cast<ValueType>(entry.type)) *
+            entry.scale) + entry.offset;
+}
+}
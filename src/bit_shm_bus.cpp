@@ -0,0 +1,559 @@
+//!
+//! \file bit_shm_bus.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Cross-process shared memory frame bus
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_shm_bus.h"
+
+#include "bit_recorder.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Byte offset of the control cache line
+//!
+const std::size_t CONTROL_OFFSET = CACHE_LINE_SIZE;
+
+//!
+//! \brief Byte offset of the first slot
+//!
+const std::size_t SLOTS_OFFSET = 2UL * CACHE_LINE_SIZE;
+
+//!
+//! \brief Maximum sequence loads of version() waiting for a publication
+//!
+const uint32_t VERSION_SPIN_LIMIT = 1000000U;
+
+#if !defined(__linux__)
+
+//!
+//! \brief Polling period of wait() without futex (ns)
+//!
+const long POLL_PERIOD = 100000L;
+
+#endif
+
+//----------------------------- Private types ----------------------------------
+
+//!
+//! \brief Control cache line shared by every process
+//!
+struct Control
+{
+    //!
+    //! \brief Publication counter, the futex word
+    //!
+    std::atomic<uint32_t> notify;
+
+    //!
+    //! \brief Number of consumers blocked in wait()
+    //!
+    std::atomic<uint32_t> waiters;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "Lock-free 32-bit atomics required");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Lock-free 64-bit atomics required");
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+std::size_t slotSize(const std::size_t frameSize)
+{
+    const std::size_t words = (frameSize + sizeof(uint64_t) - 1UL) /
+                              sizeof(uint64_t);
+
+    const std::size_t bytes = sizeof(uint64_t) + (words * sizeof(uint64_t));
+
+    return ((bytes + CACHE_LINE_SIZE - 1UL) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+}
+
+//------------------------------------------------------------------------------
+Control* control(uint8_t* map)
+{
+    return reinterpret_cast<Control*>(&map[CONTROL_OFFSET]);
+}
+
+//------------------------------------------------------------------------------
+std::atomic<uint32_t>* slotSequence(uint8_t* slot)
+{
+    return reinterpret_cast<std::atomic<uint32_t>*>(slot);
+}
+
+//------------------------------------------------------------------------------
+std::atomic<uint64_t>* slotWords(uint8_t* slot)
+{
+    return reinterpret_cast<std::atomic<uint64_t>*>(&slot[sizeof(uint64_t)]);
+}
+
+#if !defined(__linux__)
+
+//------------------------------------------------------------------------------
+void sleepFor(const long nanoseconds)
+{
+    struct timespec period;
+
+    period.tv_sec = nanoseconds / 1000000000L;
+    period.tv_nsec = nanoseconds % 1000000000L;
+
+    (void) nanosleep(&period, 0);
+}
+
+#endif
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+const std::size_t ShmBus::SEQUENCE_SIZE;
+
+//------------------------------------------------------------------------------
+ShmBus::ShmBus()
+    : mFile(-1)
+    , mMap(0)
+    , mLength(0UL)
+    , mSlots(0)
+    , mSlotCount(0UL)
+    , mFrameSize(0UL)
+    , mSlotSize(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+ShmBus::~ShmBus()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::create(const char* name,
+                              const std::size_t frameSize,
+                              const std::size_t slotCount)
+{
+    Status result = OpenError;
+
+    close();
+
+    int file = -1;
+
+    if (name != 0)
+    {
+        file = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+        // An existing segment may be mapped by other processes, it is never
+        // re-initialized but attached if its layout is the requested one
+        if ((file < 0) && (EEXIST == errno))
+        {
+            result = open(name);
+
+            if ((Ok == result) &&
+                ((mFrameSize != frameSize) || (mSlotCount != slotCount)))
+            {
+                close();
+
+                result = FormatError;
+            }
+        }
+    }
+    else
+    {
+#if defined(__linux__)
+
+        file = static_cast<int>(syscall(SYS_memfd_create, "bits", 0U));
+
+#endif
+    }
+
+    if (file >= 0)
+    {
+        const std::size_t size = slotSize(frameSize);
+
+        const std::size_t length = SLOTS_OFFSET + (slotCount * size);
+
+        // The segment is new (empty), extending it zeroes every slot
+        if (ftruncate(file, static_cast<off_t>(length)) == 0)
+        {
+            void* map = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+            result = MapError;
+
+            if (map != MAP_FAILED)
+            {
+                ShmBusHeader header;
+
+                header.magic = SHM_BUS_MAGIC;
+                header.version = SHM_BUS_VERSION;
+                header.reserved = 0U;
+                header.frameSize = static_cast<uint32_t>(frameSize);
+                header.slotSize = static_cast<uint32_t>(size);
+                header.slotCount = slotCount;
+
+                (void) std::memcpy(map, &header, sizeof(header));
+
+                (void) munmap(map, length);
+
+                result = attach(file);
+            }
+        }
+
+        if (result != Ok)
+        {
+            (void) ::close(file);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::open(const char* name)
+{
+    Status result = OpenError;
+
+    close();
+
+    const int file = shm_open(name, O_RDWR, 0);
+
+    if (file >= 0)
+    {
+        result = attach(file);
+
+        if (result != Ok)
+        {
+            (void) ::close(file);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::open(const int file)
+{
+    Status result = OpenError;
+
+    close();
+
+    const int copy = dup(file);
+
+    if (copy >= 0)
+    {
+        result = attach(copy);
+
+        if (result != Ok)
+        {
+            (void) ::close(copy);
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void ShmBus::close()
+{
+    if (mMap != 0)
+    {
+        (void) munmap(mMap, mLength);
+    }
+
+    if (mFile >= 0)
+    {
+        (void) ::close(mFile);
+    }
+
+    mFile = -1;
+    mMap = 0;
+    mLength = 0UL;
+    mSlots = 0;
+    mSlotCount = 0UL;
+    mFrameSize = 0UL;
+    mSlotSize = 0UL;
+}
+
+//------------------------------------------------------------------------------
+void ShmBus::unlink(const char* name)
+{
+    (void) shm_unlink(name);
+}
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::publish(const std::size_t slot, const uint8_t* data)
+{
+    BIT_RECORD_BEGIN();
+
+    Status result = InvalidSlot;
+
+    if (slot < mSlotCount)
+    {
+        uint8_t* base = &mSlots[slot * mSlotSize];
+
+        std::atomic<uint32_t>* counter = slotSequence(base);
+        std::atomic<uint64_t>* frame = slotWords(base);
+
+        // An odd sequence was left by a publisher that died mid-write, the
+        // publication takes it over and completes it
+        const uint32_t current = counter->load(std::memory_order_relaxed) | 1U;
+
+        counter->store(current, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0UL; i < mFrameSize; i += sizeof(uint64_t))
+        {
+            const std::size_t count = ((mFrameSize - i) < sizeof(uint64_t)) ?
+                                      (mFrameSize - i) : sizeof(uint64_t);
+
+            uint64_t word = 0ULL;
+
+            (void) std::memcpy(&word, &data[i], count);
+
+            frame[i / sizeof(uint64_t)].store(word, std::memory_order_relaxed);
+        }
+
+        counter->store(current + 1U, std::memory_order_release);
+
+        Control* shared = control(mMap);
+
+        (void) shared->notify.fetch_add(1U);
+
+#if defined(__linux__)
+
+        if (shared->waiters.load() != 0U)
+        {
+            (void) syscall(SYS_futex, &shared->notify, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+        }
+
+#endif
+
+        BIT_COUNT(FramesEncoded, 1ULL);
+        BIT_RECORD_END(FramePublish, (current + 1U) / 2U, slot, Ok);
+
+        result = Ok;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::snapshot(const std::size_t slot, uint8_t* data) const
+{
+    Status result = InvalidSlot;
+
+    if (slot < mSlotCount)
+    {
+        const std::size_t count = (mFrameSize + sizeof(uint64_t) - 1UL) /
+                                  sizeof(uint64_t);
+
+        load(slot, 0UL, count, data, mFrameSize);
+
+        result = Ok;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+uint32_t ShmBus::version(const std::size_t slot) const
+{
+    const std::atomic<uint32_t>* counter = slotSequence(&mSlots[slot * mSlotSize]);
+
+    uint32_t result = counter->load(std::memory_order_acquire);
+
+    for (uint32_t i = 0U; ((result & 1U) != 0U) && (i < VERSION_SPIN_LIMIT); i++)
+    {
+        result = counter->load(std::memory_order_acquire);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+bool ShmBus::isCurrent(const std::size_t slot, const uint32_t version) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return ((version & 1U) == 0U) &&
+           (slotSequence(&mSlots[slot * mSlotSize])->load(std::memory_order_relaxed) ==
+            version);
+}
+
+//------------------------------------------------------------------------------
+uint32_t ShmBus::notifications() const
+{
+    return control(mMap)->notify.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+bool ShmBus::wait(const uint32_t seen, const uint32_t timeout) const
+{
+    Control* shared = control(mMap);
+
+    (void) shared->waiters.fetch_add(1U);
+
+#if defined(__linux__)
+
+    if (shared->notify.load() == seen)
+    {
+        struct timespec period;
+
+        period.tv_sec = static_cast<time_t>(timeout / 1000U);
+        period.tv_nsec = static_cast<long>(timeout % 1000U) * 1000000L;
+
+        // Spurious wake ups and EINTR are reported as a timeout
+        (void) syscall(SYS_futex, &shared->notify, FUTEX_WAIT, seen, &period, 0, 0);
+    }
+
+#else
+
+    for (long elapsed = 0L;
+         (shared->notify.load() == seen) &&
+         (elapsed < (static_cast<long>(timeout) * 1000000L));
+         elapsed += POLL_PERIOD)
+    {
+        sleepFor(POLL_PERIOD);
+    }
+
+#endif
+
+    (void) shared->waiters.fetch_sub(1U);
+
+    return shared->notify.load(std::memory_order_acquire) != seen;
+}
+
+//------------------------ Private member methods ------------------------------
+
+//------------------------------------------------------------------------------
+ShmBus::Status ShmBus::attach(const int file)
+{
+    Status result = FormatError;
+
+    struct stat info;
+
+    if ((fstat(file, &info) == 0) &&
+        (static_cast<std::size_t>(info.st_size) >= SLOTS_OFFSET))
+    {
+        const std::size_t length = static_cast<std::size_t>(info.st_size);
+
+        void* map = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+        result = MapError;
+
+        if (map != MAP_FAILED)
+        {
+            ShmBusHeader header;
+
+            (void) std::memcpy(&header, map, sizeof(header));
+
+            const std::size_t available =
+                    (length - SLOTS_OFFSET) /
+                    ((header.slotSize != 0U) ? header.slotSize : 1U);
+
+            if ((header.magic == SHM_BUS_MAGIC) &&
+                (header.version == SHM_BUS_VERSION) &&
+                (header.slotSize == slotSize(header.frameSize)) &&
+                (header.slotCount <= available))
+            {
+                mFile = file;
+                mMap = static_cast<uint8_t*>(map);
+                mLength = length;
+                mSlots = &mMap[SLOTS_OFFSET];
+                mSlotCount = static_cast<std::size_t>(header.slotCount);
+                mFrameSize = header.frameSize;
+                mSlotSize = header.slotSize;
+
+                result = Ok;
+            }
+            else
+            {
+                result = FormatError;
+
+                (void) munmap(map, length);
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void ShmBus::load(const std::size_t slot,
+                  const std::size_t first,
+                  const std::size_t count,
+                  uint8_t* data,
+                  const std::size_t size) const
+{
+    uint8_t* base = &mSlots[slot * mSlotSize];
+
+    const std::atomic<uint32_t>* counter = slotSequence(base);
+    const std::atomic<uint64_t>* frame = slotWords(base);
+
+    const std::size_t available = (mFrameSize + sizeof(uint64_t) - 1UL) /
+                                  sizeof(uint64_t);
+
+    bool isConsistent = false;
+
+    while (!isConsistent)
+    {
+        const uint32_t begin = counter->load(std::memory_order_acquire);
+
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            const std::size_t offset = i * sizeof(uint64_t);
+
+            const uint64_t word = ((first + i) < available) ?
+                                  frame[first + i].load(std::memory_order_relaxed) :
+                                  0ULL;
+
+            (void) std::memcpy(&data[offset],
+                               &word,
+                               ((size - offset) < sizeof(uint64_t)) ?
+                               (size - offset) : sizeof(uint64_t));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        const uint32_t end = counter->load(std::memory_order_relaxed);
+
+        isConsistent = ((begin & 1U) == 0U) && (begin == end);
+    }
+}
+}
@@ -0,0 +1,421 @@
+//!
+//! \file bit_stuffer.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Bit stuffing and destuffing of serial link bit streams
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_stuffer.h"
+
+#include "bit_field.h"
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Number of equal bits followed by a stuff bit
+//!
+const std::size_t RUN_LENGTH = 5UL;
+
+//!
+//! \brief Mask of the bits preceding a run end (RUN_LENGTH - 1)
+//!
+const uint64_t HISTORY_MASK = 0x0FULL;
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Appends bits to a byte array, 64 bits at a time
+//!
+struct BitWriter
+{
+    //!
+    //! \brief The output bytes
+    //!
+    uint8_t* data;
+
+    //!
+    //! \brief The bit capacity of the output
+    //!
+    std::size_t capacity;
+
+    //!
+    //! \brief Bits appended (stored and pending)
+    //!
+    std::size_t bits;
+
+    //!
+    //! \brief Bytes stored
+    //!
+    std::size_t bytes;
+
+    //!
+    //! \brief Pending bits, most significant first
+    //!
+    uint64_t pending;
+
+    //!
+    //! \brief Number of pending bits
+    //!
+    std::size_t count;
+
+    //!
+    //! \brief Set if an append did not fit the capacity, later appends are
+    //!        ignored
+    //!
+    bool isOverflow;
+};
+
+//!
+//! \brief Bits preceding the scanned word
+//!
+struct History
+{
+    //!
+    //! \brief The last RUN_LENGTH - 1 bits, bit 0 the most recent
+    //!
+    uint64_t bits;
+
+    //!
+    //! \brief Number of valid bits (0 - RUN_LENGTH - 1)
+    //!
+    std::size_t count;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+inline uint64_t topBits(const std::size_t count)
+{
+    return (count < U64_BIT_COUNT) ? ~(~0ULL >> count) : ~0ULL;
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t dropBits(const uint64_t word, const std::size_t count)
+{
+    return (count < U64_BIT_COUNT) ? (word << count) : 0ULL;
+}
+
+//------------------------------------------------------------------------------
+void append(BitWriter& writer, const uint64_t word, const std::size_t size)
+{
+    std::size_t count = size;
+
+    if (writer.isOverflow)
+    {
+        count = 0UL;
+    }
+    else if ((writer.bits + size) > writer.capacity)
+    {
+        // The bits that fit are kept, the output is a prefix of the stream
+        count = writer.capacity - writer.bits;
+
+        writer.isOverflow = true;
+    }
+    else
+    {
+        // Fits
+    }
+
+    if (count != 0UL)
+    {
+        const uint64_t bits = word & topBits(count);
+
+        const std::size_t free = U64_BIT_COUNT - writer.count;
+
+        writer.pending |= bits >> writer.count;
+
+        if (count < free)
+        {
+            writer.count += count;
+        }
+        else
+        {
+            storeU64(&writer.data[writer.bytes], writer.pending);
+
+            writer.bytes += sizeof(uint64_t);
+            writer.count = count - free;
+            writer.pending = (free < U64_BIT_COUNT) ? (bits << free) : 0ULL;
+        }
+
+        writer.bits += count;
+    }
+}
+
+//------------------------------------------------------------------------------
+void flush(BitWriter& writer)
+{
+    for (std::size_t i = 0UL; (i * U08_BIT_COUNT) < writer.count; i++)
+    {
+        writer.data[writer.bytes + i] = static_cast<uint8_t>(
+                writer.pending >> (U64_BIT_COUNT - U08_BIT_COUNT - (i * U08_BIT_COUNT)));
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t readWord(const uint8_t* data,
+                  const std::size_t bits,
+                  const std::size_t position,
+                  const std::size_t count)
+{
+    const std::size_t bytes = (bits + U08_BIT_COUNT - 1UL) / U08_BIT_COUNT;
+
+    // Most significant aligned, the bits past the stream are zero
+    return extractField(data, bytes, position, count) << (U64_BIT_COUNT - count);
+}
+
+//------------------------------------------------------------------------------
+void remember(History& history, const uint64_t word, const std::size_t count)
+{
+    // The last bits of the count most significant bits of word
+    const uint64_t last = word >> (U64_BIT_COUNT - count);
+
+    history.bits = (count < U64_BIT_COUNT) ?
+                   (((history.bits << count) | last) & HISTORY_MASK) :
+                   (last & HISTORY_MASK);
+
+    history.count = ((history.count + count) < (RUN_LENGTH - 1UL)) ?
+                    (history.count + count) : (RUN_LENGTH - 1UL);
+}
+
+//------------------------------------------------------------------------------
+uint64_t runEnds(const uint64_t word,
+                 const std::size_t count,
+                 const History& history,
+                 const BitStuffer::Rule rule)
+{
+    uint64_t ones = word;
+    uint64_t zeros = ~word;
+
+    for (std::size_t i = 1UL; i < RUN_LENGTH; i++)
+    {
+        // Bit k of the stream aligned with bit k - i
+        const uint64_t shifted = (word >> i) | (history.bits << (U64_BIT_COUNT - i));
+
+        ones &= shifted;
+        zeros &= ~shifted;
+    }
+
+    uint64_t result = (BitStuffer::Can == rule) ? (ones | zeros) : ones;
+
+    // Runs starting before the first known bit, bits past the word
+    result &= ~0ULL >> ((RUN_LENGTH - 1UL) - history.count);
+    result &= topBits(count);
+
+    return result;
+}
+}
+
+//------------------------ Public member methods -------------------------------
+
+//------------------------------------------------------------------------------
+BitStuffer::BitStuffer(const Rule rule)
+    : mRule(rule)
+    , mBits(0UL)
+    , mErrors(0UL)
+{
+}
+
+//------------------------------------------------------------------------------
+BitStuffer::~BitStuffer()
+{
+}
+
+//------------------------------------------------------------------------------
+BitStuffer::Status BitStuffer::stuff(const uint8_t* input,
+                                     const std::size_t bits,
+                                     uint8_t* output,
+                                     const std::size_t capacity)
+{
+    BitWriter writer = { output, capacity, 0UL, 0UL, 0ULL, 0UL, false };
+
+    History history = { 0ULL, 0UL };
+
+    std::size_t position = 0UL;
+
+    while ((position < bits) && !writer.isOverflow)
+    {
+        std::size_t count = ((bits - position) < U64_BIT_COUNT) ?
+                            (bits - position) : U64_BIT_COUNT;
+
+        uint64_t word = readWord(input, bits, position, count);
+
+        position += count;
+
+        while ((count != 0UL) && !writer.isOverflow)
+        {
+            const uint64_t ends = runEnds(word, count, history, mRule);
+
+            if (0ULL == ends)
+            {
+                append(writer, word, count);
+                remember(history, word, count);
+
+                count = 0UL;
+            }
+            else
+            {
+                // Copy up to the first run end, then the stuff bit. The stuff
+                // bit joins the history of the rest of the word
+                const std::size_t end = leadingZeros(ends) + 1UL;
+
+                const uint64_t last = (word >> (U64_BIT_COUNT - end)) & 1ULL;
+
+                const uint64_t stuffBit = ((Can == mRule) ? (last ^ 1ULL) : 0ULL) <<
+                                          (U64_BIT_COUNT - 1UL);
+
+                if (end < U64_BIT_COUNT)
+                {
+                    const uint64_t stuffed = (word & topBits(end)) | (stuffBit >> end);
+
+                    append(writer, stuffed, end + 1UL);
+                    remember(history, stuffed, end + 1UL);
+                }
+                else
+                {
+                    append(writer, word, end);
+                    append(writer, stuffBit, 1UL);
+                    remember(history, word, end);
+                    remember(history, stuffBit, 1UL);
+                }
+
+                word = dropBits(word, end);
+                count -= end;
+            }
+        }
+    }
+
+    flush(writer);
+
+    mBits = writer.bits;
+    mErrors = 0UL;
+
+    return writer.isOverflow ? Overflow : Ok;
+}
+
+//------------------------------------------------------------------------------
+BitStuffer::Status BitStuffer::destuff(const uint8_t* input,
+                                       const std::size_t bits,
+                                       uint8_t* output,
+                                       const std::size_t capacity,
+                                       std::size_t* positions,
+                                       const std::size_t maxPositions)
+{
+    BitWriter writer = { output, capacity, 0UL, 0UL, 0ULL, 0UL, false };
+
+    History history = { 0ULL, 0UL };
+
+    std::size_t position = 0UL;
+
+    // Set if the next bit is a stuff bit, last holds the value of its run
+    bool isStuffNext = false;
+
+    uint64_t last = 0ULL;
+
+    mErrors = 0UL;
+
+    while ((position < bits) && !writer.isOverflow)
+    {
+        std::size_t count = ((bits - position) < U64_BIT_COUNT) ?
+                            (bits - position) : U64_BIT_COUNT;
+
+        uint64_t word = readWord(input, bits, position, count);
+
+        position += count;
+
+        while ((count != 0UL) && !writer.isOverflow)
+        {
+            if (isStuffNext)
+            {
+                // A bit repeating the run is an error kept as data, it extends
+                // the run so the next bit is a stuff bit again
+                if ((word >> (U64_BIT_COUNT - 1UL)) == last)
+                {
+                    if (mErrors < maxPositions)
+                    {
+                        positions[mErrors] = position - count;
+                    }
+
+                    mErrors++;
+
+                    append(writer, word, 1UL);
+                }
+                else
+                {
+                    isStuffNext = false;
+                }
+
+                remember(history, word, 1UL);
+
+                word = dropBits(word, 1UL);
+                count--;
+            }
+            else
+            {
+                const uint64_t ends = runEnds(word, count, history, mRule);
+
+                if (0ULL == ends)
+                {
+                    append(writer, word, count);
+                    remember(history, word, count);
+
+                    count = 0UL;
+                }
+                else
+                {
+                    const std::size_t end = leadingZeros(ends) + 1UL;
+
+                    last = (word >> (U64_BIT_COUNT - end)) & 1ULL;
+
+                    append(writer, word, end);
+                    remember(history, word, end);
+
+                    word = dropBits(word, end);
+                    count -= end;
+
+                    isStuffNext = true;
+                }
+            }
+        }
+    }
+
+    flush(writer);
+
+    mBits = writer.bits;
+
+    Status result = Ok;
+
+    if (writer.isOverflow)
+    {
+        result = Overflow;
+    }
+    else if (mErrors != 0UL)
+    {
+        result = StuffError;
+    }
+    else
+    {
+        // No error
+    }
+
+    return result;
+}
+}
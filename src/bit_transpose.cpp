@@ -0,0 +1,330 @@
+//!
+//! \file bit_transpose.cpp
+//!
+//! \brief Bit manipulation library
+//!
+//! \details    Bit matrix transposes and per-flag bitmaps of frame blocks
+//!
+//! \author Carlos Garcia
+//!
+//! \copyright Phoenix Software Labs 2019
+//!
+//! The copyright of the computer program(s) herein is the property of
+//! Phoenix Software Labs. The program(s) may be copied and used only with the
+//! written consent of Phoenix Software Labs
+//!
+//!                       REUSE CODE, DO NOT MODIFY!
+//!
+//! \version 1.0.0a
+//!
+
+//---------------------------- Include files -----------------------------------
+
+#include "bit_transpose.h"
+
+#include "bit_field.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIT_TRANSPOSE_X86
+#include <immintrin.h>
+#endif
+
+namespace bit
+{
+namespace
+{
+//--------------------------- Private constants --------------------------------
+
+//!
+//! \brief Marks a column not loaded yet
+//!
+const std::size_t NOT_LOADED = ~0UL;
+
+//!
+//! \brief Flags of a column worth a whole 64x64 transpose
+//!
+const std::size_t TRANSPOSE_FLAGS = 16UL;
+
+//---------------------------- Private types -----------------------------------
+
+//!
+//! \brief Transposes a 64x64 bit matrix in place
+//!
+typedef void (*Transpose64)(uint64_t* rows);
+
+//!
+//! \brief Returns the bitmap of one bit of 64 rows
+//!
+typedef uint64_t (*Spread)(const uint64_t (&rows)[TRANSPOSE_FRAMES], const std::size_t bit);
+
+//!
+//! \brief Kernels of the running CPU
+//!
+struct Kernels
+{
+    //!
+    //! \brief 64x64 transpose kernel
+    //!
+    Transpose64 transpose64;
+
+    //!
+    //! \brief Single bit kernel
+    //!
+    Spread spread;
+};
+
+//--------------------------- Private methods ----------------------------------
+
+//------------------------------------------------------------------------------
+void loadColumn(const uint8_t* frames,
+                const std::size_t size,
+                const std::size_t stride,
+                const std::size_t count,
+                const std::size_t column,
+                uint64_t (&rows)[TRANSPOSE_FRAMES])
+{
+    const std::size_t byte = column * sizeof(uint64_t);
+
+    for (std::size_t i = 0UL; i < TRANSPOSE_FRAMES; i++)
+    {
+        if (i >= count)
+        {
+            rows[i] = 0ULL;
+        }
+        else if ((byte + sizeof(uint64_t)) <= size)
+        {
+            rows[i] = loadU64(&frames[(i * stride) + byte]);
+        }
+        else
+        {
+            rows[i] = extractField(&frames[i * stride], size, byte * U08_BIT_COUNT, U64_BIT_COUNT);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void transpose64x64Scalar(uint64_t* rows)
+{
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+
+    for (std::size_t j = U64_BIT_COUNT / 2UL; j != 0UL; j >>= 1, mask ^= mask << j)
+    {
+        // Swap the right block of row k with the left block of row k + j
+        for (std::size_t k = 0UL; k < U64_BIT_COUNT; k = ((k | j) + 1UL) & ~j)
+        {
+            const uint64_t swap = (rows[k] ^ (rows[k + j] >> j)) & mask;
+
+            rows[k] ^= swap;
+            rows[k + j] ^= swap << j;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t spreadScalar(const uint64_t (&rows)[TRANSPOSE_FRAMES], const std::size_t bit)
+{
+    uint64_t result = 0ULL;
+
+    for (std::size_t i = 0UL; i < TRANSPOSE_FRAMES; i++)
+    {
+        result |= ((rows[i] << bit) >> (U64_BIT_COUNT - 1UL)) << (U64_BIT_COUNT - 1UL - i);
+    }
+
+    return result;
+}
+
+#ifdef BIT_TRANSPOSE_X86
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline void swapAvx2(__m256i& upper, __m256i& lower, const std::size_t j, const __m256i mask)
+{
+    const int count = static_cast<int>(j);
+
+    const __m256i swap = _mm256_and_si256(
+            _mm256_xor_si256(upper, _mm256_srli_epi64(lower, count)), mask);
+
+    upper = _mm256_xor_si256(upper, swap);
+    lower = _mm256_xor_si256(lower, _mm256_slli_epi64(swap, count));
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void transpose64x64Avx2(uint64_t* rows)
+{
+    // Four rows per vector: the 32 to 4 row swaps pair whole vectors
+    __m256i v[16];
+
+    for (std::size_t q = 0UL; q < 16UL; q++)
+    {
+        v[q] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&rows[q * 4UL]));
+    }
+
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+
+    for (std::size_t j = U64_BIT_COUNT / 2UL; j >= 4UL; j >>= 1, mask ^= mask << j)
+    {
+        const __m256i masks = _mm256_set1_epi64x(static_cast<long long>(mask));
+
+        const std::size_t step = j / 4UL;
+
+        for (std::size_t q = 0UL; q < 16UL; q = ((q | step) + 1UL) & ~step)
+        {
+            swapAvx2(v[q], v[q + step], j, masks);
+        }
+    }
+
+    // The 2 and 1 row swaps pair the rows of a vector
+    const __m256i masks2 = _mm256_set_epi64x(0LL, 0LL,
+                                             0x3333333333333333LL, 0x3333333333333333LL);
+    const __m256i masks1 = _mm256_set_epi64x(0LL, 0x5555555555555555LL,
+                                             0LL, 0x5555555555555555LL);
+
+    for (std::size_t q = 0UL; q < 16UL; q++)
+    {
+        __m256i swap = _mm256_and_si256(
+                _mm256_xor_si256(v[q], _mm256_srli_epi64(_mm256_permute4x64_epi64(v[q], 0x4E), 2)),
+                masks2);
+
+        v[q] = _mm256_xor_si256(v[q], _mm256_xor_si256(
+                swap, _mm256_permute4x64_epi64(_mm256_slli_epi64(swap, 2), 0x4E)));
+
+        swap = _mm256_and_si256(
+                _mm256_xor_si256(v[q], _mm256_srli_epi64(_mm256_permute4x64_epi64(v[q], 0xB1), 1)),
+                masks1);
+
+        v[q] = _mm256_xor_si256(v[q], _mm256_xor_si256(
+                swap, _mm256_permute4x64_epi64(_mm256_slli_epi64(swap, 1), 0xB1)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&rows[q * 4UL]), v[q]);
+    }
+}
+
+//------------------------------------------------------------------------------
+__attribute__((target("avx2")))
+uint64_t spreadAvx2(const uint64_t (&rows)[TRANSPOSE_FRAMES], const std::size_t bit)
+{
+    // The flag bit moves to the sign of its row, one movemask takes four
+    // rows. Reversing the rows of a vector puts frame 4q at mask bit 3
+    const __m128i count = _mm_cvtsi32_si128(static_cast<int>(bit));
+
+    uint64_t result = 0ULL;
+
+    for (std::size_t q = 0UL; q < (TRANSPOSE_FRAMES / 4UL); q++)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&rows[q * 4UL]));
+
+        const __m256i reversed = _mm256_permute4x64_epi64(_mm256_sll_epi64(v, count), 0x1B);
+
+        const uint64_t mask = static_cast<uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(reversed)));
+
+        result |= mask << (U64_BIT_COUNT - 4UL - (q * 4UL));
+    }
+
+    return result;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+Kernels selectKernels()
+{
+    Kernels result = { &transpose64x64Scalar, &spreadScalar };
+
+#ifdef BIT_TRANSPOSE_X86
+
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        result.transpose64 = &transpose64x64Avx2;
+        result.spread = &spreadAvx2;
+    }
+
+#endif
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+const Kernels& kernels()
+{
+    static const Kernels result = selectKernels();
+
+    return result;
+}
+}
+
+//--------------------------- Public methods -----------------------------------
+
+//------------------------------------------------------------------------------
+void transpose64x64(uint64_t* rows)
+{
+    kernels().transpose64(rows);
+}
+
+//------------------------------------------------------------------------------
+void transposeFlags(const uint8_t* frames,
+                    const std::size_t size,
+                    const std::size_t stride,
+                    const std::size_t count,
+                    const std::size_t* offsets,
+                    const std::size_t flags,
+                    uint64_t* bitmaps)
+{
+    const Kernels& kernel = kernels();
+
+    const std::size_t words = (count + TRANSPOSE_FRAMES - 1UL) / TRANSPOSE_FRAMES;
+
+    uint64_t rows[TRANSPOSE_FRAMES];
+
+    for (std::size_t w = 0UL; w < words; w++)
+    {
+        const uint8_t* block = &frames[w * TRANSPOSE_FRAMES * stride];
+
+        std::size_t loaded = NOT_LOADED;
+
+        bool isTransposed = false;
+
+        for (std::size_t f = 0UL; f < flags; f++)
+        {
+            const std::size_t column = offsets[f] / U64_BIT_COUNT;
+
+            if ((offsets[f] / U08_BIT_COUNT) >= size)
+            {
+                bitmaps[(f * words) + w] = 0ULL;
+            }
+            else
+            {
+                if (column != loaded)
+                {
+                    loadColumn(block, size, stride, count - (w * TRANSPOSE_FRAMES), column, rows);
+
+                    // A whole transpose pays off for the dense columns only
+                    std::size_t shared = 1UL;
+
+                    while (((f + shared) < flags) &&
+                           ((offsets[f + shared] / U64_BIT_COUNT) == column))
+                    {
+                        shared++;
+                    }
+
+                    isTransposed = (shared >= TRANSPOSE_FLAGS);
+
+                    if (isTransposed)
+                    {
+                        kernel.transpose64(rows);
+                    }
+
+                    loaded = column;
+                }
+
+                bitmaps[(f * words) + w] = isTransposed ?
+                                           rows[offsets[f] % U64_BIT_COUNT] :
+                                           kernel.spread(rows, offsets[f] % U64_BIT_COUNT);
+            }
+        }
+    }
+}
+}
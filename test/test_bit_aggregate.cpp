@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 11, 12> Speed;
+typedef bit::Signal<int8_t, 31, 8> Temperature;
+
+const std::size_t FRAME_COUNT = 500UL;
+
+//------------------------------------------------------------------------------
+template <typename SignalType, std::size_t Size>
+void encode(bit::Buffer<Size>& frame, const typename SignalType::Type& value)
+{
+    SignalType signal;
+
+    signal.write(value);
+
+    frame << signal;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitAggregate : public Test
+{
+public:
+
+    BitAggregate();
+
+    virtual void SetUp();
+
+    std::vector<bit::Buffer<8> > frames;
+};
+
+//------------------------------------------------------------------------------
+BitAggregate::BitAggregate()
+    : frames(FRAME_COUNT)
+{
+}
+
+//------------------------------------------------------------------------------
+void BitAggregate::SetUp()
+{
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        frames[i].clear();
+
+        encode<Speed>(frames[i], static_cast<uint16_t>((i * 37UL) % 4000UL));
+        encode<Temperature>(frames[i], static_cast<int8_t>(static_cast<int>(i % 100UL) - 40));
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitAggregate, statistics)
+{
+    bit::Statistics<Speed> speed;
+    bit::Statistics<Temperature> temperature;
+
+    speed.accumulate(frames.data(), FRAME_COUNT);
+    temperature.accumulate(frames.data(), FRAME_COUNT);
+
+    uint64_t sum = 0ULL;
+    uint16_t max = 0U;
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        const uint16_t value = static_cast<uint16_t>((i * 37UL) % 4000UL);
+
+        sum += value;
+        max = (value > max) ? value : max;
+    }
+
+    ASSERT_EQ(speed.count(), FRAME_COUNT);
+    ASSERT_EQ(speed.min(), 0U);
+    ASSERT_EQ(speed.max(), max);
+    ASSERT_EQ(speed.sum(), sum);
+
+    ASSERT_EQ(temperature.min(), -40);
+    ASSERT_EQ(temperature.max(), 59);
+    ASSERT_DOUBLE_EQ(temperature.mean(), 9.5);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitAggregate, merge)
+{
+    const std::size_t half = FRAME_COUNT / 2UL;
+
+    bit::Histogram<Temperature, 10> whole(-50.0, 50.0);
+    bit::Histogram<Temperature, 10> first(-50.0, 50.0);
+    bit::Histogram<Temperature, 10> second(-50.0, 50.0);
+
+    whole.accumulate(frames.data(), FRAME_COUNT);
+    first.accumulate(frames.data(), half);
+    second.accumulate(&frames[half], FRAME_COUNT - half);
+
+    first.merge(second);
+
+    std::size_t total = first.underflow() + first.overflow();
+
+    for (std::size_t i = 0UL; i < 10UL; i++)
+    {
+        ASSERT_EQ(first.bin(i), whole.bin(i));
+
+        total += first.bin(i);
+    }
+
+    ASSERT_EQ(total, FRAME_COUNT);
+    ASSERT_EQ(first.overflow(), 50UL);
+    ASSERT_EQ(first.bin(0), 0UL);
+    ASSERT_EQ(first.bin(1), 50UL);
+    ASSERT_EQ(first.statistics().sum(), whole.statistics().sum());
+    ASSERT_EQ(first.statistics().min(), whole.statistics().min());
+}
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<int8_t, 21, 6> Trim;
+typedef bit::Signal<uint32_t, 59, 24> Straddle;
+typedef bit::Signal<float, 119> Wide;
+
+const std::size_t ITERATION_COUNT = 20000UL;
+
+//------------------------------------------------------------------------------
+template <std::size_t Index>
+struct Flag
+{
+    // Flags 0-31 take the bits of bytes 3-6, all within the first word
+    typedef bit::Signal<bool, (((Index / 8UL) + 3UL) * 8UL) + (Index % 8UL)> Type;
+};
+
+//------------------------------------------------------------------------------
+template <std::size_t Index>
+void toggle(bit::AtomicBuffer<24>& buffer)
+{
+    typedef typename Flag<Index>::Type Signal;
+
+    for (std::size_t i = 0UL; i < ITERATION_COUNT; i++)
+    {
+        buffer.write<Signal>(true);
+        EXPECT_TRUE(buffer.read<Signal>());
+        buffer.write<Signal>(false);
+        EXPECT_FALSE(buffer.read<Signal>());
+    }
+
+    buffer.write<Signal>((Index % 2UL) == 0UL);
+}
+}
+
+//------------------------------------------------------------------------------
+class BitAtomic : public Test
+{
+public:
+
+    BitAtomic();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitAtomic::BitAtomic()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitAtomic::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitAtomic, layout)
+{
+    static bit::AtomicBuffer<24> buffer;
+
+    Speed speed;
+    Trim trim;
+    Straddle straddle;
+    Wide wide;
+
+    speed.write(0xBEEFU);
+    trim.write(-7);
+    straddle.write(0xABCDEFUL);
+    wide.write(-1234.5625F);
+
+    buffer << speed << trim << straddle << wide;
+
+    ASSERT_EQ(buffer.read<Speed>(), 0xBEEFU);
+    ASSERT_EQ(buffer.read<Trim>(), -7);
+    ASSERT_EQ(buffer.read<Straddle>(), 0xABCDEFUL);
+    ASSERT_EQ(buffer.read<Wide>(), -1234.5625F);
+
+    // Same bytes as the plain buffer operators
+    bit::Buffer<24> frame;
+    bit::Buffer<24> expected;
+
+    expected << speed << trim << straddle << wide;
+
+    buffer.snapshot(frame);
+
+    for (std::size_t i = 0UL; i < 24UL; i++)
+    {
+        ASSERT_EQ(frame[i], expected[i]);
+    }
+
+    // Replacing a signal keeps its neighbours
+    buffer.write<Trim>(31);
+    buffer.write<Straddle>(0UL);
+
+    ASSERT_EQ(buffer.read<Trim>(), 31);
+    ASSERT_EQ(buffer.read<Straddle>(), 0UL);
+    ASSERT_EQ(buffer.read<Speed>(), 0xBEEFU);
+    ASSERT_EQ(buffer.read<Wide>(), -1234.5625F);
+
+    buffer.clear();
+
+    ASSERT_EQ(buffer.read<Wide>(), 0.0F);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitAtomic, concurrentFlags)
+{
+    static bit::AtomicBuffer<24> buffer;
+
+    Speed speed;
+
+    speed.write(0x1234U);
+
+    buffer << speed;
+
+    std::vector<std::thread> writers;
+
+    writers.push_back(std::thread(toggle<0>, std::ref(buffer)));
+    writers.push_back(std::thread(toggle<1>, std::ref(buffer)));
+    writers.push_back(std::thread(toggle<6>, std::ref(buffer)));
+    writers.push_back(std::thread(toggle<9>, std::ref(buffer)));
+    writers.push_back(std::thread(toggle<16>, std::ref(buffer)));
+    writers.push_back(std::thread(toggle<31>, std::ref(buffer)));
+
+    for (std::size_t i = 0UL; i < writers.size(); i++)
+    {
+        writers[i].join();
+    }
+
+    ASSERT_TRUE(buffer.read<Flag<0>::Type>());
+    ASSERT_FALSE(buffer.read<Flag<1>::Type>());
+    ASSERT_TRUE(buffer.read<Flag<6>::Type>());
+    ASSERT_FALSE(buffer.read<Flag<9>::Type>());
+    ASSERT_TRUE(buffer.read<Flag<16>::Type>());
+    ASSERT_FALSE(buffer.read<Flag<31>::Type>());
+    ASSERT_EQ(buffer.read<Speed>(), 0x1234U);
+
+}
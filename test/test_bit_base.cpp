@@ -2,26 +2,28 @@
 #include "gmock/gmock.h"
 #include <bits>
 
+#include <climits>
+
 using namespace testing;
 
 namespace
 {
 struct U16TestStruct
 {
-    u16 data;
-    u16 result;
+    uint16_t data;
+    uint16_t result;
 };
 
 struct U32TestStruct
 {
-    u32 data;
-    u32 result;
+    uint32_t data;
+    uint32_t result;
 };
 
 //------------------------------------------------------------------------------
-u08 reflect(u08 data)
+uint8_t reflect(uint8_t data)
 {
-    u32 r = data; // r will be reversed bits of v; first get LSB of v
+    uint32_t r = data; // r will be reversed bits of v; first get LSB of v
     int s = sizeof(data) * CHAR_BIT - 1; // extra shift needed at end
 
     for (data >>= 1; data; data >>= 1)
@@ -33,7 +35,7 @@ u08 reflect(u08 data)
 
     r <<= s; // shift when v's highest bits are zero
 
-    return static_cast<u08>(r);
+    return static_cast<uint8_t>(r);
 }
 }
 
@@ -60,10 +62,10 @@ void BitBase::SetUp()
 //------------------------------------------------------------------------------
 TEST_F(BitBase, lsbPosition)
 {
-    u32 data = 774355515UL; // b101110001001111011101000111011
+    uint32_t data = 774355515UL; // b101110001001111011101000111011
 
     // Represent the bit set in that position
-    const std::ssize_t table[]
+    const ssize_t table[]
     {
          0L,  1L, -1L,  3L,  4L,  5L, -1L, -1L,
         -1L,  9L, -1L, 11L, 12L, 13L, -1L, 15L,
@@ -73,7 +75,7 @@ TEST_F(BitBase, lsbPosition)
 
     while (data != 0UL)
     {
-        std::ssize_t result = bit::lsbPos(data);
+        ssize_t result = bit::lsbPos(data);
 
         ASSERT_TRUE(result != -1L);
 
@@ -86,10 +88,10 @@ TEST_F(BitBase, lsbPosition)
 //------------------------------------------------------------------------------
 TEST_F(BitBase, reflectU08)
 {
-    for (u16 i = 0UL; i <= UCHAR_MAX; i++)
+    for (uint16_t i = 0UL; i <= UCHAR_MAX; i++)
     {
-        ASSERT_EQ(bit::reflect(static_cast<u08>(i)),
-                  reflect(static_cast<u08>(i)));
+        ASSERT_EQ(bit::reflect(static_cast<uint8_t>(i)),
+                  reflect(static_cast<uint8_t>(i)));
     }
 }
 
@@ -172,9 +174,9 @@ TEST_F(BitBase, u08Convert)
 {
     struct TestStruct
     {
-        u08 b0;
-        u08 n0;
-        u08 n1;
+        uint8_t b0;
+        uint8_t n0;
+        uint8_t n1;
     };
 
     const TestStruct testData[] =
@@ -199,9 +201,9 @@ TEST_F(BitBase, u16Convert)
 {
     struct TestStruct
     {
-        u16 w0;
-        u08 b0;
-        u08 b1;
+        uint16_t w0;
+        uint8_t b0;
+        uint8_t b1;
     };
 
     const TestStruct testData[] =
@@ -226,9 +228,9 @@ TEST_F(BitBase, u32Convert)
 {
     struct TestStruct
     {
-        u32 dw0;
-        u16 w0;
-        u16 w1;
+        uint32_t dw0;
+        uint16_t w0;
+        uint16_t w1;
     };
 
     const TestStruct testData[] =
@@ -245,3 +247,38 @@ TEST_F(BitBase, u32Convert)
         ASSERT_EQ(bit::toU32(data.w1, data.w0), data.dw0);
     }
 }
+
+//------------------------------------------------------------------------------
+TEST_F(BitBase, popcount)
+{
+    ASSERT_EQ(bit::popcount(static_cast<uint32_t>(0UL)), 0UL);
+    ASSERT_EQ(bit::popcount(static_cast<uint32_t>(0xFFFFFFFFUL)), 32UL);
+    ASSERT_EQ(bit::popcount(static_cast<uint32_t>(0x91733C5AUL)), 16UL);
+    ASSERT_EQ(bit::popcount(static_cast<uint64_t>(0ULL)), 0UL);
+    ASSERT_EQ(bit::popcount(static_cast<uint64_t>(~0ULL)), 64UL);
+    ASSERT_EQ(bit::popcount(static_cast<uint64_t>(0x8000000000000001ULL)), 2UL);
+
+    for (uint32_t data = 1UL; data < 0x01000000UL; data = (data * 3UL) + 1UL)
+    {
+        const uint64_t wide = (static_cast<uint64_t>(data) << 32U) | data;
+
+        ASSERT_EQ(bit::parity64(wide, bit::Even), 0U);
+        ASSERT_EQ(bit::parity64(data, bit::Even), bit::parity(data, bit::Even));
+        ASSERT_EQ(bit::parity64(data, bit::Odd), bit::parity(data, bit::Odd));
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitBase, bitScan)
+{
+    ASSERT_EQ(bit::leadingZeros(~0ULL), 0UL);
+    ASSERT_EQ(bit::trailingZeros(~0ULL), 0UL);
+    ASSERT_EQ(bit::leadingZeros(0x0000F00000000100ULL), 16UL);
+    ASSERT_EQ(bit::trailingZeros(0x0000F00000000100ULL), 8UL);
+
+    for (std::size_t i = 0UL; i < bit::U64_BIT_COUNT; i++)
+    {
+        ASSERT_EQ(bit::leadingZeros(1ULL << i), (bit::U64_BIT_COUNT - 1UL) - i);
+        ASSERT_EQ(bit::trailingZeros(1ULL << i), i);
+    }
+}
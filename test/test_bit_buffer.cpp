@@ -29,3 +29,39 @@ TEST_F(BitBuffer, readWrite)
 {
 }
 
+
+//------------------------------------------------------------------------------
+TEST_F(BitBuffer, lowBitSpan)
+{
+    // MSB on bit 0 of byte 0, the 9 remaining bits span bytes 1 and 2
+    typedef bit::Signal<uint16_t, 0, 10> Level;
+    typedef bit::Signal<uint8_t, 22, 7> Next;
+
+    bit::Buffer<4> buffer;
+
+    Level level;
+    Next next;
+
+    level.write(0x3FFU);
+    next.write(0x55U);
+
+    buffer << level << next;
+
+    ASSERT_EQ(buffer.data()[0], 0x01U);
+    ASSERT_EQ(buffer.data()[1], 0xFFU);
+    ASSERT_EQ(buffer.data()[2], 0x80U | 0x55U);
+
+    Level levelCopy;
+    Next nextCopy;
+
+    buffer >> levelCopy >> nextCopy;
+
+    uint16_t value = 0U;
+    uint8_t nextValue = 0U;
+
+    levelCopy.read(value);
+    nextCopy.read(nextValue);
+
+    ASSERT_EQ(value, 0x3FFU);
+    ASSERT_EQ(nextValue, 0x55U);
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<bool, 20> Brake;
+typedef bit::Signal<int16_t, 39, 12> Trim;
+}
+
+//------------------------------------------------------------------------------
+class BitCache : public Test
+{
+public:
+
+    BitCache();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitCache::BitCache()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitCache::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCache, generation)
+{
+    bit::Buffer<8> frame;
+    bit::Buffer<8> other;
+
+    const bit::Buffer<8>& view = frame;
+
+    Speed speed;
+
+    uint32_t generation = view.generation();
+
+    speed.write(100U);
+    frame << speed;
+
+    ASSERT_NE(view.generation(), generation);
+
+    generation = view.generation();
+
+    // Reads never advance the generation
+    (void) view.data();
+    frame >> speed;
+
+    ASSERT_EQ(view.generation(), generation);
+
+    frame = other;
+
+    ASSERT_NE(view.generation(), generation);
+
+    generation = view.generation();
+
+    frame.clear();
+
+    ASSERT_NE(view.generation(), generation);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCache, read)
+{
+    bit::Buffer<8> frame;
+
+    bit::DecodeCache<8, 4> cache(frame);
+
+    Speed speed;
+    Brake brake;
+    Trim trim;
+
+    speed.write(1234U);
+    brake.write(true);
+    trim.write(-100);
+
+    frame << speed << brake << trim;
+
+    ASSERT_EQ(cache.read<Speed>(), 1234U);
+    ASSERT_EQ(cache.read<Speed>(), 1234U);
+    ASSERT_TRUE(cache.read<Brake>());
+    ASSERT_EQ(cache.read<Trim>(), -100);
+    ASSERT_EQ(cache.read<Brake>(), true);
+    ASSERT_EQ(cache.hits(), 2ULL);
+    ASSERT_EQ(cache.misses(), 3ULL);
+
+    // A write to the buffer drops every cached signal
+    frame.clear();
+    speed.write(4321U);
+    frame << speed;
+
+    ASSERT_EQ(cache.read<Speed>(), 4321U);
+    ASSERT_FALSE(cache.read<Brake>());
+    ASSERT_EQ(cache.misses(), 5ULL);
+
+    // Writes through operator[] are announced with touch()
+    frame[1] = 0U;
+
+    ASSERT_EQ(cache.read<Speed>(), 4321U);
+
+    frame.touch();
+
+    ASSERT_EQ(cache.read<Speed>(), 4096U);
+
+    cache.invalidate();
+
+    ASSERT_EQ(cache.read<Speed>(), 4096U);
+    ASSERT_EQ(cache.misses(), 7ULL);
+}
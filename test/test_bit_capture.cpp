@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+#include <bit_capture.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Counter;
+typedef bit::Signal<uint8_t, 20, 5> Mode;
+
+const std::size_t FRAME_COUNT = 10000UL;
+const std::size_t WORKER_COUNT = 4UL;
+
+//------------------------------------------------------------------------------
+struct Sum
+{
+    Sum()
+        : partial(WORKER_COUNT, 0ULL)
+        , timestamps(WORKER_COUNT, 0ULL)
+    {
+    }
+
+    void operator()(const std::size_t worker,
+                    const std::size_t index,
+                    const uint64_t timestamp,
+                    bit::BufferView& frame)
+    {
+        Counter counter;
+
+        uint16_t value;
+
+        frame >> counter;
+
+        counter.read(value);
+
+        partial[worker] += value + frame.read<Mode>();
+        timestamps[worker] += timestamp - index;
+    }
+
+    std::vector<uint64_t> partial;
+    std::vector<uint64_t> timestamps;
+};
+}
+
+//------------------------------------------------------------------------------
+class BitCapture : public Test
+{
+public:
+
+    BitCapture();
+
+    virtual void SetUp();
+
+    virtual void TearDown();
+
+    char path[32];
+};
+
+//------------------------------------------------------------------------------
+BitCapture::BitCapture()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitCapture::SetUp()
+{
+    (void) std::snprintf(path, sizeof(path), "/tmp/bitcapXXXXXX");
+
+    const int file = mkstemp(path);
+
+    ASSERT_GE(file, 0);
+
+    (void) close(file);
+
+    bit::CaptureWriter writer;
+
+    ASSERT_EQ(writer.open(path, 5UL), bit::CaptureWriter::Ok);
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        bit::Buffer<5> frame;
+
+        Counter counter;
+        Mode mode;
+
+        counter.write(static_cast<uint16_t>(i));
+        mode.write(static_cast<uint8_t>(i % 32UL));
+
+        frame << counter << mode;
+
+        ASSERT_EQ(writer.write(1000ULL + i, frame), bit::CaptureWriter::Ok);
+    }
+
+    ASSERT_EQ(writer.close(), bit::CaptureWriter::Ok);
+}
+
+//------------------------------------------------------------------------------
+void BitCapture::TearDown()
+{
+    (void) std::remove(path);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCapture, frameViews)
+{
+    bit::CaptureReader reader;
+
+    ASSERT_EQ(reader.open(path), bit::CaptureReader::Ok);
+    ASSERT_EQ(reader.count(), FRAME_COUNT);
+    ASSERT_EQ(reader.frameSize(), 5UL);
+    ASSERT_EQ(reader.stride(), 16UL);
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i += 997UL)
+    {
+        bit::BufferView frame = reader.frame(i);
+
+        ASSERT_EQ(reader.timestamp(i), 1000ULL + i);
+        ASSERT_EQ(frame.read<Counter>(), static_cast<uint16_t>(i));
+        ASSERT_EQ(frame.read<Mode>(), static_cast<uint8_t>(i % 32UL));
+        ASSERT_EQ(frame.data(), reader.frames() + (i * reader.stride()));
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCapture, parallelDecode)
+{
+    bit::CaptureReader reader;
+
+    ASSERT_EQ(reader.open(path), bit::CaptureReader::Ok);
+
+    Sum sum;
+
+    reader.decode(WORKER_COUNT, sum);
+
+    uint64_t total = 0ULL;
+    uint64_t timestamps = 0ULL;
+    uint64_t expected = 0ULL;
+
+    for (std::size_t i = 0UL; i < WORKER_COUNT; i++)
+    {
+        total += sum.partial[i];
+        timestamps += sum.timestamps[i];
+    }
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        expected += static_cast<uint16_t>(i) + (i % 32UL);
+    }
+
+    ASSERT_EQ(total, expected);
+    ASSERT_EQ(timestamps, 1000ULL * FRAME_COUNT);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCapture, invalidFile)
+{
+    bit::CaptureReader reader;
+
+    ASSERT_EQ(reader.open("/nonexistent/capture"), bit::CaptureReader::OpenError);
+
+    std::FILE* file = std::fopen(path, "r+b");
+
+    ASSERT_TRUE(file != 0);
+
+    (void) std::fputc(0, file);
+    (void) std::fclose(file);
+
+    ASSERT_EQ(reader.open(path), bit::CaptureReader::FormatError);
+    ASSERT_EQ(reader.count(), 0UL);
+}
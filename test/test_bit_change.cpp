@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<bool, 20> Brake;
+typedef bit::Signal<uint8_t, 19, 4> Gear;
+typedef bit::Signal<uint32_t, 59, 24> Odometer;
+typedef bit::Signal<int16_t, 103, 12> Trim;
+
+//------------------------------------------------------------------------------
+struct Recorder
+{
+    void operator()(const std::size_t signal, bit::BufferView& view)
+    {
+        signals.push_back(signal);
+
+        if (1UL == signal)
+        {
+            brake = view.read<Brake>();
+        }
+    }
+
+    std::vector<std::size_t> signals;
+
+    bool brake;
+};
+}
+
+//------------------------------------------------------------------------------
+class BitChange : public Test
+{
+public:
+
+    BitChange();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitChange::BitChange()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitChange::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitChange, update)
+{
+    bit::ChangeDetector<14> detector;
+
+    ASSERT_EQ(detector.add<Speed>(), 0UL);
+    ASSERT_EQ(detector.add<Brake>(), 1UL);
+    ASSERT_EQ(detector.add<Gear>(), 2UL);
+    ASSERT_EQ(detector.add<Odometer>(), 3UL);
+    ASSERT_EQ(detector.add<Trim>(), 4UL);
+    ASSERT_EQ(detector.count(), 5UL);
+
+    bit::Buffer<14> frame;
+
+    Speed speed;
+    Brake brake;
+    Odometer odometer;
+
+    // The first frame reports every signal
+    ASSERT_EQ(detector.update(frame), 0x1FULL);
+    ASSERT_EQ(detector.update(frame), 0ULL);
+
+    brake.write(true);
+    frame << brake;
+
+    // Gear shares the byte and the word, only Brake changed
+    ASSERT_EQ(detector.update(frame), 0x02ULL);
+
+    // Odometer straddles the first two words
+    odometer.write(0x000001UL);
+    frame << odometer;
+
+    ASSERT_EQ(detector.update(frame), 0x08ULL);
+
+    speed.write(0x0100U);
+    frame << speed;
+    frame[13] = 0x01U;
+
+    // Bits outside every signal are ignored
+    ASSERT_EQ(detector.update(frame), 0x01ULL);
+
+    detector.reset();
+
+    ASSERT_EQ(detector.update(frame), 0x1FULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitChange, decode)
+{
+    bit::ChangeDetector<14> detector;
+
+    (void) detector.add<Speed>();
+    (void) detector.add<Brake>();
+    (void) detector.add<Gear>();
+
+    bit::Buffer<14> frame;
+
+    Recorder recorder;
+
+    (void) detector.decode(frame, recorder);
+
+    ASSERT_EQ(recorder.signals.size(), 3UL);
+    ASSERT_FALSE(recorder.brake);
+
+    Brake brake;
+    Speed speed;
+
+    brake.write(true);
+    speed.write(1U);
+    frame << brake << speed;
+
+    recorder.signals.clear();
+
+    ASSERT_EQ(detector.decode(frame, recorder), 0x03ULL);
+    ASSERT_EQ(recorder.signals.size(), 2UL);
+    ASSERT_EQ(recorder.signals[0], 0UL);
+    ASSERT_EQ(recorder.signals[1], 1UL);
+    ASSERT_TRUE(recorder.brake);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitChange, overflow)
+{
+    bit::ChangeDetector<8> detector;
+
+    for (std::size_t i = 0UL; i < bit::ChangeDetector<8>::MAX_SIGNALS; i++)
+    {
+        ASSERT_EQ(detector.add<Brake>(), i);
+    }
+
+    ASSERT_EQ(detector.status(), bit::ChangeDetector<8>::Ok);
+    ASSERT_EQ(detector.add<Brake>(), bit::ChangeDetector<8>::MAX_SIGNALS);
+    ASSERT_EQ(detector.status(), bit::ChangeDetector<8>::Overflow);
+
+    bit::Buffer<8> frame;
+
+    ASSERT_EQ(detector.update(frame), ~0ULL);
+
+    Brake brake;
+
+    brake.write(true);
+    frame << brake;
+
+    ASSERT_EQ(detector.update(frame), ~0ULL);
+}
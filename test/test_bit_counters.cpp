@@ -0,0 +1,204 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<int16_t, 23, 12> Trim;
+typedef bit::Signal<bool, 27> Brake;
+
+struct Overrun
+{
+    const void* source;
+    std::size_t index;
+    std::size_t count;
+};
+
+//------------------------------------------------------------------------------
+void onOverflow(void* context, const void* source, const std::size_t index)
+{
+    Overrun& overrun = *static_cast<Overrun*>(context);
+
+    overrun.source = source;
+    overrun.index = index;
+    overrun.count++;
+}
+
+//------------------------------------------------------------------------------
+void decodeFrames()
+{
+    for (std::size_t i = 0UL; i < 1000UL; i++)
+    {
+        bit::Counters::add(bit::FramesDecoded, 1ULL);
+    }
+}
+}
+
+//------------------------------------------------------------------------------
+class BitCounters : public Test
+{
+public:
+
+    BitCounters();
+
+    virtual void SetUp();
+
+    virtual void TearDown();
+};
+
+//------------------------------------------------------------------------------
+BitCounters::BitCounters()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitCounters::SetUp()
+{
+    bit::Counters::setOverflowHook(0, 0);
+    bit::Counters::reset();
+}
+
+//------------------------------------------------------------------------------
+void BitCounters::TearDown()
+{
+    // The hooks of the tests point to their stack
+    bit::Counters::setOverflowHook(0, 0);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCounters, aggregate)
+{
+    static bit::CounterSnapshot snapshot;
+
+    bit::Counters::add(bit::FramesEncoded, 3ULL);
+    bit::Counters::access(bit::Field<Trim>::OFFSET);
+    bit::Counters::access(bit::Field<Trim>::OFFSET + bit::COUNTER_SIGNAL_SLOTS);
+
+    std::vector<std::thread> pool;
+
+    for (std::size_t i = 0UL; i < 4UL; i++)
+    {
+        pool.push_back(std::thread(decodeFrames));
+    }
+
+    for (std::size_t i = 0UL; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+
+    bit::Counters::snapshot(snapshot);
+
+    ASSERT_EQ(snapshot.values[bit::FramesEncoded], 3ULL);
+    ASSERT_EQ(snapshot.values[bit::FramesDecoded], 4000ULL);
+    ASSERT_EQ(snapshot.signals[bit::Field<Trim>::OFFSET], 2ULL);
+    // The main thread and at least one worker, exited workers free their block
+    ASSERT_GE(bit::Counters::threads(), 2UL);
+
+    bit::Counters::reset();
+    bit::Counters::snapshot(snapshot);
+
+    ASSERT_EQ(snapshot.values[bit::FramesDecoded], 0ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCounters, recycle)
+{
+    static bit::CounterSnapshot snapshot;
+
+    const std::size_t count = 2UL * bit::COUNTER_MAX_THREADS;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        std::thread thread(decodeFrames);
+
+        thread.join();
+    }
+
+    bit::Counters::snapshot(snapshot);
+
+    // Every thread reused the block of the previous one, none is shared
+    ASSERT_LT(bit::Counters::threads(), bit::COUNTER_MAX_THREADS);
+    ASSERT_EQ(snapshot.values[bit::FramesDecoded], count * 1000ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCounters, overflowHook)
+{
+    static bit::CounterSnapshot snapshot;
+
+    Overrun overrun = {0, 0UL, 0UL};
+
+    const int source = 0;
+
+    bit::Counters::overflow(&source, 9UL);
+
+    ASSERT_EQ(overrun.count, 0UL);
+
+    bit::Counters::setOverflowHook(&onOverflow, &overrun);
+    bit::Counters::overflow(&source, 9UL);
+
+    ASSERT_EQ(overrun.count, 1UL);
+    ASSERT_EQ(overrun.source, &source);
+    ASSERT_EQ(overrun.index, 9UL);
+
+    bit::Counters::snapshot(snapshot);
+
+    ASSERT_EQ(snapshot.values[bit::Overflows], 2ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitCounters, signalOffset)
+{
+    Speed speed;
+    Trim trim;
+    Brake brake;
+
+    ASSERT_EQ(bit::signalOffset(speed), bit::Field<Speed>::OFFSET);
+    ASSERT_EQ(bit::signalOffset(trim), bit::Field<Trim>::OFFSET);
+    ASSERT_EQ(bit::signalOffset(brake), bit::Field<Brake>::OFFSET);
+
+    const uint64_t start = bit::Counters::cycles();
+
+    ASSERT_GE(bit::Counters::cycles(), start);
+}
+
+#if defined(BIT_INSTRUMENTATION)
+
+//------------------------------------------------------------------------------
+TEST_F(BitCounters, instrumentation)
+{
+    static bit::CounterSnapshot snapshot;
+
+    Overrun overrun = {0, 0UL, 0UL};
+
+    bit::Counters::setOverflowHook(&onOverflow, &overrun);
+
+    bit::Buffer<3> frame;
+
+    Speed speed;
+    Trim trim;
+
+    speed.write(100U);
+    trim.write(-5);
+
+    frame << speed << trim;
+    frame >> speed;
+
+    bit::Counters::snapshot(snapshot);
+
+    ASSERT_EQ(snapshot.values[bit::SignalWrites], 2ULL);
+    ASSERT_EQ(snapshot.values[bit::SignalReads], 1ULL);
+    ASSERT_EQ(snapshot.signals[bit::Field<Speed>::OFFSET], 2ULL);
+    ASSERT_EQ(snapshot.signals[bit::Field<Trim>::OFFSET], 1ULL);
+    ASSERT_GE(snapshot.values[bit::Overflows], 1ULL);
+    ASSERT_EQ(overrun.source, &frame);
+    ASSERT_EQ(overrun.index, 3UL);
+}
+
+#endif
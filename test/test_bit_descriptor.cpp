@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<int16_t, 23, 12> Trim;
+typedef bit::Signal<bool, 27> Brake;
+typedef bit::Signal<float, 39> Torque;
+}
+
+//------------------------------------------------------------------------------
+class BitDescriptor : public Test
+{
+public:
+
+    BitDescriptor();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitDescriptor::BitDescriptor()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitDescriptor::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitDescriptor, signal)
+{
+    const bit::Descriptor descriptors[4] = {bit::describe<Speed>(),
+                                            bit::describe<Trim>(),
+                                            bit::describe<Brake>(),
+                                            bit::describe<Torque>()};
+
+    ASSERT_EQ(sizeof(bit::Descriptor), 4UL);
+    ASSERT_EQ(descriptors[1].offset, bit::Field<Trim>::OFFSET);
+    ASSERT_EQ(descriptors[1].flags, bit::Signed);
+    ASSERT_EQ(descriptors[3].flags, bit::Float32);
+
+    bit::Buffer<8> frame;
+
+    Speed speed;
+    Trim trim;
+    Brake brake;
+    Torque torque;
+
+    speed.write(300U);
+    trim.write(-42);
+    brake.write(true);
+    torque.write(2.5F);
+
+    frame << speed << trim << brake << torque;
+
+    uint64_t raw[4];
+
+    bit::readAll(descriptors, 4UL, frame.data(), 8UL, raw);
+
+    ASSERT_EQ(raw[0], 300ULL);
+    ASSERT_EQ(static_cast<int64_t>(raw[1]), -42LL);
+    ASSERT_EQ(raw[2], 1ULL);
+    ASSERT_EQ(bit::readValue(descriptors[3], frame.data(), 8UL), 2.5);
+
+    bit::writeRaw(descriptors[1], frame.data(), 8UL, static_cast<uint64_t>(-7));
+    bit::writeRaw(descriptors[0], frame.data(), 8UL, 0xFFFFFULL);
+
+    ASSERT_EQ(bit::Field<Trim>::read(frame.data(), 8UL), -7);
+    ASSERT_EQ(bit::Field<Speed>::read(frame.data(), 8UL), 0xFFFFU);
+    ASSERT_TRUE(bit::Field<Brake>::read(frame.data(), 8UL));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitDescriptor, schema)
+{
+    static bit::Schema schema;
+    static bit::DecodeTable table;
+
+    std::size_t line = 0UL;
+
+    ASSERT_EQ(schema.load("counter 0 8 unsigned intel\n"
+                          "trim 12 12 signed intel\n"
+                          "wide 4 64 unsigned intel\n"
+                          "tail 60 64 unsigned motorola\n", line), bit::Schema::Ok);
+
+    table.compile(schema);
+
+    const uint8_t data[16] = {0x34U, 0xB2U, 0xFFU, 0x00U, 0x00U, 0x00U, 0x00U, 0xA0U,
+                              0x0BU, 0x12U, 0x34U, 0x56U, 0x78U, 0x9AU, 0xBCU, 0xDEU};
+
+    bit::Descriptor descriptors[4];
+
+    uint64_t expected[4];
+    uint64_t raw[4];
+
+    for (std::size_t i = 0UL; i < 4UL; i++)
+    {
+        ASSERT_TRUE(bit::describe(schema.signal(i), descriptors[i]));
+    }
+
+    (void) table.decodeRaw(data, sizeof(data), expected);
+
+    bit::readAll(descriptors, 4UL, data, sizeof(data), raw);
+
+    for (std::size_t i = 0UL; i < 4UL; i++)
+    {
+        ASSERT_EQ(raw[i], expected[i]);
+    }
+
+    ASSERT_EQ(bit::readValue(descriptors[1], data, sizeof(data)), -5.0);
+
+    // Intel fields are written back in place
+    uint8_t copy[16] = {0U};
+
+    for (std::size_t i = 0UL; i < 4UL; i++)
+    {
+        bit::writeRaw(descriptors[i], copy, sizeof(copy), raw[i]);
+    }
+
+    // The last 5 bits of the frame belong to no signal
+    ASSERT_EQ(std::memcmp(copy, data, sizeof(data) - 1UL), 0);
+    ASSERT_EQ(copy[15], 0xC0U);
+
+    bit::SchemaSignal far = schema.signal(0UL);
+
+    far.position = 0x10000U;
+
+    ASSERT_FALSE(bit::describe(far, descriptors[0]));
+}
@@ -0,0 +1,212 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+//------------------------------------------------------------------------------
+uint64_t nextWord(uint64_t& state)
+{
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+
+    return state;
+}
+
+//------------------------------------------------------------------------------
+uint8_t referenceCheck(const uint64_t data, const std::size_t dataBits)
+{
+    const std::size_t hammingBits = (64UL == dataBits) ? 7UL : 6UL;
+
+    uint8_t result = 0U;
+
+    std::size_t position = 1UL;
+
+    for (std::size_t bit = 0UL; bit < dataBits; position++)
+    {
+        if ((position & (position - 1UL)) != 0UL)
+        {
+            if (((data >> bit) & 1ULL) != 0ULL)
+            {
+                result ^= static_cast<uint8_t>(position);
+            }
+
+            bit++;
+        }
+    }
+
+    const std::size_t ones = bit::popcount(data) + bit::popcount(static_cast<uint32_t>(result));
+
+    return result | static_cast<uint8_t>((ones & 1UL) << hammingBits);
+}
+}
+
+//------------------------------------------------------------------------------
+class BitEcc : public Test
+{
+public:
+
+    BitEcc();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitEcc::BitEcc()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitEcc::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitEcc, encode)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (std::size_t i = 0UL; i < 1000UL; i++)
+    {
+        const uint64_t data = nextWord(state);
+        const uint32_t half = static_cast<uint32_t>(data);
+
+        ASSERT_EQ(bit::Secded::encode(data), referenceCheck(data, 64UL));
+        ASSERT_EQ(bit::Secded::encode(half), referenceCheck(half, 32UL));
+        ASSERT_EQ(bit::Secded::syndrome(data, bit::Secded::encode(data)), 0U);
+        ASSERT_EQ(bit::Secded::syndrome(half, bit::Secded::encode(half)), 0U);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitEcc, correct64)
+{
+    const uint64_t data = 0x0123456789ABCDEFULL;
+    const uint8_t check = bit::Secded::encode(data);
+
+    // Every single bit error of the 72-bit codeword
+    for (std::size_t i = 0UL; i < 72UL; i++)
+    {
+        uint64_t word = data;
+        uint8_t bits = check;
+
+        if (i < 64UL)
+        {
+            word ^= 1ULL << i;
+        }
+        else
+        {
+            bits ^= static_cast<uint8_t>(1U << (i - 64UL));
+        }
+
+        ASSERT_EQ(bit::Secded::correct(word, bits), bit::Secded::Corrected);
+        ASSERT_EQ(word, data);
+        ASSERT_EQ(bits, check);
+    }
+
+    // Every double bit error is detected, never miscorrected
+    for (std::size_t i = 0UL; i < 72UL; i++)
+    {
+        for (std::size_t j = i + 1UL; j < 72UL; j++)
+        {
+            uint64_t word = data;
+            uint8_t bits = check;
+
+            word ^= (i < 64UL) ? (1ULL << i) : 0ULL;
+            word ^= (j < 64UL) ? (1ULL << j) : 0ULL;
+            bits ^= (i < 64UL) ? 0U : static_cast<uint8_t>(1U << (i - 64UL));
+            bits ^= (j < 64UL) ? 0U : static_cast<uint8_t>(1U << (j - 64UL));
+
+            const uint64_t received = word;
+
+            ASSERT_EQ(bit::Secded::correct(word, bits), bit::Secded::Uncorrectable);
+            ASSERT_EQ(word, received);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitEcc, correct32)
+{
+    const uint32_t data = 0xDEADBEEFUL;
+    const uint8_t check = bit::Secded::encode(data);
+
+    for (std::size_t i = 0UL; i < 39UL; i++)
+    {
+        for (std::size_t j = i; j < 39UL; j++)
+        {
+            uint32_t word = data;
+            uint8_t bits = check;
+
+            word ^= (i < 32UL) ? (1UL << i) : 0UL;
+            bits ^= (i < 32UL) ? 0U : static_cast<uint8_t>(1U << (i - 32UL));
+
+            if (j != i)
+            {
+                word ^= (j < 32UL) ? (1UL << j) : 0UL;
+                bits ^= (j < 32UL) ? 0U : static_cast<uint8_t>(1U << (j - 32UL));
+
+                ASSERT_EQ(bit::Secded::correct(word, bits), bit::Secded::Uncorrectable);
+            }
+            else
+            {
+                ASSERT_EQ(bit::Secded::correct(word, bits), bit::Secded::Corrected);
+                ASSERT_EQ(word, data);
+                ASSERT_EQ(bits, check);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitEcc, batch)
+{
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+
+    std::vector<uint64_t> words(203UL);
+    std::vector<uint32_t> halves(words.size());
+    std::vector<uint8_t> checks(words.size());
+    std::vector<uint8_t> halfChecks(words.size());
+
+    for (std::size_t i = 0UL; i < words.size(); i++)
+    {
+        words[i] = nextWord(state);
+        halves[i] = static_cast<uint32_t>(words[i] >> 16U);
+    }
+
+    bit::Secded::encode(words.data(), checks.data(), words.size());
+    bit::Secded::encode(halves.data(), halfChecks.data(), halves.size());
+
+    for (std::size_t i = 0UL; i < words.size(); i++)
+    {
+        ASSERT_EQ(checks[i], bit::Secded::encode(words[i]));
+        ASSERT_EQ(halfChecks[i], bit::Secded::encode(halves[i]));
+    }
+
+    ASSERT_EQ(bit::Secded::correct(words.data(), checks.data(), words.size()),
+              bit::Secded::Ok);
+
+    const std::vector<uint64_t> original = words;
+    const std::vector<uint32_t> halfOriginal = halves;
+
+    words[5] ^= 1ULL << 40U;
+    checks[130] ^= 0x80U;
+    halves[77] ^= 1UL << 31U;
+
+    ASSERT_EQ(bit::Secded::correct(words.data(), checks.data(), words.size()),
+              bit::Secded::Corrected);
+    ASSERT_EQ(bit::Secded::correct(halves.data(), halfChecks.data(), halves.size()),
+              bit::Secded::Corrected);
+    ASSERT_TRUE(words == original);
+    ASSERT_TRUE(halves == halfOriginal);
+
+    words[9] ^= 3ULL;
+
+    ASSERT_EQ(bit::Secded::correct(words.data(), checks.data(), words.size()),
+              bit::Secded::Uncorrectable);
+}
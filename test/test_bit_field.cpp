@@ -0,0 +1,187 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+//------------------------------------------------------------------------------
+template <typename SignalType, std::size_t Size>
+void checkField(const typename SignalType::Type& value)
+{
+    bit::Buffer<Size> buffer;
+
+    SignalType signal;
+
+    signal.write(value);
+
+    buffer << signal;
+
+    ASSERT_EQ(buffer.status(), bit::Buffer<Size>::Ok);
+
+    ASSERT_EQ(bit::Field<SignalType>::read(buffer.data(), Size), value);
+
+    bit::Buffer<Size> written;
+
+    bit::Field<SignalType>::write(written.data(), Size, value);
+
+    for (std::size_t i = 0UL; i < Size; i++)
+    {
+        ASSERT_EQ(written[i], buffer[i]);
+    }
+}
+}
+
+//------------------------------------------------------------------------------
+class BitField : public Test
+{
+public:
+
+    BitField();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitField::BitField()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitField::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, offset)
+{
+    ASSERT_EQ(bit::fieldOffset(7UL), 0UL);
+    ASSERT_EQ(bit::fieldOffset(0UL), 7UL);
+    ASSERT_EQ(bit::fieldOffset(15UL), 8UL);
+    ASSERT_EQ(bit::fieldOffset(10UL), 13UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, signalLayout)
+{
+    checkField<bit::Signal<bool, 0>, 1>(true);
+    checkField<bit::Signal<bool, 13>, 2>(true);
+    checkField<bit::Signal<uint8_t, 7, 8>, 1>(0xA5U);
+    checkField<bit::Signal<uint8_t, 0, 8>, 2>(0xA5U);
+    checkField<bit::Signal<uint8_t, 5, 3>, 1>(0x05U);
+    checkField<bit::Signal<uint16_t, 11, 12>, 3>(0x0ABCU);
+    checkField<bit::Signal<uint16_t, 3, 16>, 3>(0xBEEFU);
+    checkField<bit::Signal<uint32_t, 60, 32>, 12>(0xDEADBEEFUL);
+    checkField<bit::Signal<uint32_t, 2, 29>, 5>(0x1BADF00DUL);
+    checkField<bit::Signal<float, 23>, 8>(3.25F);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, signExtension)
+{
+    const uint8_t data[] = { 0xF0U, 0x00U };
+
+    int8_t value;
+
+    bit::fieldValue(bit::extractField(data, sizeof(data), 0UL, 4UL), 4UL, value);
+
+    ASSERT_EQ(value, -1);
+
+    bit::fieldValue(bit::extractField(data, sizeof(data), 3UL, 4UL), 4UL, value);
+
+    ASSERT_EQ(value, -8);
+
+    bit::fieldValue(bit::extractField(data, sizeof(data), 3UL, 5UL), 5UL, value);
+
+    ASSERT_EQ(value, -16);
+
+    bit::fieldValue(bit::extractField(data, sizeof(data), 4UL, 4UL), 4UL, value);
+
+    ASSERT_EQ(value, 0);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, signedSignal)
+{
+    checkField<bit::Signal<int8_t, 7, 4>, 1>(-1);
+    checkField<bit::Signal<int8_t, 5, 3>, 1>(-4);
+    checkField<bit::Signal<int16_t, 11, 12>, 3>(-1234);
+    checkField<bit::Signal<int32_t, 2, 29>, 5>(-0x0BADF00DL);
+
+    typedef bit::Signal<int8_t, 7, 4> Nibble;
+
+    bit::Buffer<1> buffer;
+
+    Nibble written;
+    Nibble read;
+
+    written.write(-1);
+
+    buffer << written;
+    buffer >> read;
+
+    int8_t value = 0;
+
+    read.read(value);
+
+    ASSERT_EQ(value, -1);
+    ASSERT_EQ(value, bit::Field<Nibble>::read(buffer.data(), 1UL));
+
+    written.write(7);
+    read.clear();
+    buffer.clear();
+
+    buffer << written;
+    buffer >> read;
+
+    read.read(value);
+
+    ASSERT_EQ(value, 7);
+    ASSERT_EQ(value, bit::Field<Nibble>::read(buffer.data(), 1UL));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, wideField)
+{
+    const uint8_t data[] =
+    {
+        0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU, 0x80U
+    };
+
+    ASSERT_EQ(bit::extractField(data, sizeof(data), 0UL, 64UL),
+              0x0123456789ABCDEFULL);
+    ASSERT_EQ(bit::extractField(data, sizeof(data), 1UL, 64UL),
+              0x02468ACF13579BDFULL);
+    ASSERT_EQ(bit::extractField(data, 8UL, 1UL, 64UL),
+              0x02468ACF13579BDEULL);
+    ASSERT_EQ(bit::extractField(data, 4UL, 28UL, 8UL), 0x70ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitField, insertField)
+{
+    uint8_t data[] =
+    {
+        0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+    };
+
+    // Fast path, surrounding bits are kept
+    bit::insertField(data, sizeof(data), 4UL, 8UL, 0x5AULL);
+
+    ASSERT_EQ(data[0], 0xF5U);
+    ASSERT_EQ(data[1], 0xAFU);
+
+    // Slow path across the 8-byte window, upper raw bits are ignored
+    bit::insertField(data, sizeof(data), 60UL, 8UL, 0x100ULL);
+
+    ASSERT_EQ(data[7], 0xF0U);
+    ASSERT_EQ(data[8], 0x0FU);
+    ASSERT_EQ(bit::extractField(data, sizeof(data), 60UL, 8UL), 0ULL);
+
+    // Bits beyond the buffer size are never written
+    bit::insertField(data, 4UL, 28UL, 8UL, 0x00ULL);
+
+    ASSERT_EQ(data[3], 0xF0U);
+    ASSERT_EQ(data[4], 0xFFU);
+}
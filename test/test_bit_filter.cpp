@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <cstdlib>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint8_t, 5, 3> Selector;
+typedef bit::Signal<bool, 1> Error;
+typedef bit::Signal<uint16_t, 19, 12> Speed;
+
+const std::size_t FRAME_COUNT = 1000UL;
+
+//------------------------------------------------------------------------------
+template <typename SignalType, std::size_t Size>
+typename SignalType::Type decode(bit::Buffer<Size>& frame)
+{
+    SignalType signal;
+
+    typename SignalType::Type result;
+
+    frame >> signal;
+
+    signal.read(result);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+template <typename SignalType, std::size_t Size>
+void encode(bit::Buffer<Size>& frame, const typename SignalType::Type& value)
+{
+    SignalType signal;
+
+    signal.write(value);
+
+    frame << signal;
+}
+
+//------------------------------------------------------------------------------
+template <std::size_t Size>
+void generate(std::vector<bit::Buffer<Size> >& frames)
+{
+    std::srand(7U);
+
+    for (auto& frame : frames)
+    {
+        frame.clear();
+
+        for (std::size_t i = 0UL; i < Size; i++)
+        {
+            frame[i] = static_cast<uint8_t>(std::rand() & 0x04);
+        }
+
+        encode<Selector>(frame, static_cast<uint8_t>(std::rand() % 8));
+        encode<Error>(frame, (std::rand() % 3) == 0);
+        encode<Speed>(frame, static_cast<uint16_t>(std::rand() % 4));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <std::size_t Size>
+void checkFilter()
+{
+    std::vector<bit::Buffer<Size> > frames(FRAME_COUNT);
+
+    generate(frames);
+
+    bit::Filter<Size> filter;
+
+    filter.template match<Selector>(3U).template match<Error>(true);
+
+    ASSERT_EQ(filter.status(), bit::Buffer<Size>::Ok);
+
+    std::vector<uint64_t> bitmap((FRAME_COUNT + 63UL) / 64UL);
+    std::vector<std::size_t> indices(FRAME_COUNT);
+
+    const std::size_t matches = filter.scan(frames.data(), FRAME_COUNT,
+                                            bitmap.data());
+
+    const std::size_t found = filter.find(frames.data(), FRAME_COUNT,
+                                          indices.data(), indices.size());
+
+    ASSERT_EQ(matches, found);
+
+    std::size_t expected = 0UL;
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        const bool isMatch = (decode<Selector>(frames[i]) == 3U) &&
+                             decode<Error>(frames[i]);
+
+        ASSERT_EQ(isMatch, ((bitmap[i / 64UL] >> (i % 64UL)) & 1ULL) != 0ULL);
+
+        if (isMatch)
+        {
+            ASSERT_EQ(indices[expected], i);
+
+            expected++;
+        }
+    }
+
+    ASSERT_EQ(expected, matches);
+    ASSERT_GT(expected, 0UL);
+}
+}
+
+//------------------------------------------------------------------------------
+class BitFilter : public Test
+{
+public:
+
+    BitFilter();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitFilter::BitFilter()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitFilter::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFilter, signalPattern)
+{
+    checkFilter<4>();
+    checkFilter<8>();
+    checkFilter<64>();
+    checkFilter<1500>();
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFilter, spreadPattern)
+{
+    const std::size_t size = 100UL;
+    const std::size_t stride = 112UL;
+
+    std::vector<uint8_t> log(FRAME_COUNT * stride);
+
+    for (std::size_t i = 0UL; i < log.size(); i++)
+    {
+        log[i] = static_cast<uint8_t>(i * 7UL);
+    }
+
+    bit::Filter<size> filter;
+
+    filter.match(1UL, 0xF0U, 0x30U).match(98UL, 0x01U, 0x01U);
+
+    std::vector<std::size_t> indices(FRAME_COUNT);
+
+    const std::size_t found = filter.find(log.data(), FRAME_COUNT, stride,
+                                          indices.data(), indices.size());
+
+    std::size_t expected = 0UL;
+
+    for (std::size_t i = 0UL; i < FRAME_COUNT; i++)
+    {
+        const uint8_t* frame = &log[i * stride];
+
+        if (((frame[1] & 0xF0U) == 0x30U) && ((frame[98] & 0x01U) != 0U))
+        {
+            ASSERT_LT(expected, found);
+            ASSERT_EQ(indices[expected], i);
+
+            expected++;
+        }
+    }
+
+    ASSERT_EQ(expected, found);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFilter, overflow)
+{
+    bit::Filter<2> filter;
+
+    filter.match<Speed>(1U);
+
+    ASSERT_EQ(filter.status(), bit::Buffer<2>::Overflow);
+
+    filter.clear();
+
+    ASSERT_EQ(filter.status(), bit::Buffer<2>::Ok);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFilter, empty)
+{
+    bit::Filter<8> filter;
+
+    filter.match<Speed>(1U);
+
+    const bit::Buffer<8>* frames = 0;
+
+    uint64_t bitmap = ~0ULL;
+    std::size_t index = 0UL;
+
+    ASSERT_EQ(filter.scan(frames, 0UL, &bitmap), 0UL);
+    ASSERT_EQ(filter.find(frames, 0UL, &index, 1UL), 0UL);
+    ASSERT_EQ(bitmap, ~0ULL);
+}
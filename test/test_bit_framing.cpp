@@ -0,0 +1,271 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef std::vector<uint8_t> Bytes;
+
+//------------------------------------------------------------------------------
+Bytes encode(const bit::Framing framing, const Bytes& payload)
+{
+    Bytes result(bit::maxFrameSize(framing, payload.size()), 0xEEU);
+
+    const std::size_t size = bit::encodeFrame(framing, payload.data(), payload.size(),
+                                              result.data(), result.size());
+
+    result.resize(size);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Bytes randomBytes(uint32_t& state, const std::size_t count, const uint32_t special)
+{
+    Bytes result;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        // Dense delimiters and escapes, or long runs without
+        const uint8_t bytes[] = { 0x00U, 0xC0U, 0xDBU };
+
+        result.push_back(((state % 16U) < special) ? bytes[(state >> 8) % 3U] :
+                                                     static_cast<uint8_t>(state >> 16));
+    }
+
+    return result;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitFraming : public Test
+{
+public:
+
+    BitFraming();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitFraming::BitFraming()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitFraming::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, cobsVectors)
+{
+    ASSERT_THAT(encode(bit::Cobs, Bytes()), ElementsAre(0x01U, 0x00U));
+    ASSERT_THAT(encode(bit::Cobs, Bytes(1UL, 0x00U)), ElementsAre(0x01U, 0x01U, 0x00U));
+    ASSERT_THAT(encode(bit::Cobs, Bytes(2UL, 0x00U)),
+                ElementsAre(0x01U, 0x01U, 0x01U, 0x00U));
+
+    const uint8_t mixed[] = { 0x11U, 0x22U, 0x00U, 0x33U };
+
+    ASSERT_THAT(encode(bit::Cobs, Bytes(mixed, mixed + 4)),
+                ElementsAre(0x03U, 0x11U, 0x22U, 0x02U, 0x33U, 0x00U));
+
+    // 254 non-zero bytes fill one block, the 255th starts another
+    Bytes block;
+
+    for (uint32_t i = 1U; i < 256U; i++)
+    {
+        block.push_back(static_cast<uint8_t>(i));
+    }
+
+    Bytes frame = encode(bit::Cobs, Bytes(block.begin(), block.end() - 1));
+
+    ASSERT_EQ(frame.size(), 256UL);
+    ASSERT_EQ(frame[0], 0xFFU);
+    ASSERT_EQ(frame[254], 0xFEU);
+    ASSERT_EQ(frame[255], 0x00U);
+
+    frame = encode(bit::Cobs, block);
+
+    ASSERT_EQ(frame.size(), 258UL);
+    ASSERT_EQ(frame[0], 0xFFU);
+    ASSERT_EQ(frame[255], 0x02U);
+    ASSERT_EQ(frame[256], 0xFFU);
+    ASSERT_EQ(frame[257], 0x00U);
+
+    // Too small an output
+    uint8_t output[4] = { 0U };
+
+    ASSERT_EQ(bit::encodeFrame(bit::Cobs, mixed, 4UL, output, 4UL), 0UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, slipVectors)
+{
+    const uint8_t payload[] = { 0x01U, 0xC0U, 0x02U, 0xDBU };
+
+    ASSERT_THAT(encode(bit::Slip, Bytes(payload, payload + 4)),
+                ElementsAre(0x01U, 0xDBU, 0xDCU, 0x02U, 0xDBU, 0xDDU, 0xC0U));
+    ASSERT_THAT(encode(bit::Slip, Bytes()), ElementsAre(0xC0U));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, roundTrip)
+{
+    uint32_t state = 0x2545F491UL;
+
+    const bit::Framing framings[] = { bit::Cobs, bit::Slip };
+
+    for (std::size_t f = 0UL; f < 2UL; f++)
+    {
+        for (uint32_t special = 0U; special < 16U; special += 3U)
+        {
+            // A stream of frames, each preceded by an empty one
+            std::vector<Bytes> payloads;
+
+            Bytes stream;
+
+            for (std::size_t length = 1UL; length < 700UL; length += 61UL)
+            {
+                payloads.push_back(randomBytes(state, length, special));
+
+                const Bytes frame = encode(framings[f], payloads.back());
+
+                stream.push_back((bit::Cobs == framings[f]) ? bit::COBS_DELIMITER : bit::SLIP_END);
+                stream.insert(stream.end(), frame.begin(), frame.end());
+            }
+
+            // Fed in pieces of every size up to a few SIMD widths
+            for (std::size_t piece = 1UL; piece < 100UL; piece += 7UL)
+            {
+                uint8_t storage[700] = { 0U };
+
+                bit::FrameDecoder decoder(framings[f], storage, sizeof(storage));
+
+                std::size_t frames = 0UL;
+
+                for (std::size_t i = 0UL; i < stream.size(); i += piece)
+                {
+                    std::size_t size = ((stream.size() - i) < piece) ? (stream.size() - i) : piece;
+
+                    const uint8_t* data = &stream[i];
+
+                    while (size != 0UL)
+                    {
+                        const std::size_t consumed = decoder.feed(data, size);
+
+                        data += consumed;
+                        size -= consumed;
+
+                        if (decoder.isComplete())
+                        {
+                            ASSERT_LT(frames, payloads.size());
+                            ASSERT_EQ(decoder.status(), bit::FrameDecoder::Ok);
+                            ASSERT_EQ(decoder.size(), payloads[frames].size());
+                            ASSERT_TRUE(Bytes(storage, storage + decoder.size()) == payloads[frames]);
+
+                            frames++;
+
+                            decoder.next();
+                        }
+                    }
+                }
+
+                ASSERT_EQ(frames, payloads.size());
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, errors)
+{
+    uint8_t storage[4] = { 0U };
+
+    // Delimiter inside a COBS block, the decoder resumes with the next frame
+    const uint8_t cobs[] = { 0x04U, 0x11U, 0x00U, 0x02U, 0x22U, 0x00U };
+
+    bit::FrameDecoder decoder(bit::Cobs, storage, sizeof(storage));
+
+    ASSERT_EQ(decoder.feed(cobs, sizeof(cobs)), 3UL);
+    ASSERT_TRUE(decoder.isComplete());
+    ASSERT_EQ(decoder.status(), bit::FrameDecoder::FrameError);
+    ASSERT_EQ(decoder.feed(&cobs[3], 3UL), 0UL);
+
+    decoder.next();
+
+    ASSERT_EQ(decoder.feed(&cobs[3], 3UL), 3UL);
+    ASSERT_TRUE(decoder.isComplete());
+    ASSERT_EQ(decoder.status(), bit::FrameDecoder::Ok);
+    ASSERT_EQ(decoder.size(), 1UL);
+    ASSERT_EQ(storage[0], 0x22U);
+
+    // Invalid SLIP escape, kept as data
+    const uint8_t slip[] = { 0x01U, 0xDBU, 0x02U, 0xC0U };
+
+    bit::FrameDecoder slipDecoder(bit::Slip, storage, sizeof(storage));
+
+    ASSERT_EQ(slipDecoder.feed(slip, sizeof(slip)), 4UL);
+    ASSERT_TRUE(slipDecoder.isComplete());
+    ASSERT_EQ(slipDecoder.status(), bit::FrameDecoder::FrameError);
+    ASSERT_THAT(Bytes(storage, storage + slipDecoder.size()), ElementsAre(0x01U, 0x02U));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, overflow)
+{
+    uint8_t storage[4] = { 0U };
+
+    const Bytes stream = encode(bit::Slip, Bytes(6UL, 0x5AU));
+    const Bytes next = encode(bit::Slip, Bytes(3UL, 0xA5U));
+
+    bit::FrameDecoder decoder(bit::Slip, storage, sizeof(storage));
+
+    // The frame is dropped up to its delimiter
+    ASSERT_EQ(decoder.feed(stream.data(), stream.size()), stream.size());
+    ASSERT_TRUE(decoder.isComplete());
+    ASSERT_EQ(decoder.status(), bit::FrameDecoder::Overflow);
+    ASSERT_EQ(decoder.size(), 0UL);
+
+    decoder.next();
+
+    ASSERT_EQ(decoder.feed(next.data(), next.size()), next.size());
+    ASSERT_EQ(decoder.status(), bit::FrameDecoder::Ok);
+    ASSERT_EQ(decoder.size(), 3UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitFraming, buffer)
+{
+    bit::Buffer<4> payload;
+    bit::Buffer<4> received;
+
+    payload.data()[0] = 0x00U;
+    payload.data()[1] = 0xC0U;
+    payload.data()[2] = 0x00U;
+    payload.data()[3] = 0xDBU;
+
+    uint8_t frame[16] = { 0U };
+
+    const std::size_t size = bit::encodeFrame(bit::Cobs, payload, frame, sizeof(frame));
+
+    ASSERT_EQ(size, 6UL);
+
+    bit::FrameDecoder decoder(bit::Cobs, received);
+
+    ASSERT_EQ(decoder.feed(frame, size), size);
+    ASSERT_TRUE(decoder.isComplete());
+    ASSERT_EQ(decoder.size(), 4UL);
+    ASSERT_EQ(received[1], 0xC0U);
+    ASSERT_EQ(received[3], 0xDBU);
+    ASSERT_EQ(decoder.view().size(), 4UL);
+    ASSERT_EQ(decoder.view()[1], 0xC0U);
+}
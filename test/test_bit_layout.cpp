@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<int16_t, 23, 12> Trim;
+typedef bit::Signal<bool, 27> Brake;
+typedef bit::Signal<float, 39> Torque;
+typedef bit::Signal<uint32_t, 3, 32> Wide;
+
+typedef bit::Layout<8, Speed, Trim, Brake, Torque> Frame;
+}
+
+//------------------------------------------------------------------------------
+class BitLayout : public Test
+{
+public:
+
+    BitLayout();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitLayout::BitLayout()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitLayout::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitLayout, layout)
+{
+    ASSERT_EQ(Frame::COUNT, 4UL);
+    ASSERT_EQ(Frame::END, 8UL);
+
+    ASSERT_FALSE((bit::LayoutOverlap<Speed, Trim, Brake, Torque>::VALUE));
+    ASSERT_TRUE((bit::LayoutOverlap<Speed, Trim, Wide>::VALUE));
+    ASSERT_TRUE((bit::FieldsOverlap<Trim, Wide>::VALUE));
+    ASSERT_FALSE((bit::FieldsOverlap<Speed, Brake>::VALUE));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitLayout, extractInsert)
+{
+    bit::Buffer<8> frame;
+
+    Speed speed;
+    Trim trim;
+    Brake brake;
+    Torque torque;
+
+    speed.write(300U);
+    trim.write(-42);
+    brake.write(true);
+    torque.write(2.5F);
+
+    frame << speed << trim << brake << torque;
+
+    ASSERT_EQ(bit::extract<Speed>(frame), 300U);
+    ASSERT_EQ(bit::extract<Trim>(frame), -42);
+    ASSERT_TRUE(bit::extract<Brake>(frame));
+    ASSERT_EQ(bit::extract<Torque>(frame), 2.5F);
+
+    const uint32_t generation = frame.generation();
+
+    bit::insert<Trim>(frame, 1000);
+    bit::insert<Brake>(frame, false);
+
+    ASSERT_NE(frame.generation(), generation);
+    ASSERT_EQ(bit::Field<Trim>::read(frame.data(), 8UL), 1000);
+    ASSERT_EQ(bit::Field<Speed>::read(frame.data(), 8UL), 300U);
+    ASSERT_FALSE(bit::Field<Brake>::read(frame.data(), 8UL));
+    ASSERT_EQ(bit::Field<Torque>::read(frame.data(), 8UL), 2.5F);
+
+    // Fields near the end of short buffers and spanning 5 bytes
+    bit::Buffer<4> small;
+    bit::Buffer<5> odd;
+
+    bit::insert<Trim>(small, -3);
+    bit::insert<Wide>(odd, 0x89ABCDEFUL);
+
+    ASSERT_EQ(bit::extract<Trim>(small), -3);
+    ASSERT_EQ(bit::Field<Trim>::read(small.data(), 4UL), -3);
+    ASSERT_EQ(bit::extract<Wide>(odd), 0x89ABCDEFUL);
+    ASSERT_EQ(bit::Field<Wide>::read(odd.data(), 5UL), 0x89ABCDEFUL);
+    ASSERT_EQ(small.status(), bit::Buffer<4>::Ok);
+}
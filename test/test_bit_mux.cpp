@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint8_t, 7, 4> Page;
+typedef bit::Signal<uint8_t, 3, 4> Rolling;
+typedef bit::Signal<uint16_t, 15, 16> Voltage;
+typedef bit::Signal<int16_t, 31, 16> Current;
+typedef bit::Signal<uint32_t, 15, 32> Serial;
+
+typedef bit::MuxPlan<Page, 2UL, 4UL> Plan;
+}
+
+//------------------------------------------------------------------------------
+class BitMux : public Test
+{
+public:
+
+    BitMux();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitMux::BitMux()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitMux::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitMux, decode)
+{
+    static Plan plan;
+
+    uint8_t sequence = 0U;
+    uint16_t voltage = 0U;
+    int16_t current = 0;
+    uint32_t serial = 0UL;
+
+    ASSERT_EQ(Plan::VALUE_COUNT, 16UL);
+
+    ASSERT_EQ(plan.addCommon<Rolling>(sequence), Plan::Ok);
+    ASSERT_EQ(plan.add<Voltage>(1UL, voltage), Plan::Ok);
+    ASSERT_EQ(plan.add<Current>(1UL, current), Plan::Ok);
+    ASSERT_EQ(plan.add<Serial>(2UL, serial), Plan::Ok);
+    ASSERT_EQ(plan.alias(3UL, 1UL), Plan::Ok);
+
+    // Out of groups
+    ASSERT_EQ(plan.add<Serial>(4UL, serial), Plan::Overflow);
+    ASSERT_EQ(plan.add<Serial>(16UL, serial), Plan::Overflow);
+    ASSERT_EQ(plan.status(), Plan::Overflow);
+
+    bit::Buffer<6> frame;
+
+    Page page;
+    Rolling counter;
+    Voltage volts;
+    Current amps;
+
+    page.write(3U);
+    counter.write(9U);
+    volts.write(12000U);
+    amps.write(-250);
+
+    frame << page << counter << volts << amps;
+
+    ASSERT_EQ(plan.decode(frame), Plan::Ok);
+    ASSERT_EQ(plan.selector(), 3UL);
+    ASSERT_EQ(sequence, 9U);
+    ASSERT_EQ(voltage, 12000U);
+    ASSERT_EQ(current, -250);
+    ASSERT_EQ(serial, 0UL);
+
+    Serial number;
+
+    page.write(2U);
+    counter.write(10U);
+    number.write(0xCAFEF00DUL);
+
+    frame.clear();
+    frame << page << counter << number;
+
+    ASSERT_EQ(plan.decode(frame), Plan::Ok);
+    ASSERT_EQ(sequence, 10U);
+    ASSERT_EQ(serial, 0xCAFEF00DUL);
+    ASSERT_EQ(voltage, 12000U);
+
+    page.write(7U);
+    counter.write(11U);
+
+    frame.clear();
+    frame << page << counter;
+
+    // Unknown pages still decode the common signals
+    ASSERT_EQ(plan.decode(frame), Plan::UnknownValue);
+    ASSERT_EQ(sequence, 11U);
+
+    bit::BufferView view(frame.data(), 3UL);
+
+    page.write(2U);
+    frame.clear();
+    frame << page;
+
+    ASSERT_EQ(plan.decode(view), Plan::Overflow);
+}
@@ -0,0 +1,302 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<bit::Half, 7> Pressure;
+typedef bit::Signal<bit::BrainFloat, 23> Gain;
+typedef bit::Signal<bit::Fixed<int16_t, 8>, 39, 12> Trim;
+typedef bit::Signal<bit::Q15, 55> Balance;
+
+//------------------------------------------------------------------------------
+uint32_t next(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+//------------------------------------------------------------------------------
+uint32_t floatBits(const float value)
+{
+    uint32_t result;
+
+    (void) std::memcpy(&result, &value, sizeof(result));
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+float bitsFloat(const uint32_t bits)
+{
+    float result;
+
+    (void) std::memcpy(&result, &bits, sizeof(result));
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::vector<float> floats()
+{
+    // Random bit patterns, values around the half range and rounding ties
+    std::vector<float> result;
+
+    uint32_t state = 0x2545F491UL;
+
+    for (std::size_t i = 0UL; i < 4000UL; i++)
+    {
+        result.push_back(bitsFloat(next(state)));
+    }
+
+    for (std::size_t i = 0UL; i < 4000UL; i++)
+    {
+        result.push_back(bitsFloat((next(state) & 0x8FFFFFFFUL) | 0x30000000UL));
+    }
+
+    for (uint32_t i = 0UL; i < 1000UL; i++)
+    {
+        result.push_back(bitsFloat(0x38000000UL + (i << 12)));
+        result.push_back(bitsFloat(0x3F800000UL + (i << 16) + 0x8000UL));
+    }
+
+    result.push_back(65504.0F);
+    result.push_back(65520.0F);
+    result.push_back(bitsFloat(0x7F800000UL));
+    result.push_back(bitsFloat(0x7FC12345UL));
+    result.push_back(-0.0F);
+    result.push_back(1.0e-8F);
+
+    return result;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitNumeric : public Test
+{
+public:
+
+    BitNumeric();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitNumeric::BitNumeric()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitNumeric::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitNumeric, half)
+{
+    ASSERT_EQ(bit::Half(1.0F).bits(), 0x3C00U);
+    ASSERT_EQ(bit::Half(-2.0F).bits(), 0xC000U);
+    ASSERT_EQ(bit::Half(0.1F).bits(), 0x2E66U);
+    ASSERT_EQ(bit::Half(65504.0F).bits(), 0x7BFFU);
+    ASSERT_EQ(bit::Half(65520.0F).bits(), 0x7C00U);
+    ASSERT_EQ(bit::Half(std::ldexp(1.0F, -24)).bits(), 0x0001U);
+    ASSERT_EQ(bit::Half(std::ldexp(1.0F, -26)).bits(), 0x0000U);
+    ASSERT_EQ(bit::Half(-0.0F).bits(), 0x8000U);
+    ASSERT_TRUE(std::isnan(bit::Half::fromBits(0x7E00U).toFloat()));
+    ASSERT_EQ(bit::Half::fromBits(0x0001U).toFloat(), std::ldexp(1.0F, -24));
+    ASSERT_EQ(bit::Half::fromBits(0xFC00U).toFloat(), -INFINITY);
+
+    // Every half, the array conversion against the scalar one
+    std::vector<uint16_t> bits(0x10001UL);
+    std::vector<float> values(bits.size());
+
+    for (std::size_t i = 0UL; i < bits.size(); i++)
+    {
+        bits[i] = static_cast<uint16_t>(i);
+    }
+
+    bit::halfToFloat(bits.data(), bits.size(), values.data());
+
+    for (std::size_t i = 0UL; i < bits.size(); i++)
+    {
+        const float value = bit::halfToFloat(bits[i]);
+
+        if (std::isnan(value))
+        {
+            ASSERT_TRUE(std::isnan(values[i])) << i;
+        }
+        else
+        {
+            ASSERT_EQ(floatBits(values[i]), floatBits(value)) << i;
+            ASSERT_EQ(bit::floatToHalf(value), bits[i]) << i;
+        }
+    }
+
+    const std::vector<float> input = floats();
+
+    std::vector<uint16_t> output(input.size());
+
+    bit::floatToHalf(input.data(), input.size(), output.data());
+
+    for (std::size_t i = 0UL; i < input.size(); i++)
+    {
+        if (std::isnan(input[i]))
+        {
+            ASSERT_EQ(output[i] & 0x7E00U, 0x7E00U) << i;
+        }
+        else
+        {
+            ASSERT_EQ(output[i], bit::floatToHalf(input[i])) << input[i];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitNumeric, brain)
+{
+    ASSERT_EQ(bit::BrainFloat(1.0F).bits(), 0x3F80U);
+    ASSERT_EQ(bit::BrainFloat(bitsFloat(0x3F808000UL)).bits(), 0x3F80U);
+    ASSERT_EQ(bit::BrainFloat(bitsFloat(0x3F818000UL)).bits(), 0x3F82U);
+    ASSERT_EQ(bit::BrainFloat(bitsFloat(0x3F808001UL)).bits(), 0x3F81U);
+    ASSERT_EQ(bit::BrainFloat(bitsFloat(0x7F800001UL)).bits(), 0x7FC0U);
+    ASSERT_EQ(bit::BrainFloat::fromBits(0xC0A0U).toFloat(), -5.0F);
+
+    const std::vector<float> input = floats();
+
+    std::vector<uint16_t> output(input.size());
+    std::vector<float> values(input.size());
+
+    bit::floatToBrain(input.data(), input.size(), output.data());
+    bit::brainToFloat(output.data(), output.size(), values.data());
+
+    for (std::size_t i = 0UL; i < input.size(); i++)
+    {
+        ASSERT_EQ(output[i], bit::floatToBrain(input[i])) << i;
+        ASSERT_EQ(floatBits(values[i]), floatBits(bit::brainToFloat(output[i]))) << i;
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitNumeric, fixed)
+{
+    ASSERT_EQ(bit::Q15(0.5).bits(), 0x4000);
+    ASSERT_EQ(bit::Q15(-1.0).bits(), -32768);
+    ASSERT_EQ(bit::Q15(1.0).bits(), 32767);
+    ASSERT_EQ(bit::Q15(NAN).bits(), 0);
+    ASSERT_EQ(bit::Q15::fromBits(-16384).toFloat(), -0.5F);
+    ASSERT_EQ(bit::Q31(-0.25).toDouble(), -0.25);
+
+    typedef bit::Fixed<uint16_t, 4> Level;
+
+    ASSERT_EQ(Level(2.53125).bits(), 41U);
+    ASSERT_EQ(Level(-3.0).bits(), 0U);
+    ASSERT_EQ(Level::fromBits(41U).toFloat(), 2.5625F);
+
+    uint32_t state = 0x2545F491UL;
+
+    const std::size_t count = 37UL;
+
+    std::vector<int16_t> signed16(count);
+    std::vector<uint16_t> unsigned16(count);
+    std::vector<int32_t> signed32(count);
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        signed16[i] = static_cast<int16_t>(next(state));
+        unsigned16[i] = static_cast<uint16_t>(next(state));
+        signed32[i] = static_cast<int32_t>(next(state));
+    }
+
+    std::vector<float> values(count);
+
+    bit::fixedToFloat(signed16.data(), count, 12UL, values.data());
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        ASSERT_EQ(values[i], (bit::Fixed<int16_t, 12>::fromBits(signed16[i]).toFloat()));
+    }
+
+    bit::fixedToFloat(unsigned16.data(), count, 16UL, values.data());
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        ASSERT_EQ(values[i], (bit::Fixed<uint16_t, 16>::fromBits(unsigned16[i]).toFloat()));
+    }
+
+    bit::fixedToFloat(signed32.data(), count, 31UL, values.data());
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        ASSERT_EQ(values[i], bit::Q31::fromBits(signed32[i]).toFloat());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitNumeric, signal)
+{
+    bit::Buffer<8> frame;
+
+    Pressure pressure;
+    Gain gain;
+    Trim trim;
+    Balance balance;
+
+    pressure.write(bit::Half(-1.5F));
+    gain.write(bit::BrainFloat(3.0F));
+    trim.write(bit::Fixed<int16_t, 8>(-3.5));
+    balance.write(bit::Q15(0.25));
+
+    frame << pressure << gain << trim << balance;
+
+    Pressure pressureCopy;
+    Gain gainCopy;
+    Trim trimCopy;
+    Balance balanceCopy;
+
+    frame >> pressureCopy >> gainCopy >> trimCopy >> balanceCopy;
+
+    bit::Half half;
+    bit::BrainFloat brain;
+    bit::Fixed<int16_t, 8> fixed;
+    bit::Q15 q15;
+
+    pressureCopy.read(half);
+    gainCopy.read(brain);
+    trimCopy.read(fixed);
+    balanceCopy.read(q15);
+
+    ASSERT_EQ(half.toFloat(), -1.5F);
+    ASSERT_EQ(brain.toFloat(), 3.0F);
+    ASSERT_EQ(fixed.toFloat(), -3.5F);
+    ASSERT_EQ(q15.toFloat(), 0.25F);
+
+    uint8_t data[8];
+
+    (void) std::memcpy(data, frame.data(), sizeof(data));
+
+    // The 12-bit trim field holds the low bits of the raw value
+    ASSERT_EQ(bit::extractField(data, 8UL, bit::Field<Trim>::OFFSET, 12UL), 0xC80ULL);
+
+    ASSERT_EQ(bit::Field<Pressure>::read(data, 8UL).toFloat(), -1.5F);
+    ASSERT_EQ(bit::Field<Gain>::read(data, 8UL).toFloat(), 3.0F);
+    ASSERT_EQ(bit::Field<Trim>::read(data, 8UL).toFloat(), -3.5F);
+
+    bit::Field<Trim>::write(data, 8UL, bit::Fixed<int16_t, 8>(7.25));
+
+    ASSERT_EQ(bit::Field<Trim>::read(data, 8UL).toDouble(), 7.25);
+    ASSERT_EQ(bit::Field<Balance>::read(data, 8UL).toFloat(), 0.25F);
+
+    ASSERT_EQ(bit::describe<Pressure>().flags, bit::Float16);
+    ASSERT_EQ(bit::describe<Gain>().flags, bit::BFloat16);
+    ASSERT_EQ(bit::describe<Trim>().flags, bit::Signed);
+    ASSERT_EQ(bit::readValue(bit::describe<Pressure>(), data, 8UL), -1.5);
+}
@@ -0,0 +1,193 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+//------------------------------------------------------------------------------
+uint64_t next(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void checkWidth(const std::size_t bits, uint64_t& state)
+{
+    const std::size_t count = 300UL;
+    const std::size_t size = bit::packedSize(bits, count);
+
+    std::vector<uint8_t> data(size);
+
+    for (std::size_t i = 0UL; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>(next(state));
+    }
+
+    // Unaligned ranges, short and long, up to the last element
+    const std::size_t ranges[][2] = { { 0UL, 300UL }, { 3UL, 5UL }, { 7UL, 150UL }, { 291UL, 9UL } };
+
+    for (std::size_t r = 0UL; r < 4UL; r++)
+    {
+        const std::size_t first = ranges[r][0];
+        const std::size_t length = ranges[r][1];
+
+        std::vector<T> output(length);
+
+        bit::unpackFields(data.data(), size, bits, first, length, output.data());
+
+        for (std::size_t i = 0UL; i < length; i++)
+        {
+            ASSERT_EQ(output[i], bit::extractField(data.data(), size, (first + i) * bits, bits))
+                    << "bits " << bits << " element " << (first + i);
+        }
+
+        // Packing new elements changes the range only
+        std::vector<T> input(length);
+
+        for (std::size_t i = 0UL; i < length; i++)
+        {
+            input[i] = static_cast<T>(next(state));
+        }
+
+        std::vector<uint8_t> expected(data);
+
+        for (std::size_t i = 0UL; i < length; i++)
+        {
+            bit::insertField(expected.data(), size, (first + i) * bits, bits, input[i]);
+        }
+
+        bit::packFields(input.data(), data.data(), bits, first, length);
+
+        ASSERT_TRUE(data == expected) << "bits " << bits << " range " << r;
+    }
+}
+}
+
+//------------------------------------------------------------------------------
+class BitPacked : public Test
+{
+public:
+
+    BitPacked();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitPacked::BitPacked()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitPacked::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitPacked, array)
+{
+    std::vector<uint8_t> storage(bit::PackedArray<12>::storageSize(5UL), 0U);
+
+    bit::PackedArray<12> samples(storage.data(), 5UL);
+
+    ASSERT_EQ(samples.size(), 5UL);
+    ASSERT_EQ(storage.size(), 8UL + bit::PACKED_PADDING);
+
+    samples.set(0UL, 0xABCU);
+    samples.set(1UL, 0x123U);
+    samples.set(3UL, 0xFFFFU);
+    samples.set(1UL, 0x456U);
+
+    ASSERT_EQ(storage[0], 0xABU);
+    ASSERT_EQ(storage[1], 0xC4U);
+    ASSERT_EQ(storage[2], 0x56U);
+    ASSERT_EQ(samples.get(0UL), 0xABCU);
+    ASSERT_EQ(samples.get(1UL), 0x456U);
+    ASSERT_EQ(samples.get(2UL), 0x000U);
+    ASSERT_EQ(samples.get(3UL), 0xFFFU);
+
+    uint16_t values[8] = { 0U };
+
+    // Clamped to the array
+    samples.unpack(1UL, 8UL, values);
+
+    ASSERT_THAT(values, ElementsAre(0x456U, 0x000U, 0xFFFU, 0x000U, 0U, 0U, 0U, 0U));
+
+    const uint16_t input[] = { 0x111U, 0x222U };
+
+    samples.pack(input, 3UL, 2UL);
+
+    ASSERT_EQ(samples.get(2UL), 0x000U);
+    ASSERT_EQ(samples.get(3UL), 0x111U);
+    ASSERT_EQ(samples.get(4UL), 0x222U);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitPacked, types)
+{
+    ASSERT_EQ(sizeof(bit::PackedArray<8>::Type), 1UL);
+    ASSERT_EQ(sizeof(bit::PackedArray<10>::Type), 2UL);
+    ASSERT_EQ(sizeof(bit::PackedArray<25>::Type), 4UL);
+    ASSERT_EQ(sizeof(bit::PackedArray<57>::Type), 8UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitPacked, widths)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (std::size_t bits = 1UL; bits <= 8UL; bits++)
+    {
+        checkWidth<uint8_t>(bits, state);
+    }
+
+    for (std::size_t bits = 1UL; bits <= 16UL; bits++)
+    {
+        checkWidth<uint16_t>(bits, state);
+    }
+
+    for (std::size_t bits = 1UL; bits <= 32UL; bits++)
+    {
+        checkWidth<uint32_t>(bits, state);
+    }
+
+    for (std::size_t bits = 1UL; bits <= bit::PACKED_MAX_BITS; bits++)
+    {
+        checkWidth<uint64_t>(bits, state);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitPacked, signal)
+{
+    // Element i is the signal at the field offset i * Bits
+    typedef bit::Signal<uint16_t, 27, 14> Sample;
+
+    bit::Buffer<16> frame;
+
+    Sample sample;
+
+    sample.write(0x2ABCU);
+
+    frame << sample;
+
+    const uint8_t* bytes = static_cast<const bit::Buffer<16>&>(frame).data();
+
+    std::vector<uint8_t> storage(bytes, bytes + 16);
+
+    storage.resize(bit::PackedArray<14>::storageSize(9UL));
+
+    bit::PackedArray<14> samples(storage.data(), 9UL);
+
+    ASSERT_EQ(bit::Field<Sample>::OFFSET % 14UL, 0UL);
+    ASSERT_EQ(samples.get(bit::Field<Sample>::OFFSET / 14UL), 0x2ABCU);
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<bool, 20> Brake;
+typedef bit::Signal<uint8_t, 19, 4> Gear;
+typedef bit::Signal<uint32_t, 59, 24> Odometer;
+typedef bit::Signal<int16_t, 103, 12> Trim;
+typedef bit::Signal<float, 151> Temperature;
+}
+
+//------------------------------------------------------------------------------
+class BitPlan : public Test
+{
+public:
+
+    BitPlan();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitPlan::BitPlan()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitPlan::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitPlan, decode)
+{
+    bit::Buffer<22> frame;
+
+    Speed speed;
+    Brake brake;
+    Gear gear;
+    Odometer odometer;
+    Trim trim;
+    Temperature temperature;
+
+    speed.write(1234U);
+    brake.write(true);
+    gear.write(5U);
+    odometer.write(0x00ABCDEFUL);
+    trim.write(-3);
+    temperature.write(21.5F);
+
+    frame << speed << brake << gear << odometer << trim << temperature;
+
+    bit::DecodePlan<4> plan;
+
+    float temperatureValue = 0.0F;
+    int16_t trimValue = 0;
+    bool brakeValue = false;
+    uint32_t odometerValue = 0UL;
+    uint16_t speedValue = 0U;
+
+    // Registered out of order, the plan keeps buffer order
+    ASSERT_EQ(plan.add<Temperature>(temperatureValue), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(plan.add<Trim>(trimValue), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(plan.add<Brake>(brakeValue), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(plan.add<Odometer>(odometerValue), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(plan.add<Speed>(speedValue), bit::DecodePlan<4>::Overflow);
+    ASSERT_EQ(plan.status(), bit::DecodePlan<4>::Overflow);
+    ASSERT_EQ(plan.count(), 4UL);
+    ASSERT_EQ(plan.size(), 22UL);
+
+    ASSERT_EQ(plan.decode(frame), bit::DecodePlan<4>::Ok);
+
+    ASSERT_EQ(temperatureValue, 21.5F);
+    ASSERT_EQ(trimValue, -3);
+    ASSERT_TRUE(brakeValue);
+    ASSERT_EQ(odometerValue, 0x00ABCDEFUL);
+    ASSERT_EQ(speedValue, 0U);
+
+    // A short frame decodes the missing bits as zero
+    bit::BufferView view(frame.data(), 18UL);
+
+    ASSERT_EQ(plan.decode(view), bit::DecodePlan<4>::Overflow);
+    ASSERT_EQ(odometerValue, 0x00ABCDEFUL);
+    ASSERT_EQ(temperatureValue, 0.0F);
+
+    plan.clear();
+
+    ASSERT_EQ(plan.status(), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(plan.add<Speed>(speedValue), bit::DecodePlan<4>::Ok);
+
+    ASSERT_EQ(plan.decode(view), bit::DecodePlan<4>::Ok);
+    ASSERT_EQ(speedValue, 1234U);
+}
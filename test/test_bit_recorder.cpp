@@ -0,0 +1,280 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+
+//------------------------------------------------------------------------------
+std::vector<bit::RecorderEvent> eventsOf(const uint32_t frame)
+{
+    static bit::RecorderEvent events[bit::RECORDER_EVENTS];
+
+    std::vector<bit::RecorderEvent> result;
+
+    for (std::size_t thread = 0UL; thread < bit::Recorder::threads(); thread++)
+    {
+        const std::size_t count = bit::Recorder::collect(thread, events);
+
+        for (std::size_t i = 0UL; i < count; i++)
+        {
+            if (events[i].frame == frame)
+            {
+                result.push_back(events[i]);
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void recordFrames(const uint32_t frame)
+{
+    for (std::size_t i = 0UL; i < 100UL; i++)
+    {
+        bit::Recorder::record(bit::UserEvent, frame, i, 10ULL, 0UL);
+    }
+}
+
+//------------------------------------------------------------------------------
+void recordTogether(const uint32_t frame, std::atomic<std::size_t>* started,
+                    const std::size_t count)
+{
+    (void) started->fetch_add(1UL);
+
+    // Every thread is alive while recording, the extra ones share a ring
+    while (started->load() < count)
+    {
+        std::this_thread::yield();
+    }
+
+    for (std::size_t i = 0UL; i < 20UL; i++)
+    {
+        bit::Recorder::record(bit::UserEvent, frame, frame, frame, 0UL);
+
+        std::this_thread::yield();
+    }
+}
+}
+
+//------------------------------------------------------------------------------
+class BitRecorder : public Test
+{
+public:
+
+    BitRecorder();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitRecorder::BitRecorder()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitRecorder::SetUp()
+{
+    bit::Recorder::reset();
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, record)
+{
+    bit::Recorder::record(bit::FrameDecode, 7ULL, 12UL, 0x123456789ULL, 1UL);
+
+    const std::vector<bit::RecorderEvent> events = eventsOf(7U);
+
+    ASSERT_EQ(events.size(), 1UL);
+    ASSERT_EQ(events[0].signal, 12U);
+    ASSERT_EQ(events[0].operation, bit::FrameDecode);
+    ASSERT_EQ(events[0].status, 1U);
+    ASSERT_EQ(events[0].duration, 0xFFFFFFFFU);
+    ASSERT_GT(events[0].timestamp, 0ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, wrap)
+{
+    for (std::size_t i = 0UL; i < (bit::RECORDER_EVENTS + 500UL); i++)
+    {
+        bit::Recorder::record(bit::UserEvent, 9ULL, i, 1ULL, 0UL);
+    }
+
+    const std::vector<bit::RecorderEvent> events = eventsOf(9U);
+
+    // A full ring keeps the last RECORDER_EVENTS events
+    ASSERT_EQ(events.size(), bit::RECORDER_EVENTS);
+    ASSERT_EQ(events.front().signal, 500U);
+    ASSERT_EQ(events.back().signal, bit::RECORDER_EVENTS + 499UL);
+
+    bit::Recorder::reset();
+
+    ASSERT_EQ(eventsOf(9U).size(), 0UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, threads)
+{
+    std::vector<std::thread> pool;
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        pool.push_back(std::thread(recordFrames, 100U + i));
+    }
+
+    for (std::size_t i = 0UL; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        const std::vector<bit::RecorderEvent> events = eventsOf(100U + i);
+
+        ASSERT_EQ(events.size(), 100UL);
+        ASSERT_EQ(events[99].signal, 99U);
+
+        for (std::size_t j = 1UL; j < events.size(); j++)
+        {
+            ASSERT_EQ(events[j].thread, events[0].thread);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, recycle)
+{
+    for (uint32_t i = 0U; i < (2U * bit::RECORDER_MAX_THREADS); i++)
+    {
+        std::thread thread(recordFrames, 200U + i);
+
+        thread.join();
+    }
+
+    // Every thread reused the ring of the previous one, none is shared
+    ASSERT_LT(bit::Recorder::threads(), bit::RECORDER_MAX_THREADS);
+    ASSERT_EQ(eventsOf(200U + (2U * bit::RECORDER_MAX_THREADS) - 1U).size(), 100UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, shared)
+{
+    const std::size_t count = bit::RECORDER_MAX_THREADS + 8UL;
+
+    std::atomic<std::size_t> started(0UL);
+
+    std::vector<std::thread> pool;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        pool.push_back(std::thread(recordTogether, 300U + i, &started, count));
+    }
+
+    for (std::size_t i = 0UL; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const std::vector<bit::RecorderEvent> events = eventsOf(300U + i);
+
+        ASSERT_EQ(events.size(), 20UL);
+
+        for (std::size_t j = 0UL; j < events.size(); j++)
+        {
+            ASSERT_EQ(events[j].signal, 300U + i);
+            ASSERT_EQ(events[j].duration, 300U + i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, dump)
+{
+    bit::Recorder::record(bit::FrameWrite, 3ULL, 0UL, 5ULL, 0UL);
+    bit::Recorder::record(bit::FrameWrite, 4ULL, 0UL, 5ULL, 0UL);
+
+    char path[] = "/tmp/test_bit_recorder_XXXXXX";
+
+    const int file = mkstemp(path);
+
+    ASSERT_GE(file, 0);
+
+    ASSERT_EQ(bit::Recorder::dump(path), bit::Recorder::Ok);
+
+    std::FILE* input = std::fopen(path, "rb");
+
+    ASSERT_NE(input, static_cast<std::FILE*>(0));
+
+    bit::RecorderHeader header;
+    bit::RecorderEvent event;
+
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1U, input), 1U);
+    ASSERT_EQ(header.magic, bit::RECORDER_MAGIC);
+    ASSERT_EQ(header.version, bit::RECORDER_VERSION);
+    ASSERT_EQ(header.eventSize, sizeof(bit::RecorderEvent));
+    ASSERT_EQ(header.eventCount, 2ULL);
+    ASSERT_EQ(std::fread(&event, sizeof(event), 1U, input), 1U);
+    ASSERT_EQ(event.frame, 3U);
+    ASSERT_EQ(event.operation, bit::FrameWrite);
+
+    (void) std::fclose(input);
+    (void) close(file);
+    (void) std::remove(path);
+
+    ASSERT_EQ(bit::Recorder::dump("/nonexistent/recorder.bin"), bit::Recorder::OpenError);
+}
+
+#if defined(BIT_INSTRUMENTATION)
+
+//------------------------------------------------------------------------------
+TEST_F(BitRecorder, instrumentation)
+{
+    bit::Buffer<3> frame;
+
+    Speed speed;
+
+    speed.write(100U);
+
+    bit::Recorder::setFrame(42ULL);
+
+    frame << speed;
+    frame >> speed;
+
+    const std::vector<bit::RecorderEvent> events = eventsOf(42U);
+
+    ASSERT_EQ(events.size(), 2UL);
+    ASSERT_EQ(events[0].operation, bit::SignalEncode);
+    ASSERT_EQ(events[0].signal, bit::Field<Speed>::OFFSET);
+    ASSERT_EQ(events[1].operation, bit::SignalDecode);
+
+    // Views record their decodes, and the out of bounds byte
+    bit::BufferView view(frame.data(), 1UL);
+
+    view >> speed;
+
+    const std::vector<bit::RecorderEvent> more = eventsOf(42U);
+
+    ASSERT_EQ(more.size(), 4UL);
+    ASSERT_EQ(more[2].operation, bit::BufferOverflow);
+    ASSERT_EQ(more[2].signal, 1U);
+    ASSERT_EQ(more[3].operation, bit::SignalDecode);
+    ASSERT_EQ(more[3].status, 1U);
+
+    bit::Recorder::setFrame(0ULL);
+}
+
+#endif
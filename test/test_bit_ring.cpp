@@ -0,0 +1,307 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint32_t, 7, 32> Sequence;
+typedef bit::Signal<uint8_t, 39, 8> Producer;
+
+const std::size_t FRAME_COUNT = 100000UL;
+const std::size_t PRODUCER_COUNT = 3UL;
+
+//------------------------------------------------------------------------------
+template <typename Ring>
+void produce(Ring& ring, const uint8_t producer, const std::size_t count)
+{
+    std::size_t i = 0UL;
+
+    while (i < count)
+    {
+        bit::Buffer<8>* frame = ring.reserve();
+
+        if (frame != 0)
+        {
+            Sequence sequence;
+            Producer id;
+
+            sequence.write(static_cast<uint32_t>(i));
+            id.write(producer);
+
+            *frame << sequence << id;
+
+            ring.commit(frame);
+
+            i++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename Ring>
+void consume(Ring& ring, const std::size_t producers, const std::size_t count)
+{
+    std::vector<uint32_t> next(producers, 0UL);
+
+    std::size_t total = 0UL;
+
+    while (total < (producers * count))
+    {
+        bit::Buffer<8>* frames[32];
+
+        const std::size_t n = ring.front(frames, 32UL);
+
+        for (std::size_t i = 0UL; i < n; i++)
+        {
+            bit::BufferView view(*frames[i]);
+
+            const uint8_t producer = view.read<Producer>();
+
+            ASSERT_LT(producer, producers);
+            ASSERT_EQ(view.read<Sequence>(), next[producer]);
+
+            next[producer]++;
+        }
+
+        ring.release(n);
+
+        total += n;
+
+        if (0UL == n)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+}
+
+//------------------------------------------------------------------------------
+class BitRing : public Test
+{
+public:
+
+    BitRing();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitRing::BitRing()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitRing::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, fullEmpty)
+{
+    static bit::SpscRing<8, 4> spsc;
+    static bit::MpscRing<8, 4> mpsc;
+
+    bit::Buffer<8> frames[6];
+
+    for (std::size_t i = 0UL; i < 6UL; i++)
+    {
+        frames[i][0] = static_cast<uint8_t>(i);
+    }
+
+    for (std::size_t lap = 0UL; lap < 3UL; lap++)
+    {
+        ASSERT_EQ(spsc.push(frames, 6UL), 4UL);
+        ASSERT_EQ(mpsc.push(frames, 6UL), 4UL);
+        ASSERT_FALSE(spsc.push(frames[0]));
+        ASSERT_TRUE(mpsc.reserve() == 0);
+        ASSERT_EQ(spsc.size(), 4UL);
+        ASSERT_EQ(mpsc.size(), 4UL);
+
+        bit::Buffer<8> out[6];
+
+        ASSERT_EQ(spsc.pop(out, 3UL), 3UL);
+        ASSERT_EQ(out[2][0], 2U);
+        ASSERT_EQ(mpsc.pop(out, 6UL), 4UL);
+        ASSERT_EQ(out[3][0], 3U);
+        ASSERT_TRUE(spsc.pop(out[0]));
+        ASSERT_EQ(out[0][0], 3U);
+        ASSERT_FALSE(spsc.pop(out[0]));
+        ASSERT_TRUE(mpsc.front() == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, inPlaceBatch)
+{
+    static bit::MpscRing<8, 8> ring;
+
+    bit::Buffer<8>* slots[8];
+
+    ASSERT_EQ(ring.reserve(slots, 3UL), 3UL);
+
+    slots[0]->data()[0] = 10U;
+    slots[2]->data()[0] = 12U;
+
+    // The second slot is not published yet, nothing can be consumed past it
+    ring.commit(&slots[2], 1UL);
+    ring.commit(slots[0]);
+
+    bit::Buffer<8>* frames[8];
+
+    ASSERT_EQ(ring.front(frames, 8UL), 1UL);
+    ASSERT_EQ(frames[0]->data()[0], 10U);
+
+    ring.commit(slots[1]);
+
+    ASSERT_EQ(ring.front(frames, 8UL), 3UL);
+    ASSERT_EQ(frames[2]->data()[0], 12U);
+
+    ring.release(3UL);
+
+    ASSERT_EQ(ring.size(), 0UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, spscThreads)
+{
+    static bit::SpscRing<8, 256> ring;
+
+    std::thread producer(produce<bit::SpscRing<8, 256> >, std::ref(ring),
+                         static_cast<uint8_t>(0U), FRAME_COUNT);
+
+    consume(ring, 1UL, FRAME_COUNT);
+
+    producer.join();
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, mpscThreads)
+{
+    static bit::MpscRing<8, 256> ring;
+
+    std::vector<std::thread> producers;
+
+    for (std::size_t i = 0UL; i < PRODUCER_COUNT; i++)
+    {
+        producers.push_back(std::thread(produce<bit::MpscRing<8, 256> >,
+                                        std::ref(ring),
+                                        static_cast<uint8_t>(i),
+                                        FRAME_COUNT));
+    }
+
+    consume(ring, PRODUCER_COUNT, FRAME_COUNT);
+
+    for (std::size_t i = 0UL; i < PRODUCER_COUNT; i++)
+    {
+        producers[i].join();
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, pushWhileReserved)
+{
+    static bit::SpscRing<8, 4> ring;
+
+    bit::Buffer<8> frame;
+
+    frame[0] = 7U;
+
+    bit::Buffer<8>* slot = ring.reserve();
+
+    slot->data()[0] = 1U;
+
+    // Pushing would publish the reserved slot in place of the pushed frame
+    ASSERT_FALSE(ring.push(frame));
+    ASSERT_EQ(ring.size(), 0UL);
+
+    ring.commit(slot);
+
+    ASSERT_TRUE(ring.push(frame));
+
+    bit::Buffer<8> out[2];
+
+    ASSERT_EQ(ring.pop(out, 2UL), 2UL);
+    ASSERT_EQ(out[0][0], 1U);
+    ASSERT_EQ(out[1][0], 7U);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitRing, mpscStaleTail)
+{
+    // Every producer waits for its frame to be consumed before the next
+    // one, the ring never holds more than PRODUCER_COUNT frames and a
+    // reserve() shall never find it full, even with a tail read before the
+    // other producers and the consumer moved past it
+    static bit::MpscRing<8, 4> ring;
+
+    static std::atomic<std::size_t> consumed[PRODUCER_COUNT];
+    static std::atomic<std::size_t> failures(0UL);
+
+    const std::size_t count = 20000UL;
+
+    std::vector<std::thread> producers;
+
+    for (std::size_t p = 0UL; p < PRODUCER_COUNT; p++)
+    {
+        consumed[p].store(0UL);
+
+        producers.push_back(std::thread([p, count]()
+        {
+            for (std::size_t i = 0UL; i < count; i++)
+            {
+                bit::Buffer<8>* frame = ring.reserve();
+
+                while (0 == frame)
+                {
+                    failures.fetch_add(1UL);
+
+                    frame = ring.reserve();
+                }
+
+                frame->data()[0] = static_cast<uint8_t>(p);
+
+                ring.commit(frame);
+
+                while (consumed[p].load() <= i)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    std::size_t total = 0UL;
+
+    while (total < (PRODUCER_COUNT * count))
+    {
+        bit::Buffer<8> frame;
+
+        if (ring.pop(frame))
+        {
+            consumed[frame[0]].fetch_add(1UL);
+
+            total++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::size_t p = 0UL; p < PRODUCER_COUNT; p++)
+    {
+        producers[p].join();
+    }
+
+    ASSERT_EQ(failures.load(), 0UL);
+}
@@ -0,0 +1,187 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+#include <bit_scheduler.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint32_t, 7, 32> Counter;
+
+const std::size_t WORKER_COUNT = 3UL;
+const std::size_t CHANNEL_COUNT = 4UL;
+
+//------------------------------------------------------------------------------
+struct Plan
+{
+    Plan()
+        : sum(0ULL)
+        , frames(0ULL)
+        , workers(WORKER_COUNT)
+    {
+        for (std::size_t i = 0UL; i < WORKER_COUNT; i++)
+        {
+            workers[i] = 0ULL;
+        }
+    }
+
+    void operator()(const std::size_t worker, bit::BufferView& frame)
+    {
+        Counter value;
+
+        uint32_t data;
+
+        frame >> value;
+
+        value.read(data);
+
+        (void) sum.fetch_add(data);
+        (void) frames.fetch_add(1ULL);
+
+        workers[worker]++;
+    }
+
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> frames;
+    std::vector<uint64_t> workers;
+};
+}
+
+//------------------------------------------------------------------------------
+class BitScheduler : public Test
+{
+public:
+
+    BitScheduler();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitScheduler::BitScheduler()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitScheduler::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitScheduler, unevenChannels)
+{
+    bit::Scheduler scheduler(WORKER_COUNT, 4UL, 16UL, 256UL);
+
+    Plan plans[CHANNEL_COUNT];
+
+    for (std::size_t i = 0UL; i < CHANNEL_COUNT; i++)
+    {
+        ASSERT_EQ(scheduler.addChannel(plans[i]), i);
+    }
+
+    scheduler.start();
+
+    std::vector<uint64_t> expected(CHANNEL_COUNT, 0ULL);
+    std::vector<uint64_t> counts(CHANNEL_COUNT, 0ULL);
+
+    for (uint32_t i = 0UL; i < 20000UL; i++)
+    {
+        // Channel 0 is hot, the others are submitted at decreasing rates
+        for (std::size_t c = 0UL; c < CHANNEL_COUNT; c++)
+        {
+            if ((i % (1UL << (3UL * c))) == 0UL)
+            {
+                bit::Buffer<4> frame;
+
+                Counter value;
+
+                value.write(i);
+
+                frame << value;
+
+                while (scheduler.submit(c, frame) != bit::Scheduler::Ok)
+                {
+                    std::this_thread::yield();
+                }
+
+                expected[c] += i;
+                counts[c]++;
+            }
+        }
+    }
+
+    scheduler.wait();
+
+    for (std::size_t c = 0UL; c < CHANNEL_COUNT; c++)
+    {
+        const bit::Scheduler::ChannelStatistics statistics =
+                scheduler.statistics(c);
+
+        ASSERT_EQ(plans[c].sum.load(), expected[c]);
+        ASSERT_EQ(plans[c].frames.load(), counts[c]);
+        ASSERT_EQ(statistics.depth, 0UL);
+        ASSERT_EQ(statistics.decoded, counts[c]);
+        ASSERT_EQ(statistics.submitted, counts[c]);
+        ASSERT_GE(statistics.latencyMax, statistics.latencyMean);
+    }
+
+    scheduler.stop();
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitScheduler, invalidChannel)
+{
+    bit::Scheduler scheduler(1UL, 4UL);
+
+    bit::Buffer<4> frame;
+    bit::Buffer<8> large;
+
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::InvalidChannel);
+
+    Plan plan;
+
+    ASSERT_EQ(scheduler.addChannel(plan), 0UL);
+
+    scheduler.start();
+
+    ASSERT_EQ(scheduler.submit(0UL, large), bit::Scheduler::Full);
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::Ok);
+    ASSERT_EQ(scheduler.depth(0UL), 1UL);
+
+    scheduler.wait();
+
+    ASSERT_EQ(scheduler.depth(0UL), 0UL);
+    ASSERT_EQ(plan.frames.load(), 1ULL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitScheduler, stopped)
+{
+    bit::Scheduler scheduler(2UL, 4UL, 8UL);
+
+    bit::Buffer<4> frame;
+
+    Plan plan;
+
+    ASSERT_EQ(scheduler.addChannel(plan), 0UL);
+
+    // Not started, nothing is queued
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::Stopped);
+    ASSERT_EQ(scheduler.depth(0UL), 0UL);
+
+    scheduler.start();
+
+    // The open batch is decoded by stop()
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::Ok);
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::Ok);
+
+    scheduler.stop();
+
+    ASSERT_EQ(scheduler.depth(0UL), 0UL);
+    ASSERT_EQ(plan.frames.load(), 2ULL);
+    ASSERT_EQ(scheduler.submit(0UL, frame), bit::Scheduler::Stopped);
+}
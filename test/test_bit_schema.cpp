@@ -0,0 +1,205 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <string>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint16_t, 7, 16> Speed;
+typedef bit::Signal<int16_t, 23, 12> Trim;
+typedef bit::Signal<bool, 27> Brake;
+typedef bit::Signal<float, 39> Torque;
+
+const char* const DESCRIPTION =
+    "# name   position  width  type      order     scale  offset\n"
+    "speed    7         16     unsigned  motorola  0.5    -10\n"
+    "trim     23        12     signed\n"
+    "\n"
+    "brake    27        1      bool      # no order\n"
+    "torque   39        32     float     motorola\n";
+}
+
+//------------------------------------------------------------------------------
+class BitSchema : public Test
+{
+public:
+
+    BitSchema();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitSchema::BitSchema()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitSchema::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSchema, load)
+{
+    static bit::Schema schema;
+
+    std::size_t line = 0UL;
+
+    ASSERT_EQ(schema.load(DESCRIPTION, line), bit::Schema::Ok);
+    ASSERT_EQ(line, 0UL);
+    ASSERT_EQ(schema.count(), 4UL);
+    ASSERT_EQ(schema.find("trim"), 1UL);
+    ASSERT_EQ(schema.find("gear"), 4UL);
+    ASSERT_EQ(schema.signal(0UL).scale, 0.5);
+    ASSERT_EQ(schema.signal(0UL).offset, -10.0);
+    ASSERT_EQ(schema.signal(2UL).type, bit::Boolean);
+    ASSERT_EQ(schema.signal(3UL).width, 32U);
+
+    schema.clear();
+
+    ASSERT_EQ(schema.load("a 0 8 unsigned\nb 8 x unsigned\n", line),
+              bit::Schema::SyntaxError);
+    ASSERT_EQ(line, 2UL);
+
+    ASSERT_EQ(schema.load("\n\nc 0 8 unsigned big\n", line), bit::Schema::SyntaxError);
+    ASSERT_EQ(line, 3UL);
+
+    ASSERT_EQ(schema.load("d 0 16 bool\n", line), bit::Schema::RangeError);
+    ASSERT_EQ(line, 1UL);
+
+    ASSERT_EQ(schema.load("e 0 65 unsigned", line), bit::Schema::RangeError);
+    ASSERT_EQ(schema.count(), 1UL);
+
+    // Tokens longer than a line are rejected, not copied
+    const std::string digits(300UL, '1');
+
+    ASSERT_EQ(schema.load(("f " + digits + " 8 unsigned\n").c_str(), line),
+              bit::Schema::SyntaxError);
+    ASSERT_EQ(line, 1UL);
+
+    ASSERT_EQ(schema.load(("g 8 8 unsigned intel " + digits + "\n").c_str(), line),
+              bit::Schema::SyntaxError);
+    ASSERT_EQ(schema.count(), 1UL);
+
+    ASSERT_EQ(schema.loadFile("/nonexistent/schema.txt", line), bit::Schema::OpenError);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSchema, motorola)
+{
+    static bit::Schema schema;
+    static bit::DecodeTable table;
+
+    std::size_t line = 0UL;
+
+    ASSERT_EQ(schema.load(DESCRIPTION, line), bit::Schema::Ok);
+
+    table.compile(schema);
+
+    ASSERT_EQ(table.count(), 4UL);
+    ASSERT_EQ(table.size(), 8UL);
+
+    bit::Buffer<8> frame;
+
+    Speed speed;
+    Trim trim;
+    Brake brake;
+    Torque torque;
+
+    speed.write(300U);
+    trim.write(-42);
+    brake.write(true);
+    torque.write(2.5F);
+
+    frame << speed << trim << brake << torque;
+
+    uint64_t raw[4];
+    double values[4];
+
+    ASSERT_EQ(table.decodeRaw(frame.data(), 8UL, raw), bit::DecodeTable::Ok);
+    ASSERT_EQ(raw[0], 300ULL);
+    ASSERT_EQ(static_cast<int64_t>(raw[1]), -42LL);
+    ASSERT_EQ(raw[2], 1ULL);
+
+    ASSERT_EQ(table.decode(frame.data(), 8UL, values), bit::DecodeTable::Ok);
+    ASSERT_EQ(values[0], 140.0);
+    ASSERT_EQ(values[1], -42.0);
+    ASSERT_EQ(values[2], 1.0);
+    ASSERT_EQ(values[3], 2.5);
+
+    ASSERT_EQ(table.value(1UL, frame.data(), 8UL), -42.0);
+
+    // Short frames decode the missing bits as zero
+    ASSERT_EQ(table.decode(frame.data(), 4UL, values), bit::DecodeTable::Overflow);
+    ASSERT_EQ(values[0], 140.0);
+    ASSERT_EQ(values[3], 0.0);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSchema, intel)
+{
+    static bit::Schema schema;
+    static bit::DecodeTable table;
+
+    std::size_t line = 0UL;
+
+    ASSERT_EQ(schema.load("counter 0 8 unsigned intel\n"
+                          "trim 12 12 signed intel 0.25\n"
+                          "wide 4 64 unsigned intel\n"
+                          "tail 60 64 unsigned motorola\n", line), bit::Schema::Ok);
+
+    table.compile(schema);
+
+    ASSERT_EQ(table.size(), 16UL);
+
+    const uint8_t data[16] = {0x34U, 0xB2U, 0xFFU, 0x00U, 0x00U, 0x00U, 0x00U, 0xA0U,
+                              0x0BU, 0x12U, 0x34U, 0x56U, 0x78U, 0x9AU, 0xBCU, 0xDEU};
+
+    uint64_t raw[4];
+
+    ASSERT_EQ(table.decodeRaw(data, sizeof(data), raw), bit::DecodeTable::Ok);
+    ASSERT_EQ(raw[0], 0x34ULL);
+    ASSERT_EQ(static_cast<int64_t>(raw[1]), -5LL);
+    ASSERT_EQ(raw[2], 0xBA000000000FFB23ULL);
+    ASSERT_EQ(raw[3], 0x005891A2B3C4D5E6ULL);
+
+    ASSERT_EQ(table.value(1UL, data, sizeof(data)), -1.25);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSchema, half)
+{
+    static bit::Schema schema;
+    static bit::DecodeTable table;
+
+    std::size_t line = 0UL;
+
+    ASSERT_EQ(schema.load("pressure 7 16 half\n"
+                          "gain 23 16 bfloat16 motorola 2\n", line), bit::Schema::Ok);
+    ASSERT_EQ(schema.signal(0UL).type, bit::Float16);
+    ASSERT_EQ(schema.signal(1UL).type, bit::BFloat16);
+
+    ASSERT_EQ(schema.load("width 0 8 half\n", line), bit::Schema::RangeError);
+
+    table.compile(schema);
+
+    bit::Buffer<4> frame;
+
+    bit::Signal<bit::Half, 7> pressure;
+    bit::Signal<bit::BrainFloat, 23> gain;
+
+    pressure.write(bit::Half(-1.5F));
+    gain.write(bit::BrainFloat(0.75F));
+
+    frame << pressure << gain;
+
+    double values[2];
+
+    ASSERT_EQ(table.decode(frame.data(), 4UL, values), bit::DecodeTable::Ok);
+    ASSERT_EQ(values[0], -1.5);
+    ASSERT_EQ(values[1], 1.5);
+}
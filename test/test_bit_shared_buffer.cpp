@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint32_t, 7, 32> Counter;
+typedef bit::Signal<uint32_t, 39, 32> Mirror;
+typedef bit::Signal<int16_t, 67, 12> Offset;
+typedef bit::Signal<uint32_t, 99, 32> Straddle;
+
+const uint32_t WRITE_COUNT = 200000U;
+const std::size_t READER_COUNT = 3UL;
+}
+
+//------------------------------------------------------------------------------
+class BitSharedBuffer : public Test
+{
+public:
+
+    BitSharedBuffer();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitSharedBuffer::BitSharedBuffer()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitSharedBuffer::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSharedBuffer, writeRead)
+{
+    static bit::SharedBuffer<20> shared;
+
+    ASSERT_EQ(shared.version(), 0U);
+    ASSERT_EQ(shared.read<Counter>(), 0U);
+
+    shared.write<Counter>(0x12345678U);
+    shared.write<Offset>(-5);
+    shared.write<Straddle>(0xCAFEBABEU);
+
+    ASSERT_EQ(shared.version(), 3U);
+    ASSERT_EQ(shared.read<Counter>(), 0x12345678U);
+    ASSERT_EQ(shared.read<Offset>(), -5);
+    ASSERT_EQ(shared.read<Straddle>(), 0xCAFEBABEU);
+
+    // The snapshot matches the layout produced by the Buffer operators
+    bit::Buffer<20> frame;
+    bit::Buffer<20> expected;
+
+    Counter counter;
+    Offset offset;
+    Straddle straddle;
+
+    counter.write(0x12345678U);
+    offset.write(-5);
+    straddle.write(0xCAFEBABEU);
+
+    expected << counter << offset << straddle;
+
+    shared.snapshot(frame);
+
+    for (std::size_t i = 0UL; i < 20UL; i++)
+    {
+        ASSERT_EQ(frame[i], expected[i]);
+    }
+
+    // Frames updated in place are visible after publish() only
+    shared.frame().clear();
+
+    ASSERT_EQ(shared.read<Counter>(), 0x12345678U);
+
+    shared.publish();
+
+    ASSERT_EQ(shared.read<Straddle>(), 0U);
+
+    shared.write(expected);
+
+    ASSERT_EQ(shared.read<Offset>(), -5);
+    ASSERT_EQ(shared.version(), 5U);
+
+    // A signal write publishes the words of the signal only
+    shared.frame()[0] = 0xFFU;
+    shared.write<Straddle>(0x01020304U);
+
+    ASSERT_EQ(shared.read<Counter>(), 0x12345678U);
+    ASSERT_EQ(shared.read<Straddle>(), 0x01020304U);
+
+    shared.snapshot(frame);
+
+    ASSERT_EQ(frame[0], 0x12U);
+    ASSERT_EQ(frame[19], 0U);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitSharedBuffer, consistentReaders)
+{
+    static bit::SharedBuffer<16> shared;
+
+    std::atomic<bool> isDone(false);
+
+    std::vector<std::thread> readers;
+
+    for (std::size_t i = 0UL; i < READER_COUNT; i++)
+    {
+        readers.push_back(std::thread([&]()
+        {
+            uint32_t last = 0U;
+
+            while (!isDone.load())
+            {
+                bit::Buffer<16> frame;
+
+                shared.snapshot(frame);
+
+                bit::BufferView view(frame);
+
+                const uint32_t counter = view.read<Counter>();
+
+                ASSERT_EQ(counter, view.read<Mirror>());
+                ASSERT_GE(counter, last);
+
+                last = counter;
+            }
+        }));
+    }
+
+    for (uint32_t i = 1U; i <= WRITE_COUNT; i++)
+    {
+        Counter counter;
+        Mirror mirror;
+
+        counter.write(i);
+        mirror.write(i);
+
+        shared.frame().clear();
+        shared.frame() << counter << mirror;
+        shared.publish();
+    }
+
+    isDone.store(true);
+
+    for (std::size_t i = 0UL; i < READER_COUNT; i++)
+    {
+        readers[i].join();
+    }
+
+    ASSERT_EQ(shared.read<Counter>(), WRITE_COUNT);
+    ASSERT_EQ(shared.version(), WRITE_COUNT);
+}
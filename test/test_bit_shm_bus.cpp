@@ -0,0 +1,267 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+#include <bit_shm_bus.h>
+
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<uint32_t, 7, 32> Counter;
+typedef bit::Signal<uint32_t, 39, 32> Mirror;
+typedef bit::Signal<uint8_t, 75, 5> Mode;
+
+const std::size_t FRAME_SIZE = 10UL;
+const std::size_t SLOT_COUNT = 4UL;
+const uint32_t PUBLISH_COUNT = 100000U;
+
+//------------------------------------------------------------------------------
+void makeFrame(bit::Buffer<FRAME_SIZE>& frame, const uint32_t value)
+{
+    Counter counter;
+    Mirror mirror;
+    Mode mode;
+
+    counter.write(value);
+    mirror.write(value);
+    mode.write(static_cast<uint8_t>(value % 32U));
+
+    frame.clear();
+    frame << counter << mirror << mode;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitShmBus : public Test
+{
+public:
+
+    BitShmBus();
+
+    virtual void SetUp();
+
+    char mName[64];
+};
+
+//------------------------------------------------------------------------------
+BitShmBus::BitShmBus()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitShmBus::SetUp()
+{
+    (void) std::snprintf(mName, sizeof(mName), "/bits_test_%d", getpid());
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitShmBus, publishRead)
+{
+    bit::ShmBus producer;
+    bit::ShmBus consumer;
+
+    ASSERT_EQ(consumer.open(mName), bit::ShmBus::OpenError);
+    ASSERT_EQ(producer.create(mName, FRAME_SIZE, SLOT_COUNT), bit::ShmBus::Ok);
+    ASSERT_EQ(consumer.open(mName), bit::ShmBus::Ok);
+
+    bit::ShmBus::unlink(mName);
+
+    ASSERT_EQ(consumer.count(), SLOT_COUNT);
+    ASSERT_EQ(consumer.frameSize(), FRAME_SIZE);
+
+    bit::Buffer<FRAME_SIZE> frame;
+    bit::Buffer<FRAME_SIZE> copy;
+    bit::Buffer<8> other;
+
+    makeFrame(frame, 0xA5A55A5AU);
+
+    ASSERT_EQ(producer.publish(SLOT_COUNT, frame), bit::ShmBus::InvalidSlot);
+    ASSERT_EQ(producer.publish(0UL, other), bit::ShmBus::InvalidSlot);
+    ASSERT_EQ(producer.publish(2UL, frame), bit::ShmBus::Ok);
+    ASSERT_EQ(consumer.notifications(), 1U);
+
+    ASSERT_EQ(consumer.read<Counter>(2UL), 0xA5A55A5AU);
+    ASSERT_EQ(consumer.read<Mode>(2UL), 0x1AU);
+    ASSERT_EQ(consumer.read<Counter>(1UL), 0U);
+
+    ASSERT_EQ(consumer.snapshot(2UL, copy), bit::ShmBus::Ok);
+
+    for (std::size_t i = 0UL; i < FRAME_SIZE; i++)
+    {
+        ASSERT_EQ(copy[i], frame[i]);
+    }
+
+    // Zero-copy decode, validated against the slot version
+    const uint32_t version = consumer.version(2UL);
+
+    bit::BufferView view = consumer.view(2UL);
+
+    ASSERT_EQ(view.read<Mirror>(), 0xA5A55A5AU);
+    ASSERT_TRUE(consumer.isCurrent(2UL, version));
+
+    ASSERT_EQ(producer.publish(2UL, frame), bit::ShmBus::Ok);
+    ASSERT_FALSE(consumer.isCurrent(2UL, version));
+
+    // Nothing published since, the wait times out
+    ASSERT_FALSE(consumer.wait(consumer.notifications(), 1U));
+    ASSERT_TRUE(consumer.wait(0U, 1U));
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitShmBus, anonymous)
+{
+    bit::ShmBus producer;
+    bit::ShmBus consumer;
+
+    ASSERT_EQ(producer.create(0, FRAME_SIZE, 1UL), bit::ShmBus::Ok);
+    ASSERT_EQ(consumer.open(producer.descriptor()), bit::ShmBus::Ok);
+
+    bit::Buffer<FRAME_SIZE> frame;
+
+    makeFrame(frame, 7U);
+
+    ASSERT_EQ(producer.publish(0UL, frame), bit::ShmBus::Ok);
+    ASSERT_EQ(consumer.read<Mirror>(0UL), 7U);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitShmBus, createExisting)
+{
+    bit::ShmBus producer;
+    bit::ShmBus consumer;
+    bit::ShmBus other;
+
+    ASSERT_EQ(producer.create(mName, FRAME_SIZE, SLOT_COUNT), bit::ShmBus::Ok);
+
+    bit::Buffer<FRAME_SIZE> frame;
+
+    makeFrame(frame, 11U);
+
+    ASSERT_EQ(producer.publish(1UL, frame), bit::ShmBus::Ok);
+
+    // The mapped segment is attached, not re-initialized
+    ASSERT_EQ(consumer.create(mName, FRAME_SIZE, SLOT_COUNT), bit::ShmBus::Ok);
+    ASSERT_EQ(consumer.read<Counter>(1UL), 11U);
+    ASSERT_EQ(producer.read<Counter>(1UL), 11U);
+
+    ASSERT_EQ(other.create(mName, FRAME_SIZE + 1UL, SLOT_COUNT),
+              bit::ShmBus::FormatError);
+    ASSERT_EQ(other.create(mName, FRAME_SIZE, SLOT_COUNT + 1UL),
+              bit::ShmBus::FormatError);
+    ASSERT_EQ(other.descriptor(), -1);
+
+    bit::ShmBus::unlink(mName);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitShmBus, interruptedPublication)
+{
+    bit::ShmBus producer;
+
+    ASSERT_EQ(producer.create(0, FRAME_SIZE, 1UL), bit::ShmBus::Ok);
+
+    const std::size_t length = 3UL * bit::CACHE_LINE_SIZE;
+
+    void* map = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     producer.descriptor(), 0);
+
+    ASSERT_NE(map, MAP_FAILED);
+
+    // A producer died mid-write, leaving the slot sequence odd
+    uint32_t* sequence = reinterpret_cast<uint32_t*>(
+            &static_cast<uint8_t*>(map)[2UL * bit::CACHE_LINE_SIZE]);
+
+    *sequence = 5U;
+
+    const uint32_t version = producer.version(0UL);
+
+    ASSERT_EQ(version, 5U);
+    ASSERT_FALSE(producer.isCurrent(0UL, version));
+
+    bit::Buffer<FRAME_SIZE> frame;
+
+    makeFrame(frame, 3U);
+
+    // The next publication completes the interrupted one
+    ASSERT_EQ(producer.publish(0UL, frame), bit::ShmBus::Ok);
+    ASSERT_EQ(producer.version(0UL), 6U);
+    ASSERT_TRUE(producer.isCurrent(0UL, 6U));
+    ASSERT_EQ(producer.read<Mirror>(0UL), 3U);
+
+    (void) munmap(map, length);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitShmBus, crossProcess)
+{
+    bit::ShmBus consumer;
+
+    ASSERT_EQ(consumer.create(mName, FRAME_SIZE, SLOT_COUNT), bit::ShmBus::Ok);
+
+    const pid_t child = fork();
+
+    ASSERT_GE(child, 0);
+
+    if (0 == child)
+    {
+        bit::ShmBus producer;
+
+        bit::Buffer<FRAME_SIZE> frame;
+
+        int status = (producer.open(mName) == bit::ShmBus::Ok) ? 0 : 1;
+
+        for (uint32_t i = 1U; (0 == status) && (i <= PUBLISH_COUNT); i++)
+        {
+            makeFrame(frame, i);
+
+            (void) producer.publish(i % SLOT_COUNT, frame);
+        }
+
+        _exit(status);
+    }
+
+    uint32_t seen = 0U;
+    uint32_t last = 0U;
+
+    int status = -1;
+
+    bool isExited = false;
+
+    while ((last != PUBLISH_COUNT) && !isExited)
+    {
+        if (!consumer.wait(seen, 100U))
+        {
+            isExited = (waitpid(child, &status, WNOHANG) == child);
+        }
+
+        seen = consumer.notifications();
+
+        bit::Buffer<FRAME_SIZE> frame;
+
+        ASSERT_EQ(consumer.snapshot(PUBLISH_COUNT % SLOT_COUNT, frame),
+                  bit::ShmBus::Ok);
+
+        bit::BufferView view(frame);
+
+        // A torn frame would mix two counters
+        ASSERT_EQ(view.read<Counter>(), view.read<Mirror>());
+        ASSERT_GE(view.read<Counter>(), last);
+
+        last = view.read<Counter>();
+    }
+
+    if (!isExited)
+    {
+        ASSERT_EQ(waitpid(child, &status, 0), child);
+    }
+
+    ASSERT_EQ(status, 0);
+    ASSERT_EQ(last, PUBLISH_COUNT);
+
+    bit::ShmBus::unlink(mName);
+}
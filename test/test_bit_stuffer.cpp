@@ -0,0 +1,254 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef std::vector<uint8_t> Bits;
+
+//------------------------------------------------------------------------------
+Bits unpack(const uint8_t* data, const std::size_t bits)
+{
+    Bits result;
+
+    for (std::size_t i = 0UL; i < bits; i++)
+    {
+        result.push_back((data[i / 8UL] >> (7UL - (i % 8UL))) & 1U);
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+std::vector<uint8_t> pack(const Bits& bits)
+{
+    std::vector<uint8_t> result((bits.size() + 7UL) / 8UL + 1UL, 0U);
+
+    for (std::size_t i = 0UL; i < bits.size(); i++)
+    {
+        result[i / 8UL] |= static_cast<uint8_t>(bits[i] << (7UL - (i % 8UL)));
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Bits referenceStuff(const Bits& input, const bit::BitStuffer::Rule rule)
+{
+    Bits result;
+
+    std::size_t run = 0UL;
+
+    for (std::size_t i = 0UL; i < input.size(); i++)
+    {
+        const uint8_t value = input[i];
+
+        run = (!result.empty() && (result.back() == value)) ? (run + 1UL) : 1UL;
+
+        result.push_back(value);
+
+        if ((5UL == run) && ((bit::BitStuffer::Can == rule) || (1U == value)))
+        {
+            result.push_back(value ^ 1U);
+
+            run = 1UL;
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+Bits randomBits(uint32_t& state, const std::size_t count, const uint32_t bias)
+{
+    Bits result;
+
+    for (std::size_t i = 0UL; i < count; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        // Biased streams produce long runs
+        result.push_back(((state % 16U) < bias) ? 1U : 0U);
+    }
+
+    return result;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitStuffer : public Test
+{
+public:
+
+    BitStuffer();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitStuffer::BitStuffer()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitStuffer::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitStuffer, vectors)
+{
+    // 0000 0111 1111 1000 0011 -> CAN 00000 1 1111 0 1111 00000 1 11, the stuff
+    // bits count in the next run
+    const uint8_t input[] = { 0x07U, 0xF8U, 0x30U };
+
+    uint8_t output[8] = { 0U };
+
+    bit::BitStuffer can(bit::BitStuffer::Can);
+
+    ASSERT_EQ(can.stuff(input, 20UL, output, 64UL), bit::BitStuffer::Ok);
+    ASSERT_EQ(can.bits(), 23UL);
+    ASSERT_EQ(output[0], 0x07U);
+    ASSERT_EQ(output[1], 0xDEU);
+    ASSERT_EQ(output[2], 0x0EU);
+
+    // 0111 1110 -> HDLC 0111 1101 0
+    const uint8_t flag[] = { 0x7EU };
+
+    bit::BitStuffer hdlc(bit::BitStuffer::Hdlc);
+
+    ASSERT_EQ(hdlc.stuff(flag, 8UL, output, 64UL), bit::BitStuffer::Ok);
+    ASSERT_EQ(hdlc.bits(), 9UL);
+    ASSERT_EQ(output[0], 0x7DU);
+    ASSERT_EQ(output[1], 0x00U);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitStuffer, roundTrip)
+{
+    uint32_t state = 0x2545F491UL;
+
+    const bit::BitStuffer::Rule rules[] = { bit::BitStuffer::Can, bit::BitStuffer::Hdlc };
+
+    for (std::size_t r = 0UL; r < 2UL; r++)
+    {
+        bit::BitStuffer stuffer(rules[r]);
+
+        for (uint32_t bias = 1U; bias < 16U; bias += 2U)
+        {
+            for (std::size_t length = 1UL; length < 400UL; length += 37UL)
+            {
+                const Bits input = randomBits(state, length, bias);
+                const Bits expected = referenceStuff(input, rules[r]);
+                const std::vector<uint8_t> packed = pack(input);
+
+                std::vector<uint8_t> stuffed(packed.size() * 2UL, 0xFFU);
+                std::vector<uint8_t> restored(packed.size(), 0xFFU);
+
+                ASSERT_EQ(stuffer.stuff(packed.data(), length, stuffed.data(), stuffed.size() * 8UL),
+                          bit::BitStuffer::Ok);
+                ASSERT_EQ(stuffer.bits(), expected.size());
+                ASSERT_TRUE(unpack(stuffed.data(), stuffer.bits()) == expected);
+
+                const std::size_t stuffedBits = stuffer.bits();
+
+                ASSERT_EQ(stuffer.destuff(stuffed.data(), stuffedBits, restored.data(),
+                                          restored.size() * 8UL),
+                          bit::BitStuffer::Ok);
+                ASSERT_EQ(stuffer.bits(), length);
+                ASSERT_EQ(stuffer.errors(), 0UL);
+                ASSERT_TRUE(unpack(restored.data(), length) == input);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitStuffer, errors)
+{
+    // CAN 00000 1 1111 1 0: the stuff bit starts the run of 1s, bit 10 is an
+    // error and bit 11 the stuff bit
+    const uint8_t can[] = { 0x07U, 0xE0U };
+
+    uint8_t output[8] = { 0U };
+
+    std::size_t positions[4] = { 0UL };
+
+    bit::BitStuffer stuffer(bit::BitStuffer::Can);
+
+    ASSERT_EQ(stuffer.destuff(can, 12UL, output, 64UL, positions, 4UL),
+              bit::BitStuffer::StuffError);
+    ASSERT_EQ(stuffer.errors(), 1UL);
+    ASSERT_EQ(positions[0], 10UL);
+    ASSERT_EQ(stuffer.bits(), 10UL);
+    ASSERT_EQ(output[0], 0x07U);
+    ASSERT_EQ(output[1], 0xC0U);
+
+    // HDLC flag 0111 1110: the sixth 1 is an error
+    const uint8_t flag[] = { 0x7EU, 0x7EU };
+
+    bit::BitStuffer hdlc(bit::BitStuffer::Hdlc);
+
+    ASSERT_EQ(hdlc.destuff(flag, 16UL, output, 64UL, positions, 1UL),
+              bit::BitStuffer::StuffError);
+    ASSERT_EQ(hdlc.errors(), 2UL);
+    ASSERT_EQ(positions[0], 6UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitStuffer, overflow)
+{
+    const uint8_t input[] = { 0x00U, 0x00U };
+
+    uint8_t output[2] = { 0U };
+
+    bit::BitStuffer stuffer(bit::BitStuffer::Can);
+
+    ASSERT_EQ(stuffer.stuff(input, 16UL, output, 16UL), bit::BitStuffer::Overflow);
+    ASSERT_LE(stuffer.bits(), 16UL);
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitStuffer, overflowPrefix)
+{
+    // 13 zeros -> CAN 00000 1 0000 1 000, truncated to 7 bits 00000 10
+    const uint8_t zeros[] = { 0x00U, 0x00U };
+
+    uint8_t output[2] = { 0U };
+
+    bit::BitStuffer can(bit::BitStuffer::Can);
+
+    ASSERT_EQ(can.stuff(zeros, 13UL, output, 7UL), bit::BitStuffer::Overflow);
+    ASSERT_EQ(can.bits(), 7UL);
+    ASSERT_EQ(output[0], 0x04U);
+
+    uint32_t state = 0x1F123BB5UL;
+
+    const Bits input = randomBits(state, 300UL, 13U);
+    const Bits expected = referenceStuff(input, bit::BitStuffer::Can);
+    const std::vector<uint8_t> packed = pack(input);
+    const std::vector<uint8_t> stuffed = pack(expected);
+
+    for (std::size_t capacity = 0UL; capacity < input.size(); capacity += 7UL)
+    {
+        std::vector<uint8_t> buffer(stuffed.size(), 0U);
+
+        ASSERT_EQ(can.stuff(packed.data(), input.size(), buffer.data(), capacity),
+                  bit::BitStuffer::Overflow);
+        ASSERT_EQ(can.bits(), capacity);
+        ASSERT_TRUE(unpack(buffer.data(), capacity) ==
+                    Bits(expected.begin(), expected.begin() + capacity));
+
+        ASSERT_EQ(can.destuff(stuffed.data(), expected.size(), buffer.data(), capacity),
+                  bit::BitStuffer::Overflow);
+        ASSERT_EQ(can.bits(), capacity);
+        ASSERT_TRUE(unpack(buffer.data(), capacity) ==
+                    Bits(input.begin(), input.begin() + capacity));
+    }
+}
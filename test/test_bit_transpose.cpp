@@ -0,0 +1,203 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <bits>
+
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+typedef bit::Signal<bool, 0> Engine;
+typedef bit::Signal<bool, 20> Brake;
+typedef bit::Signal<bool, 27> Door;
+typedef bit::Signal<bool, 63> Light;
+
+//------------------------------------------------------------------------------
+uint64_t next(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+//------------------------------------------------------------------------------
+bool element(const uint64_t row, const std::size_t j)
+{
+    return ((row >> (63UL - j)) & 1ULL) != 0ULL;
+}
+}
+
+//------------------------------------------------------------------------------
+class BitTranspose : public Test
+{
+public:
+
+    BitTranspose();
+
+    virtual void SetUp();
+};
+
+//------------------------------------------------------------------------------
+BitTranspose::BitTranspose()
+{
+}
+
+//------------------------------------------------------------------------------
+void BitTranspose::SetUp()
+{
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitTranspose, transpose8x8)
+{
+    // Row 0 all ones becomes column 0
+    ASSERT_EQ(bit::transpose8x8(0xFF00000000000000ULL), 0x8080808080808080ULL);
+    ASSERT_EQ(bit::transpose8x8(0x8040201008040201ULL), 0x8040201008040201ULL);
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (std::size_t n = 0UL; n < 100UL; n++)
+    {
+        const uint64_t matrix = next(state);
+        const uint64_t transposed = bit::transpose8x8(matrix);
+
+        for (std::size_t i = 0UL; i < 8UL; i++)
+        {
+            for (std::size_t j = 0UL; j < 8UL; j++)
+            {
+                ASSERT_EQ(element(matrix, (i * 8UL) + j), element(transposed, (j * 8UL) + i));
+            }
+        }
+
+        ASSERT_EQ(bit::transpose8x8(transposed), matrix);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitTranspose, transpose64x64)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t matrix[64];
+    uint64_t transposed[64];
+
+    for (std::size_t i = 0UL; i < 64UL; i++)
+    {
+        matrix[i] = next(state);
+        transposed[i] = matrix[i];
+    }
+
+    bit::transpose64x64(transposed);
+
+    for (std::size_t i = 0UL; i < 64UL; i++)
+    {
+        for (std::size_t j = 0UL; j < 64UL; j++)
+        {
+            ASSERT_EQ(element(matrix[i], j), element(transposed[j], i));
+        }
+    }
+
+    bit::transpose64x64(transposed);
+
+    for (std::size_t i = 0UL; i < 64UL; i++)
+    {
+        ASSERT_EQ(transposed[i], matrix[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitTranspose, flags)
+{
+    const std::size_t size = 13UL;
+    const std::size_t stride = 16UL;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Unsorted, shared bytes and columns, the last byte, past the frame
+    const std::size_t sparse[] = { 0UL, 7UL, 3UL, 64UL, 101UL, 63UL, 100UL, 103UL, 104UL, 8UL };
+
+    // Every bit, whole columns are transposed
+    std::size_t dense[112];
+
+    for (std::size_t i = 0UL; i < 112UL; i++)
+    {
+        dense[i] = i;
+    }
+
+    const std::size_t counts[] = { 1UL, 31UL, 32UL, 33UL, 64UL, 65UL, 200UL };
+
+    for (std::size_t c = 0UL; c < (2UL * (sizeof(counts) / sizeof(counts[0]))); c++)
+    {
+        const std::size_t* offsets = ((c % 2UL) != 0UL) ? dense : sparse;
+        const std::size_t flags = ((c % 2UL) != 0UL) ? 112UL : (sizeof(sparse) / sizeof(sparse[0]));
+
+        const std::size_t count = counts[c / 2UL];
+        const std::size_t words = (count + 63UL) / 64UL;
+
+        std::vector<uint8_t> frames(count * stride);
+
+        for (std::size_t i = 0UL; i < frames.size(); i++)
+        {
+            frames[i] = static_cast<uint8_t>(next(state));
+        }
+
+        std::vector<uint64_t> bitmaps(flags * words, 0x5A5A5A5A5A5A5A5AULL);
+
+        bit::transposeFlags(frames.data(), size, stride, count, offsets, flags, bitmaps.data());
+
+        for (std::size_t f = 0UL; f < flags; f++)
+        {
+            for (std::size_t n = 0UL; n < (words * 64UL); n++)
+            {
+                const bool expected = (n < count) &&
+                        (bit::extractField(&frames[n * stride], size, offsets[f], 1UL) != 0ULL);
+
+                ASSERT_EQ(element(bitmaps[(f * words) + (n / 64UL)], n % 64UL), expected)
+                        << "count " << count << " flag " << f << " frame " << n;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST_F(BitTranspose, buffers)
+{
+    bit::Buffer<8> frames[70];
+
+    for (std::size_t n = 0UL; n < 70UL; n++)
+    {
+        Engine engine;
+        Brake brake;
+        Door door;
+        Light light;
+
+        engine.write((n % 2UL) != 0UL);
+        brake.write((n % 3UL) != 0UL);
+        door.write(n > 40UL);
+        light.write(n < 5UL);
+
+        frames[n] << engine << brake << door << light;
+    }
+
+    const std::size_t offsets[] = { bit::Field<Engine>::OFFSET,
+                                    bit::Field<Brake>::OFFSET,
+                                    bit::Field<Door>::OFFSET,
+                                    bit::Field<Light>::OFFSET };
+
+    uint64_t bitmaps[8] = { 0ULL };
+
+    bit::transposeFlags(frames, 70UL, offsets, 4UL, bitmaps);
+
+    for (std::size_t n = 0UL; n < 70UL; n++)
+    {
+        ASSERT_EQ(element(bitmaps[0UL + (n / 64UL)], n % 64UL), (n % 2UL) != 0UL);
+        ASSERT_EQ(element(bitmaps[2UL + (n / 64UL)], n % 64UL), (n % 3UL) != 0UL);
+        ASSERT_EQ(element(bitmaps[4UL + (n / 64UL)], n % 64UL), n > 40UL);
+        ASSERT_EQ(element(bitmaps[6UL + (n / 64UL)], n % 64UL), n < 5UL);
+    }
+
+    ASSERT_EQ(bit::popcount(bitmaps[6]), 5UL);
+}